@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+// Benchmarks link/NIU ID computation and end-to-end simulation on a TG
+// (36-chip) device model. Usage: bench_device_model_ids [num_repeats]
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cstdlib>
+#include <random>
+
+#include "ScopedTimer.hpp"
+#include "device_models/wormhole_multichip.hpp"
+#include "npeEngine.hpp"
+
+using namespace tt_npe;
+
+namespace {
+
+constexpr size_t TG_NUM_CHIPS = 36;
+
+// time `fn` num_repeats times and return fastest run in microseconds
+template <typename Fn>
+size_t bestOf(int num_repeats, Fn &&fn) {
+    size_t best = std::numeric_limits<size_t>::max();
+    for (int i = 0; i < num_repeats; i++) {
+        ScopedTimer timer("", true);
+        fn();
+        best = std::min(best, timer.getElapsedTimeMicroSeconds());
+    }
+    return best;
+}
+
+void benchIDLookups(const WormholeMultichipDeviceModel &model, int num_repeats) {
+    std::vector<nocLinkAttr> link_attrs;
+    std::vector<nocNIUAttr> niu_attrs;
+    boost::unordered_flat_map<nocLinkAttr, nocLinkID> link_map;
+    boost::unordered_flat_map<nocNIUAttr, nocNIUID> niu_map;
+    for (size_t d = 0; d < model.getNumChips(); d++) {
+        for (size_t r = 0; r < model.getRows(); r++) {
+            for (size_t c = 0; c < model.getCols(); c++) {
+                for (auto type : model.getLinkTypes()) {
+                    nocLinkAttr attr = {{DeviceID(d), int(r), int(c)}, type};
+                    link_map[attr] = link_attrs.size();
+                    link_attrs.push_back(attr);
+                }
+                for (auto type : model.getNIUTypes()) {
+                    nocNIUAttr attr = {{DeviceID(d), int(r), int(c)}, type};
+                    niu_map[attr] = niu_attrs.size();
+                    niu_attrs.push_back(attr);
+                }
+            }
+        }
+    }
+
+    // randomize access order so the hash map is not walked sequentially
+    std::mt19937 rng(0);
+    std::shuffle(link_attrs.begin(), link_attrs.end(), rng);
+    std::shuffle(niu_attrs.begin(), niu_attrs.end(), rng);
+
+    constexpr int NUM_PASSES = 200;
+    size_t num_lookups = NUM_PASSES * (link_attrs.size() + niu_attrs.size());
+    volatile size_t sink = 0;
+
+    auto hash_us = bestOf(num_repeats, [&]() {
+        size_t acc = 0;
+        for (int p = 0; p < NUM_PASSES; p++) {
+            for (const auto &attr : link_attrs) {
+                acc += link_map.find(attr)->second;
+            }
+            for (const auto &attr : niu_attrs) {
+                acc += niu_map.find(attr)->second;
+            }
+        }
+        sink = acc;
+    });
+    auto dense_us = bestOf(num_repeats, [&]() {
+        size_t acc = 0;
+        for (int p = 0; p < NUM_PASSES; p++) {
+            for (const auto &attr : link_attrs) {
+                acc += model.getLinkID(attr);
+            }
+            for (const auto &attr : niu_attrs) {
+                acc += model.getNIUID(attr);
+            }
+        }
+        sink = acc;
+    });
+
+    fmt::println(
+        "id lookups   : hash map {:.2f} ns/lookup, closed-form {:.2f} ns/lookup ({} lookups)",
+        1e3 * hash_us / num_lookups,
+        1e3 * dense_us / num_lookups,
+        num_lookups);
+}
+
+void benchRouting(const WormholeMultichipDeviceModel &model, int num_repeats) {
+    // random unicast routes between worker cores on every chip
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> row_dist(1, 5), col_dist(1, 4);
+    std::vector<std::pair<Coord, Coord>> endpoints;
+    for (size_t d = 0; d < model.getNumChips(); d++) {
+        for (int i = 0; i < 1000; i++) {
+            endpoints.push_back(
+                {Coord{DeviceID(d), row_dist(rng), col_dist(rng)},
+                 Coord{DeviceID(d), row_dist(rng), col_dist(rng)}});
+        }
+    }
+
+    volatile size_t sink = 0;
+    auto route_us = bestOf(num_repeats, [&]() {
+        size_t acc = 0;
+        for (const auto &[src, dst] : endpoints) {
+            acc += model.route(nocType::NOC0, src, dst).size();
+            acc += model.route(nocType::NOC1, src, dst).size();
+        }
+        sink = acc;
+    });
+
+    fmt::println(
+        "routing      : {:.1f} ns/route ({} routes)",
+        1e3 * route_us / (2 * endpoints.size()),
+        2 * endpoints.size());
+}
+
+void benchSimulation(int num_repeats) {
+    npeEngine engine("TG");
+
+    // each chip runs an independent block-to-block style transfer pattern
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> row_dist(1, 5), col_dist(1, 4), start_dist(0, 20000);
+    npeWorkload wl;
+    npeWorkloadPhase phase;
+    boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
+    for (size_t d = 0; d < TG_NUM_CHIPS; d++) {
+        DeviceID device_id = d;
+        for (int i = 0; i < 200; i++) {
+            Coord src{device_id, row_dist(rng), col_dist(rng)};
+            Coord dst{device_id, row_dist(rng), col_dist(rng)};
+            auto noc_type = i % 2 ? nocType::NOC0 : nocType::NOC1;
+            phase.transfers.push_back(
+                npeWorkloadTransfer(4096, 8, src, dst, 28.1, start_dist(rng), noc_type));
+        }
+        golden_cycles[device_id] = {0, 25000};
+    }
+    wl.addPhase(phase);
+    wl.setGoldenResultCycles(golden_cycles);
+
+    npeConfig cfg;
+    Cycle estimated_cycles = 0;
+    auto sim_us = bestOf(num_repeats, [&]() {
+        auto result = engine.runPerfEstimation(wl, cfg);
+        if (auto *stats = std::get_if<npeStats>(&result)) {
+            estimated_cycles = stats->per_device_stats.at(MESH_DEVICE).estimated_cycles;
+        }
+    });
+
+    fmt::println(
+        "simulation   : {:.1f} ms for {} transfers ({} estimated cycles)",
+        sim_us / 1e3,
+        phase.transfers.size(),
+        estimated_cycles);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int num_repeats = argc > 1 ? std::atoi(argv[1]) : 5;
+
+    WormholeMultichipDeviceModel model(TG_NUM_CHIPS);
+    benchIDLookups(model, num_repeats);
+    benchRouting(model, num_repeats);
+    benchSimulation(num_repeats);
+    return 0;
+}
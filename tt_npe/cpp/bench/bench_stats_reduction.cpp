@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+// Benchmarks the per-timestep link/NIU demand reductions done by
+// updateSimulationStats on Wormhole, Blackhole and 32-chip Galaxy grids, for
+// each SIMD level supported by the host.
+// Usage: bench_stats_reduction [num_timesteps] [num_repeats]
+
+#include <cstdlib>
+#include <random>
+
+#include "ScopedTimer.hpp"
+#include "npeDemandReduction.hpp"
+#include "npeDeviceModelFactory.hpp"
+#include "npeDeviceModelUtils.hpp"
+#include "npeWorkload.hpp"
+
+using namespace tt_npe;
+
+namespace {
+
+// time `fn` num_repeats times and return fastest run in microseconds
+template <typename Fn>
+size_t bestOf(int num_repeats, Fn &&fn) {
+    size_t best = std::numeric_limits<size_t>::max();
+    for (int i = 0; i < num_repeats; i++) {
+        ScopedTimer timer("", true);
+        fn();
+        best = std::min(best, timer.getElapsedTimeMicroSeconds());
+    }
+    return best;
+}
+
+void benchDevice(const std::string &device_name, int num_timesteps, int num_repeats) {
+    auto model = npeDeviceModelFactory::createDeviceModel(device_name);
+    auto device_state = model->initDeviceState();
+    size_t num_links = device_state->getLinkDemandGrid().size();
+    size_t num_nius = device_state->getNIUDemandGrid().size();
+    float max_link_bandwidth = model->getLinkBandwidth(nocLinkID(0));
+
+    // sparse random demand; most links are idle in a typical timestep
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> demand_dist(0, 2 * max_link_bandwidth);
+    std::bernoulli_distribution active_dist(0.2);
+    auto random_grid = [&](size_t size) {
+        std::vector<float> grid(size);
+        for (auto &demand : grid) {
+            demand = active_dist(rng) ? demand_dist(rng) : 0;
+        }
+        return grid;
+    };
+    LinkDemandGrid link_demand = random_grid(num_links);
+    LinkDemandGrid mcast_write_link_demand = random_grid(num_links);
+    NIUDemandGrid niu_demand = random_grid(num_nius);
+
+    npeStats stats(model.get());
+    SimulationStatsLookup lookup(*model, stats, num_links, num_nius, false);
+
+    fmt::println("{} ({} chips, {} links, {} NIUs)", device_name, model->getNumChips(), num_links, num_nius);
+    std::vector<std::pair<SimdLevel, std::string_view>> simd_levels = {
+        {SimdLevel::SCALAR, "scalar"}, {SimdLevel::AVX2, "avx2"}, {SimdLevel::AVX512, "avx512"}};
+    volatile double sink = 0;
+    for (auto [simd_level, name] : simd_levels) {
+        if (simd_level > getSupportedSimdLevel()) {
+            continue;
+        }
+        auto reduce_us = bestOf(num_repeats, [&]() {
+            double acc = 0;
+            for (int ts = 0; ts < num_timesteps; ts++) {
+                DemandReduction mesh_links, mesh_nius;
+                for (const auto &block : lookup.device_blocks) {
+                    size_t block_links = block.link_end - block.link_begin;
+                    mesh_links.merge(reduceLinkDemand(
+                        std::span(link_demand).subspan(block.link_begin, block_links),
+                        std::span(mcast_write_link_demand).subspan(block.link_begin, block_links),
+                        max_link_bandwidth,
+                        simd_level));
+                    mesh_nius.merge(reduceNIUDemand(
+                        std::span(niu_demand).subspan(
+                            block.niu_begin, block.niu_end - block.niu_begin),
+                        simd_level));
+                }
+                acc += mesh_links.totalUtil() + mesh_nius.totalDemand();
+            }
+            sink = acc;
+        });
+        fmt::println("  {:<7}: {:.2f} us/timestep", name, double(reduce_us) / num_timesteps);
+    }
+
+    // full per-timestep stats update, with and without timeline data
+    npeWorkload wl;
+    boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
+    for (auto device_id : model->getDeviceIDs()) {
+        golden_cycles[device_id] = {0, 1};
+    }
+    wl.setGoldenResultCycles(golden_cycles);
+    for (bool record_timeline : {false, true}) {
+        size_t timeline_bytes = 0;
+        auto update_us = bestOf(num_repeats, [&]() {
+            npeStats stats(model.get());
+            SimulationStatsLookup lookup(*model, stats, num_links, num_nius, record_timeline);
+            for (int ts = 0; ts < num_timesteps; ts++) {
+                stats.insertTimestep(ts, ts + 1, wl);
+                updateSimulationStats(
+                    *model,
+                    lookup,
+                    link_demand,
+                    mcast_write_link_demand,
+                    niu_demand);
+            }
+            timeline_bytes = 0;
+            for (const auto &ts : stats.per_device_stats.at(MESH_DEVICE).per_timestep_stats) {
+                timeline_bytes += (ts.link_demand.capacity() + ts.niu_demand.capacity()) * sizeof(SparseDemand);
+            }
+        });
+        fmt::println(
+            "  update{}: {:.2f} us/timestep, {:.1f} KB timeline data",
+            record_timeline ? " (timeline)" : "",
+            double(update_us) / num_timesteps,
+            timeline_bytes / 1024.);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int num_timesteps = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int num_repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    for (const auto &device_name : {"wormhole_b0", "blackhole", "GALAXY"}) {
+        benchDevice(device_name, num_timesteps, num_repeats);
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+// Benchmarks noc trace ingest on each trace under a directory (by default the
+// T3K fabric traces). Full ingest, on one thread and on one thread per
+// hardware thread, is compared against a decode-only pass of
+// npeNocTraceReader over the same trace, which is the cost of each pass over
+// the events that ingest makes.
+// Usage: bench_trace_ingest [trace_dir] [num_repeats]
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+#include "ScopedTimer.hpp"
+#include "ingestWorkload.hpp"
+#include "npeNocTraceReader.hpp"
+
+using namespace tt_npe;
+
+namespace {
+
+// time `fn` num_repeats times and return fastest run in microseconds
+template <typename Fn>
+size_t bestOf(int num_repeats, Fn &&fn) {
+    size_t best = std::numeric_limits<size_t>::max();
+    for (int i = 0; i < num_repeats; i++) {
+        ScopedTimer timer("", true);
+        fn();
+        best = std::min(best, timer.getElapsedTimeMicroSeconds());
+    }
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string trace_dir = argc > 1 ? argv[1] : "workload/T3K-fabric-traces";
+    int num_repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::vector<std::filesystem::path> traces;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(trace_dir)) {
+        if (entry.path().extension() == ".json" && entry.path().filename() != "topology.json") {
+            traces.push_back(entry.path());
+        }
+    }
+    std::sort(traces.begin(), traces.end());
+    if (traces.empty()) {
+        log_error("No noc traces found in '{}'", trace_dir);
+        return 1;
+    }
+
+    size_t total_decode_us = 0;
+    size_t total_serial_ingest_us = 0;
+    size_t total_ingest_us = 0;
+    for (const auto &trace : traces) {
+        size_t num_events = 0;
+        auto decode_us = bestOf(num_repeats, [&]() {
+            npeNocTraceReader reader(trace.string());
+            NocTraceEventBatch batch;
+            num_events = 0;
+            while (reader.readBatch(batch)) {
+                num_events += batch.events.size();
+            }
+        });
+
+        size_t num_transfers = 0;
+        auto ingest = [&](size_t num_threads) {
+            return bestOf(num_repeats, [&]() {
+                auto wl = convertNocTracesToNpeWorkload(trace.string(), "T3K", false, num_threads);
+                num_transfers = wl ? wl->getPhases().front().transfers.size() : 0;
+            });
+        };
+        auto serial_ingest_us = ingest(1);
+        auto ingest_us = ingest(0);
+
+        fmt::println(
+            "{:<60} {:>7} events {:>7} transfers : decode {:>8.2f} ms, ingest {:>8.2f} ms ({:.2f}x decode), "
+            "parallel ingest {:>8.2f} ms",
+            std::filesystem::relative(trace, trace_dir).string(),
+            num_events,
+            num_transfers,
+            decode_us / 1e3,
+            serial_ingest_us / 1e3,
+            double(serial_ingest_us) / decode_us,
+            ingest_us / 1e3);
+        total_decode_us += decode_us;
+        total_serial_ingest_us += serial_ingest_us;
+        total_ingest_us += ingest_us;
+    }
+    fmt::println(
+        "total : decode {:.2f} ms, ingest {:.2f} ms ({:.2f}x decode), parallel ingest {:.2f} ms ({} threads)",
+        total_decode_us / 1e3,
+        total_serial_ingest_us / 1e3,
+        double(total_serial_ingest_us) / total_decode_us,
+        total_ingest_us / 1e3,
+        std::max(1u, std::thread::hardware_concurrency()));
+    return 0;
+}
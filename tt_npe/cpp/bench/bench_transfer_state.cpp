@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+// Benchmarks per-timestep updates of live transfer state on a large (1M+
+// transfer) TG (36-chip) workload, comparing the array-of-structs
+// PETransferState layout against the structure-of-arrays PETransferHotState.
+// Usage: bench_transfer_state [num_transfers] [num_repeats]
+//
+// Cache behaviour can be compared by running under
+//   perf stat -e cache-references,cache-misses bench_transfer_state
+
+#include <cstdlib>
+#include <numeric>
+#include <random>
+
+#include "ScopedTimer.hpp"
+#include "device_models/wormhole_multichip.hpp"
+#include "npeDeviceModelUtils.hpp"
+
+using namespace tt_npe;
+
+namespace {
+
+constexpr size_t TG_NUM_CHIPS = 36;
+constexpr Cycle CYCLES_PER_TIMESTEP = 128;
+constexpr int NUM_TIMESTEPS = 10;
+
+// time `fn` num_repeats times and return fastest run in microseconds
+template <typename Fn>
+size_t bestOf(int num_repeats, Fn &&fn) {
+    size_t best = std::numeric_limits<size_t>::max();
+    for (int i = 0; i < num_repeats; i++) {
+        ScopedTimer timer("", true);
+        fn();
+        best = std::min(best, timer.getElapsedTimeMicroSeconds());
+    }
+    return best;
+}
+
+// NOTE: the returned transfers reference wl_transfers, which must outlive them
+std::vector<PETransferState> genTransfers(
+    const WormholeMultichipDeviceModel &model,
+    nocRouteArena &route_arena,
+    std::vector<npeWorkloadTransfer> &wl_transfers,
+    size_t num_transfers) {
+    // random unicast transfers between worker cores on every chip
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> row_dist(1, 5), col_dist(1, 4), num_packets_dist(1, 16);
+    std::uniform_int_distribution<int> chip_dist(0, TG_NUM_CHIPS - 1);
+
+    std::vector<nocRouteArena::RouteRef> routes;
+    routes.reserve(num_transfers);
+    std::vector<PETransferState> transfers;
+    transfers.reserve(num_transfers);
+    wl_transfers.reserve(num_transfers);
+    for (size_t i = 0; i < num_transfers; i++) {
+        DeviceID device_id = chip_dist(rng);
+        Coord src{device_id, row_dist(rng), col_dist(rng)};
+        Coord dst{device_id, row_dist(rng), col_dist(rng)};
+        auto noc_type = i % 2 ? nocType::NOC0 : nocType::NOC1;
+        const auto &wl_transfer =
+            wl_transfers.emplace_back(2048, num_packets_dist(rng), src, dst, 28.1, 0, noc_type);
+        routes.push_back(route_arena.addRoute([&](nocRoute &route) {
+            model.appendRoute(noc_type, src, dst, route);
+        }));
+        transfers.emplace_back(wl_transfer, 0, nocRouteView{});
+        resolveTransferNIUs(model, transfers.back());
+        transfers.back().curr_bandwidth = 1;
+    }
+    for (size_t id = 0; id < num_transfers; id++) {
+        transfers[id].route = route_arena.getRoute(routes[id]);
+    }
+    return transfers;
+}
+
+// mirrors the engine's live transfer progress update
+template <typename GetState>
+size_t updateProgress(const std::vector<PETransferID> &live_transfer_ids, GetState &&get_state) {
+    size_t num_complete = 0;
+    for (Cycle curr_cycle = CYCLES_PER_TIMESTEP; curr_cycle <= NUM_TIMESTEPS * CYCLES_PER_TIMESTEP;
+         curr_cycle += CYCLES_PER_TIMESTEP) {
+        for (auto ltid : live_transfer_ids) {
+            auto [total_bytes, total_bytes_transferred, start_cycle, curr_bandwidth] =
+                get_state(ltid);
+            size_t remaining_bytes = total_bytes - total_bytes_transferred;
+            Cycle cycles_active = std::min(CYCLES_PER_TIMESTEP, curr_cycle - start_cycle);
+            size_t bytes_transferred =
+                std::min<size_t>(remaining_bytes, cycles_active * curr_bandwidth);
+            total_bytes_transferred += bytes_transferred;
+            num_complete += total_bytes_transferred == total_bytes;
+        }
+    }
+    return num_complete;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    size_t num_transfers = argc > 1 ? std::atoll(argv[1]) : (1 << 20);
+    int num_repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    WormholeMultichipDeviceModel model(TG_NUM_CHIPS);
+    nocRouteArena route_arena;
+    std::vector<npeWorkloadTransfer> wl_transfers;
+    auto transfers = genTransfers(model, route_arena, wl_transfers, num_transfers);
+    PETransferHotState hot_state(transfers);
+
+    // visit live transfers in shuffled order; the engine's live list becomes
+    // unordered as transfers activate and complete
+    std::vector<PETransferID> live_transfer_ids(num_transfers);
+    std::iota(live_transfer_ids.begin(), live_transfer_ids.end(), 0);
+    std::shuffle(live_transfer_ids.begin(), live_transfer_ids.end(), std::mt19937(0));
+    size_t num_updates = NUM_TIMESTEPS * num_transfers;
+
+    volatile size_t sink = 0;
+    auto aos_us = bestOf(num_repeats, [&]() {
+        for (auto &tr : transfers) {
+            tr.total_bytes_transferred = 0;
+        }
+        sink = updateProgress(live_transfer_ids, [&](PETransferID id) {
+            auto &tr = transfers[id];
+            return std::tie(
+                tr.params->total_bytes, tr.total_bytes_transferred, tr.start_cycle, tr.curr_bandwidth);
+        });
+    });
+    auto soa_us = bestOf(num_repeats, [&]() {
+        std::fill(
+            hot_state.total_bytes_transferred.begin(), hot_state.total_bytes_transferred.end(), 0);
+        sink = updateProgress(live_transfer_ids, [&](PETransferID id) {
+            return std::tie(
+                hot_state.total_bytes[id],
+                hot_state.total_bytes_transferred[id],
+                hot_state.start_cycle[id],
+                hot_state.curr_bandwidth[id]);
+        });
+    });
+    fmt::println(
+        "progress update : AoS {:.2f} ns/transfer, SoA {:.2f} ns/transfer ({} transfers, {} "
+        "bytes/transfer AoS)",
+        1e3 * aos_us / num_updates,
+        1e3 * soa_us / num_updates,
+        num_transfers,
+        sizeof(PETransferState));
+
+    // full bandwidth + congestion model evaluation over the same live set
+    auto device_state = model.initDeviceState();
+    auto rate_us = bestOf(num_repeats, [&]() {
+        device_state->reset();
+        for (Cycle curr_cycle = CYCLES_PER_TIMESTEP;
+             curr_cycle <= NUM_TIMESTEPS * CYCLES_PER_TIMESTEP;
+             curr_cycle += CYCLES_PER_TIMESTEP) {
+            model.computeCurrentTransferRate(
+                curr_cycle - CYCLES_PER_TIMESTEP,
+                curr_cycle,
+                hot_state,
+                live_transfer_ids,
+                *device_state,
+                true);
+        }
+    });
+    fmt::println(
+        "transfer rate   : {:.2f} ns/transfer ({} transfers x {} timesteps)",
+        1e3 * rate_us / num_updates,
+        num_transfers,
+        NUM_TIMESTEPS);
+    return 0;
+}
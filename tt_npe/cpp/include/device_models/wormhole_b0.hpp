@@ -10,6 +10,7 @@
 #include "npeCommon.hpp"
 #include "npeDeviceModelIface.hpp"
 #include "npeDeviceModelUtils.hpp"
+#include "npeRouteTable.hpp"
 
 namespace tt_npe {
 
@@ -31,6 +32,7 @@ class WormholeB0DeviceModel : public npeDeviceModel {
                     nocLinkAttr attr = {{getDeviceID(), r, c}, link_type};
                     link_id_to_attr_lookup.push_back(attr);
                     link_attr_to_id_lookup[attr] = link_id_to_attr_lookup.size() - 1;
+                    TT_ASSERT(getLinkID(attr) == link_attr_to_id_lookup.at(attr));
                 }
             }
         }
@@ -43,6 +45,7 @@ class WormholeB0DeviceModel : public npeDeviceModel {
                     nocNIUAttr attr = {{getDeviceID(), r, c}, niu_type};
                     niu_id_to_attr_lookup.push_back(attr);
                     niu_attr_to_id_lookup[attr] = niu_id_to_attr_lookup.size() - 1;
+                    TT_ASSERT(getNIUID(attr) == niu_attr_to_id_lookup.at(attr));
                 }
             }
         }
@@ -55,135 +58,63 @@ class WormholeB0DeviceModel : public npeDeviceModel {
     void modelCongestion(
         Cycle start_timestep,
         Cycle end_timestep,
-        std::vector<PETransferState> &transfers,
+        PETransferHotState &transfers,
         const std::vector<PETransferID> &live_transfer_ids,
-        NIUDemandGrid &niu_demand_grid,
-        LinkDemandGrid &link_demand_grid,
-        LinkDemandGrid &multicast_write_link_demand_grid) const {
-        Cycle cycles_per_timestep = end_timestep - start_timestep;
-
+        npeDeviceState &device_state) const {
         // assume all links have identical bandwidth
         float LINK_BANDWIDTH = getLinkBandwidth(nocLinkID());
-        static auto worker_sink_absorption_rate = getSinkAbsorptionRateByCoreType(CoreType::WORKER);
 
         // Note: for now doing gradient descent to determine link bandwidth doesn't
         // appear necessary. Base algorithm devolves to running just a single
-        // iteration (first order congestion only).
-        constexpr int NUM_ITERS = 1;
+        // iteration (first order congestion only), which allows the demand grids
+        // to be maintained incrementally across timesteps.
         constexpr float grad_fac = 1.0;
 
-        for (int iter = 0; iter < NUM_ITERS; iter++) {
-            // determine effective demand through each link
-            std::fill(link_demand_grid.begin(), link_demand_grid.end(), 0.0f);
-            std::fill(niu_demand_grid.begin(), niu_demand_grid.end(), 0.0f);
-            std::fill(
-                multicast_write_link_demand_grid.begin(),
-                multicast_write_link_demand_grid.end(),
-                0.0f);
-            for (auto ltid : live_transfer_ids) {
-                auto &lt = transfers[ltid];
-
-                // account for transfers starting mid-way into timestep, and derate effective
-                // utilization accordingly
-                Cycle predicted_start = std::max(start_timestep, lt.start_cycle);
-                float effective_demand =
-                    float(end_timestep - predicted_start) / float(cycles_per_timestep);
-                effective_demand *= lt.curr_bandwidth;
-
-                // track demand at src and sink NIU
-                nocNIUType src_niu_type = lt.params.noc_type == nocType::NOC0
-                                              ? nocNIUType::NOC0_SRC
-                                              : nocNIUType::NOC1_SRC;
-                nocNIUID niu_id = getNIUID(lt.params.src.row, lt.params.src.col, src_niu_type);
-                niu_demand_grid[niu_id] += effective_demand;
-
-                nocNIUType sink_niu_type = lt.params.noc_type == nocType::NOC0
-                                               ? nocNIUType::NOC0_SINK
-                                               : nocNIUType::NOC1_SINK;
-                if (std::holds_alternative<Coord>(lt.params.dst)) {
-                    const auto &dst = std::get<Coord>(lt.params.dst);
-                    nocNIUID niu_id = getNIUID(dst.row, dst.col, sink_niu_type);
-                    niu_demand_grid[niu_id] += effective_demand;
+        // determine effective demand through each link
+        device_state.updateDemandGrids(start_timestep, end_timestep, transfers, live_transfer_ids);
+        const auto &niu_demand_grid = device_state.getNIUDemandGrid();
+        const auto &link_demand_grid = device_state.getLinkDemandGrid();
+
+        // find highest demand resource on each route to set bandwidth
+        for (auto ltid : live_transfer_ids) {
+            // find max link demand on route
+            float max_link_demand_on_route = 0;
+            auto update_max_link_demand = [&max_link_demand_on_route](float demand) -> bool {
+                if (demand > max_link_demand_on_route) {
+                    max_link_demand_on_route = demand;
+                    return true;
                 } else {
-                    const auto &mcast_dst = std::get<MulticastCoordSet>(lt.params.dst);
-                    for (auto c : mcast_dst) {
-                        // multicast only loads on WORKER NIUs; other NIUS ignore traffic
-                        if (getCoreType(c) == CoreType::WORKER) {
-                            nocNIUID niu_id = getNIUID(c.row, c.col, sink_niu_type);
-                            niu_demand_grid[niu_id] += effective_demand;
-                        }
-                    }
-                }
-
-                const bool is_multicast_write = lt.params.noc_event_type == "WRITE_MULTICAST";
-                if (is_multicast_write) {
-                    for (const auto &link_id : lt.route) {
-                        link_demand_grid[link_id] += effective_demand;
-                        multicast_write_link_demand_grid[link_id] += effective_demand;
-                    }
-                } else {
-                    for (const auto &link_id : lt.route) {
-                        link_demand_grid[link_id] += effective_demand;
-                    }
+                    return false;
                 }
+            };
+            for (const auto &link_id : transfers.route[ltid]) {
+                update_max_link_demand(link_demand_grid[link_id]);
             }
+            auto min_link_bw_derate = LINK_BANDWIDTH / max_link_demand_on_route;
 
-            // find highest demand resource on each route to set bandwidth
-            for (auto ltid : live_transfer_ids) {
-                auto &lt = transfers[ltid];
-
-                // find max link demand on route
-                float max_link_demand_on_route = 0;
-                auto update_max_link_demand = [&max_link_demand_on_route](float demand) -> bool {
-                    if (demand > max_link_demand_on_route) {
-                        max_link_demand_on_route = demand;
-                        return true;
-                    } else {
-                        return false;
-                    }
-                };
-                for (const auto &link_id : lt.route) {
-                    update_max_link_demand(link_demand_grid[link_id]);
-                }
-                auto min_link_bw_derate = LINK_BANDWIDTH / max_link_demand_on_route;
-
-                // compute bottleneck (min derate factor) for source and sink NIUs
-                auto src_niu_type = lt.params.noc_type == nocType::NOC0 ? nocNIUType::NOC0_SRC
-                                                                        : nocNIUType::NOC1_SRC;
-                auto src_bw_demand =
-                    niu_demand_grid[getNIUID(lt.params.src.row, lt.params.src.col, src_niu_type)];
-                auto src_bw_derate = lt.params.injection_rate / src_bw_demand;
-
-                auto sink_niu_type = lt.params.noc_type == nocType::NOC0 ? nocNIUType::NOC0_SINK
-                                                                         : nocNIUType::NOC1_SINK;
-
-                float sink_bw_derate = 1;
-                if (std::holds_alternative<Coord>(lt.params.dst)) {
-                    const auto &dst = std::get<Coord>(lt.params.dst);
-                    auto sink_bw_demand =
-                        niu_demand_grid[getNIUID(dst.row, dst.col, sink_niu_type)];
-                    sink_bw_derate = getSinkAbsorptionRate(dst) / sink_bw_demand;
-                } else {
-                    // multicast transfer speed is set by the slowest sink NIU
-                    const auto &mcast_dst = std::get<MulticastCoordSet>(lt.params.dst);
-                    float sink_demand = 0;
-                    for (const auto &loc : mcast_dst) {
-                        if (getCoreType(loc) == CoreType::WORKER) {
-                            sink_demand = std::min(
-                                sink_demand,
-                                niu_demand_grid[getNIUID(loc.row, loc.col, sink_niu_type)]);
-                        }
-                    }
-                    sink_bw_derate = worker_sink_absorption_rate / sink_demand;
+            // compute bottleneck (min derate factor) for source and sink NIUs
+            auto src_bw_derate =
+                transfers.injection_rate[ltid] / niu_demand_grid[transfers.src_niu_id[ltid]];
+
+            float sink_bw_derate = 1;
+            if (!transfers.is_multicast[ltid]) {
+                auto sink_bw_demand = niu_demand_grid[transfers.getSinkNIUIDs(ltid).front()];
+                sink_bw_derate = transfers.sink_absorption_rate[ltid] / sink_bw_demand;
+            } else {
+                // multicast transfer speed is set by the slowest sink NIU
+                float sink_demand = 0;
+                for (auto niu_id : transfers.getSinkNIUIDs(ltid)) {
+                    sink_demand = std::min(sink_demand, niu_demand_grid[niu_id]);
                 }
+                sink_bw_derate = transfers.sink_absorption_rate[ltid] / sink_demand;
+            }
 
-                auto min_niu_bw_derate = std::min(src_bw_derate, sink_bw_derate);
+            auto min_niu_bw_derate = std::min(src_bw_derate, sink_bw_derate);
 
-                if (min_link_bw_derate < 1.0 || min_niu_bw_derate < 1.0) {
-                    float overall_bw_derate = std::min(min_link_bw_derate, min_niu_bw_derate);
+            if (min_link_bw_derate < 1.0 || min_niu_bw_derate < 1.0) {
+                float overall_bw_derate = std::min(min_link_bw_derate, min_niu_bw_derate);
 
-                    lt.curr_bandwidth *= 1.0 - (grad_fac * (1.0f - overall_bw_derate));
-                }
+                transfers.curr_bandwidth[ltid] *= 1.0 - (grad_fac * (1.0f - overall_bw_derate));
             }
         }
     }
@@ -197,7 +128,7 @@ class WormholeB0DeviceModel : public npeDeviceModel {
     void computeCurrentTransferRate(
         Cycle start_timestep,
         Cycle end_timestep,
-        std::vector<PETransferState> &transfer_state,
+        PETransferHotState &transfer_state,
         const std::vector<PETransferID> &live_transfer_ids,
         npeDeviceState &device_state,
         bool enable_congestion_model) const override {
@@ -215,9 +146,7 @@ class WormholeB0DeviceModel : public npeDeviceModel {
                 end_timestep,
                 transfer_state,
                 live_transfer_ids,
-                device_state.getNIUDemandGrid(),
-                device_state.getLinkDemandGrid(),
-                device_state.getMulticastWriteLinkDemandGrid());
+                device_state);
         }
     }
 
@@ -250,13 +179,22 @@ class WormholeB0DeviceModel : public npeDeviceModel {
     }
 
     nocLinkID getLinkID(const nocLinkAttr &link_attr) const override {
-        auto it = link_attr_to_id_lookup.find(link_attr);
         TT_ASSERT(
-            it != link_attr_to_id_lookup.end(),
+            link_attr.coord.device_id == getDeviceID(),
             "Could not find Link ID for nocLinkAttr {{ {}, {} }}",
             link_attr.coord,
             magic_enum::enum_name(link_attr.type));
-        return it->second;
+        return getLinkID(link_attr.coord.row, link_attr.coord.col, link_attr.type);
+    }
+    nocLinkID getLinkID(size_t row, size_t col, nocLinkType type) const {
+        TT_ASSERT(
+            row < _num_rows && col < _num_cols,
+            "Could not find Link ID for ({}, {}) {}",
+            row,
+            col,
+            magic_enum::enum_name(type));
+        return denseResourceID(
+            0, row, col, denseLinkTypeIndex(type), _num_rows, _num_cols, NUM_DENSE_LINK_TYPES);
     }
 
     const nocNIUAttr &getNIUAttributes(const nocNIUID &niu_id) const override {
@@ -265,16 +203,22 @@ class WormholeB0DeviceModel : public npeDeviceModel {
     }
 
     nocNIUID getNIUID(const nocNIUAttr &niu_attr) const override {
-        auto it = niu_attr_to_id_lookup.find(niu_attr);
         TT_ASSERT(
-            it != niu_attr_to_id_lookup.end(),
+            niu_attr.coord.device_id == getDeviceID(),
             "Could not find NIU ID for nocNIUAttr {{ {}, {} }}",
             niu_attr.coord,
             magic_enum::enum_name(niu_attr.type));
-        return it->second;
+        return getNIUID(niu_attr.coord.row, niu_attr.coord.col, niu_attr.type);
     }
     nocNIUID getNIUID(size_t row, size_t col, nocNIUType type) const {
-        return getNIUID(nocNIUAttr{{getDeviceID(), row, col}, type});
+        size_t type_index = denseNIUTypeIndex(type);
+        TT_ASSERT(
+            row < _num_rows && col < _num_cols && type_index < NUM_DENSE_NIU_TYPES,
+            "Could not find NIU ID for ({}, {}) {}",
+            row,
+            col,
+            magic_enum::enum_name(type));
+        return denseResourceID(0, row, col, type_index, _num_rows, _num_cols, NUM_DENSE_NIU_TYPES);
     }
 
     const TransferBandwidthTable &getTransferBandwidthTable() const { return tbt; }
@@ -316,7 +260,22 @@ class WormholeB0DeviceModel : public npeDeviceModel {
         return getSinkAbsorptionRateByCoreType(getCoreType(c));
     }
 
-    nocRoute unicastRoute(
+    // returns table of precomputed routes shared by all instances of this model
+    const nocRouteTable &getRouteTable() const {
+        static const nocRouteTable route_table(
+            _num_rows,
+            _num_cols,
+            [this](nocType noc_type, size_t src_row, size_t src_col, size_t dst_row, size_t dst_col) {
+                return computeUnicastRoute(
+                    noc_type,
+                    {_device_id, int(src_row), int(src_col)},
+                    {_device_id, int(dst_row), int(dst_col)});
+            });
+        return route_table;
+    }
+
+    // computes dimension-ordered route hop by hop; see getRouteTable()
+    nocRoute computeUnicastRoute(
         nocType noc_type, const Coord &startpoint, const Coord &endpoint) const {
         nocRoute route;
         int32_t row = startpoint.row;
@@ -329,10 +288,10 @@ class WormholeB0DeviceModel : public npeDeviceModel {
             while (true) {
                 // for each movement, add the corresponding link to the vector
                 if (col != ecol) {
-                    route.push_back(getLinkID({{_device_id, row, col}, nocLinkType::NOC0_EAST}));
+                    route.push_back(getLinkID(row, col, nocLinkType::NOC0_EAST));
                     col = wrapToRange(col + 1, getCols());
                 } else if (row != erow) {
-                    route.push_back(getLinkID({{_device_id, row, col}, nocLinkType::NOC0_SOUTH}));
+                    route.push_back(getLinkID(row, col, nocLinkType::NOC0_SOUTH));
                     row = wrapToRange(row + 1, getRows());
                 } else {
                     break;
@@ -342,10 +301,10 @@ class WormholeB0DeviceModel : public npeDeviceModel {
             while (true) {
                 // for each movement, add the corresponding link to the vector
                 if (row != erow) {
-                    route.push_back(getLinkID({{_device_id, row, col}, nocLinkType::NOC1_NORTH}));
+                    route.push_back(getLinkID(row, col, nocLinkType::NOC1_NORTH));
                     row = wrapToRange(row - 1, getRows());
                 } else if (col != ecol) {
-                    route.push_back(getLinkID({{_device_id, row, col}, nocLinkType::NOC1_WEST}));
+                    route.push_back(getLinkID(row, col, nocLinkType::NOC1_WEST));
                     col = wrapToRange(col - 1, getCols());
                 } else {
                     break;
@@ -355,34 +314,41 @@ class WormholeB0DeviceModel : public npeDeviceModel {
         return route;
     }
 
-    nocRoute route(nocType noc_type, const Coord &startpoint, const NocDestination &destination)
-        const override {
+    void appendRoute(
+        nocType noc_type,
+        const Coord &startpoint,
+        const NocDestination &destination,
+        nocRoute &route) const override {
+        nocRouteView links;
         if (std::holds_alternative<Coord>(destination)) {
-            return unicastRoute(noc_type, startpoint, std::get<Coord>(destination));
+            links = getRouteTable().unicastRoute(noc_type, startpoint, std::get<Coord>(destination));
         } else {
-            MulticastCoordSet mcast_pair = std::get<MulticastCoordSet>(destination);
+            const MulticastCoordSet &mcast_pair = std::get<MulticastCoordSet>(destination);
             TT_ASSERT(mcast_pair.coord_grids.size() == 1);
             const auto &coord_pair = mcast_pair.coord_grids[0];
             const auto &start_coord = coord_pair.start_coord;
             const auto &end_coord = coord_pair.end_coord;
-            nocRoute route;
-
-            boost::unordered_flat_set<nocLinkID> unique_links;
-            if (noc_type == nocType::NOC0) {
-                for (int col = start_coord.col; col <= end_coord.col; col++) {
-                    auto partial_route =
-                        unicastRoute(noc_type, startpoint, {_device_id, end_coord.row, col});
-                    unique_links.insert(partial_route.begin(), partial_route.end());
-                }
-            } else {
-                for (int row = start_coord.row; row <= end_coord.row; row++) {
-                    auto partial_route =
-                        unicastRoute(noc_type, startpoint, {_device_id, row, end_coord.col});
-                    unique_links.insert(partial_route.begin(), partial_route.end());
+            const auto &route_table = getRouteTable();
+
+            links = route_table.multicastRoute(noc_type, startpoint, coord_pair, [&]() {
+                boost::unordered_flat_set<nocLinkID> unique_links;
+                if (noc_type == nocType::NOC0) {
+                    for (int col = start_coord.col; col <= end_coord.col; col++) {
+                        auto partial_route = route_table.unicastRoute(
+                            noc_type, startpoint, {_device_id, end_coord.row, col});
+                        unique_links.insert(partial_route.begin(), partial_route.end());
+                    }
+                } else {
+                    for (int row = start_coord.row; row <= end_coord.row; row++) {
+                        auto partial_route = route_table.unicastRoute(
+                            noc_type, startpoint, {_device_id, row, end_coord.col});
+                        unique_links.insert(partial_route.begin(), partial_route.end());
+                    }
                 }
-            }
-            return nocRoute(unique_links.begin(), unique_links.end());
+                return nocRoute(unique_links.begin(), unique_links.end());
+            });
         }
+        route.insert(route.end(), links.begin(), links.end());
     }
 
     // returns maximum possible bandwidth for a single noc transaction based on transfer bandwidth
@@ -34,6 +34,7 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
                         nocLinkAttr attr = {{device_id, r, c}, link_type};
                         link_id_to_attr_lookup.push_back(attr);
                         link_attr_to_id_lookup[attr] = link_id_to_attr_lookup.size() - 1;
+                        TT_ASSERT(getLinkID(attr) == link_attr_to_id_lookup.at(attr));
                     }
                 }
             }
@@ -48,36 +49,36 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
                         nocNIUAttr attr = {{device_id, r, c}, niu_type};
                         niu_id_to_attr_lookup.push_back(attr);
                         niu_attr_to_id_lookup[attr] = niu_id_to_attr_lookup.size() - 1;
+                        TT_ASSERT(getNIUID(attr) == niu_attr_to_id_lookup.at(attr));
                     }
                 }
             }
         }
     }
 
-    // substitutes desired device_id into every link of input route 
-    nocRoute changeRouteDeviceID(const nocRoute& route, DeviceID device_id) const { 
-        nocRoute end_route;
-        for (const auto& link_id : route) {
-            nocLinkAttr dev0_attr = getLinkAttributes(link_id);
-            // substitute device_id with startpoint.device_id
-            nocLinkAttr new_attr = {{device_id, dev0_attr.coord.row, dev0_attr.coord.col}, dev0_attr.type};
-            nocLinkID new_link_id = getLinkID(new_attr);
-            end_route.push_back(new_link_id);
+    // substitutes desired device_id into every link of route, in place
+    void changeRouteDeviceID(std::span<nocLinkID> route, DeviceID device_id) const {
+        for (auto& link_id : route) {
+            const nocLinkAttr& dev0_attr = getLinkAttributes(link_id);
+            link_id = getLinkID(device_id, dev0_attr.coord.row, dev0_attr.coord.col, dev0_attr.type);
         }
-        return end_route;
     }
 
-    // returns link-by-link route from startpoint to destination(s) for the specified noc type
-    nocRoute route(nocType noc_type, const Coord &startpoint, const NocDestination &destination)
-        const override {
+    // appends link-by-link route from startpoint to destination(s) for the specified noc type
+    void appendRoute(
+        nocType noc_type,
+        const Coord &startpoint,
+        const NocDestination &destination,
+        nocRoute &route) const override {
         // assert that this route is between two coords on the same device!
         auto destination_device_ids = getDeviceIDsFromNocDestination(destination);
         TT_ASSERT(destination_device_ids.size() == 1);  
         TT_ASSERT(destination_device_ids[0] == startpoint.device_id);  
 
         // route using wormhole_b0 model, then swap out device_id for correct one
-        nocRoute dev0_route = _wormhole_b0_model.route(noc_type, startpoint, destination);
-        return changeRouteDeviceID(dev0_route, startpoint.device_id);
+        size_t route_begin = route.size();
+        _wormhole_b0_model.appendRoute(noc_type, startpoint, destination, route);
+        changeRouteDeviceID(std::span(route).subspan(route_begin), startpoint.device_id);
     }
 
     // Initialize device state with appropriate dimensions for this device model
@@ -90,76 +91,19 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
     void modelCongestion(
         Cycle start_timestep,
         Cycle end_timestep,
-        std::vector<PETransferState> &transfers,
+        PETransferHotState &transfers,
         const std::vector<PETransferID> &live_transfer_ids,
-        NIUDemandGrid &niu_demand_grid,
-        LinkDemandGrid &link_demand_grid,
-        LinkDemandGrid &multicast_write_link_demand_grid) const {
-        Cycle cycles_per_timestep = end_timestep - start_timestep;
-
+        npeDeviceState &device_state) const {
         // assume all links have identical bandwidth
         float LINK_BANDWIDTH = getLinkBandwidth(nocLinkID());
-        static auto worker_sink_absorption_rate =
-            _wormhole_b0_model.getSinkAbsorptionRateByCoreType(CoreType::WORKER);
 
         // determine effective demand through each link
-        std::fill(link_demand_grid.begin(), link_demand_grid.end(), 0.0f);
-        std::fill(niu_demand_grid.begin(), niu_demand_grid.end(), 0.0f);
-        std::fill(
-            multicast_write_link_demand_grid.begin(),
-            multicast_write_link_demand_grid.end(),
-            0.0f);
-        for (auto ltid : live_transfer_ids) {
-            auto &lt = transfers[ltid];
-
-            // account for transfers starting mid-way into timestep, and derate effective
-            // utilization accordingly
-            Cycle predicted_start = std::max(start_timestep, lt.start_cycle);
-            float effective_demand =
-                float(end_timestep - predicted_start) / float(cycles_per_timestep);
-            effective_demand *= lt.curr_bandwidth;
-
-            // track demand at src and sink NIU
-            nocNIUType src_niu_type =
-                lt.params.noc_type == nocType::NOC0 ? nocNIUType::NOC0_SRC : nocNIUType::NOC1_SRC;
-            nocNIUID niu_id = getNIUID(
-                lt.params.src.device_id, lt.params.src.row, lt.params.src.col, src_niu_type);
-            niu_demand_grid[niu_id] += effective_demand;
-
-            nocNIUType sink_niu_type =
-                lt.params.noc_type == nocType::NOC0 ? nocNIUType::NOC0_SINK : nocNIUType::NOC1_SINK;
-            if (std::holds_alternative<Coord>(lt.params.dst)) {
-                const auto &dst = std::get<Coord>(lt.params.dst);
-                nocNIUID niu_id = getNIUID(dst.device_id, dst.row, dst.col, sink_niu_type);
-                niu_demand_grid[niu_id] += effective_demand;
-            } else {
-                const auto &mcast_dst = std::get<MulticastCoordSet>(lt.params.dst);
-                for (auto c : mcast_dst) {
-                    // multicast only loads on WORKER NIUs; other NIUS ignore traffic
-                    if (getCoreType(c) == CoreType::WORKER) {
-                        nocNIUID niu_id = getNIUID(c.device_id, c.row, c.col, sink_niu_type);
-                        niu_demand_grid[niu_id] += effective_demand;
-                    }
-                }
-            }
-
-            const bool is_multicast_write = lt.params.noc_event_type == "WRITE_MULTICAST";
-            if (is_multicast_write) {
-                for (const auto &link_id : lt.route) {
-                    link_demand_grid[link_id] += effective_demand;
-                    multicast_write_link_demand_grid[link_id] += effective_demand;
-                }
-            } else {
-                for (const auto &link_id : lt.route) {
-                    link_demand_grid[link_id] += effective_demand;
-                }
-            }
-        }
+        device_state.updateDemandGrids(start_timestep, end_timestep, transfers, live_transfer_ids);
+        const auto &niu_demand_grid = device_state.getNIUDemandGrid();
+        const auto &link_demand_grid = device_state.getLinkDemandGrid();
 
         // find highest demand resource on each route to set bandwidth
         for (auto ltid : live_transfer_ids) {
-            auto &lt = transfers[ltid];
-
             // find max link demand on route
             float max_link_demand_on_route = 0;
             auto update_max_link_demand = [&max_link_demand_on_route](float demand) -> bool {
@@ -170,47 +114,33 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
                     return false;
                 }
             };
-            for (const auto &link_id : lt.route) {
+            for (const auto &link_id : transfers.route[ltid]) {
                 update_max_link_demand(link_demand_grid[link_id]);
             }
             auto min_link_bw_derate = LINK_BANDWIDTH / max_link_demand_on_route;
 
             // compute bottleneck (min derate factor) for source and sink NIUs
-            auto src_niu_type =
-                lt.params.noc_type == nocType::NOC0 ? nocNIUType::NOC0_SRC : nocNIUType::NOC1_SRC;
-            auto src_bw_demand = niu_demand_grid[getNIUID(
-                lt.params.src.device_id, lt.params.src.row, lt.params.src.col, src_niu_type)];
-            auto src_bw_derate = lt.params.injection_rate / src_bw_demand;
-
-            auto sink_niu_type =
-                lt.params.noc_type == nocType::NOC0 ? nocNIUType::NOC0_SINK : nocNIUType::NOC1_SINK;
+            auto src_bw_derate =
+                transfers.injection_rate[ltid] / niu_demand_grid[transfers.src_niu_id[ltid]];
 
             float sink_bw_derate = 1;
-            if (std::holds_alternative<Coord>(lt.params.dst)) {
-                const auto &dst = std::get<Coord>(lt.params.dst);
-                auto sink_bw_demand =
-                    niu_demand_grid[getNIUID(dst.device_id, dst.row, dst.col, sink_niu_type)];
-                sink_bw_derate = getSinkAbsorptionRate(dst) / sink_bw_demand;
+            if (!transfers.is_multicast[ltid]) {
+                auto sink_bw_demand = niu_demand_grid[transfers.getSinkNIUIDs(ltid).front()];
+                sink_bw_derate = transfers.sink_absorption_rate[ltid] / sink_bw_demand;
             } else {
                 // multicast transfer speed is set by the slowest sink NIU
-                const auto &mcast_dst = std::get<MulticastCoordSet>(lt.params.dst);
                 float sink_demand = 0;
-                for (const auto &loc : mcast_dst) {
-                    if (getCoreType(loc) == CoreType::WORKER) {
-                        sink_demand = std::min(
-                            sink_demand,
-                            niu_demand_grid[getNIUID(
-                                loc.device_id, loc.row, loc.col, sink_niu_type)]);
-                    }
+                for (auto niu_id : transfers.getSinkNIUIDs(ltid)) {
+                    sink_demand = std::min(sink_demand, niu_demand_grid[niu_id]);
                 }
-                sink_bw_derate = worker_sink_absorption_rate / sink_demand;
+                sink_bw_derate = transfers.sink_absorption_rate[ltid] / sink_demand;
             }
 
             auto min_niu_bw_derate = std::min(src_bw_derate, sink_bw_derate);
 
             if (min_link_bw_derate < 1.0 || min_niu_bw_derate < 1.0) {
                 float overall_bw_derate = std::min(min_link_bw_derate, min_niu_bw_derate);
-                lt.curr_bandwidth *= overall_bw_derate;
+                transfers.curr_bandwidth[ltid] *= overall_bw_derate;
             }
         }
     }
@@ -219,7 +149,7 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
     void computeCurrentTransferRate(
         Cycle start_timestep,
         Cycle end_timestep,
-        std::vector<PETransferState> &transfer_state,
+        PETransferHotState &transfer_state,
         const std::vector<PETransferID> &live_transfer_ids,
         npeDeviceState &device_state,
         bool enable_congestion_model) const override {
@@ -238,9 +168,7 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
                 end_timestep,
                 transfer_state,
                 live_transfer_ids,
-                device_state.getNIUDemandGrid(),
-                device_state.getLinkDemandGrid(),
-                device_state.getMulticastWriteLinkDemandGrid());
+                device_state);
         }
     }
 
@@ -261,13 +189,23 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
         return link_id_to_attr_lookup[link_id];
     }
     nocLinkID getLinkID(const nocLinkAttr &link_attr) const override {
-        auto it = link_attr_to_id_lookup.find(link_attr);
+        return getLinkID(
+            link_attr.coord.device_id, link_attr.coord.row, link_attr.coord.col, link_attr.type);
+    }
+    nocLinkID getLinkID(DeviceID device_id, size_t row, size_t col, nocLinkType type) const {
         TT_ASSERT(
-            it != link_attr_to_id_lookup.end(),
+            size_t(device_id) < _num_chips && row < getRows() && col < getCols(),
             "Could not find Link ID for nocLinkAttr {{ {}, {} }}",
-            link_attr.coord,
-            magic_enum::enum_name(link_attr.type));
-        return it->second;
+            Coord{device_id, int(row), int(col)},
+            magic_enum::enum_name(type));
+        return denseResourceID(
+            device_id,
+            row,
+            col,
+            denseLinkTypeIndex(type),
+            getRows(),
+            getCols(),
+            NUM_DENSE_LINK_TYPES);
     }
     const std::vector<nocLinkType> &getLinkTypes() const override {
         return _wormhole_b0_model.getLinkTypes();
@@ -279,16 +217,19 @@ class WormholeMultichipDeviceModel : public npeDeviceModel {
         return niu_id_to_attr_lookup[niu_id];
     }
     nocNIUID getNIUID(const nocNIUAttr &niu_attr) const override {
-        auto it = niu_attr_to_id_lookup.find(niu_attr);
-        TT_ASSERT(
-            it != niu_attr_to_id_lookup.end(),
-            "Could not find NIU ID for nocNIUAttr {{ {}, {} }}",
-            niu_attr.coord,
-            magic_enum::enum_name(niu_attr.type));
-        return it->second;
+        return getNIUID(
+            niu_attr.coord.device_id, niu_attr.coord.row, niu_attr.coord.col, niu_attr.type);
     }
     nocNIUID getNIUID(DeviceID device_id, size_t row, size_t col, nocNIUType type) const {
-        return getNIUID(nocNIUAttr{{device_id, row, col}, type});
+        size_t type_index = denseNIUTypeIndex(type);
+        TT_ASSERT(
+            size_t(device_id) < _num_chips && row < getRows() && col < getCols() &&
+                type_index < NUM_DENSE_NIU_TYPES,
+            "Could not find NIU ID for nocNIUAttr {{ {}, {} }}",
+            Coord{device_id, int(row), int(col)},
+            magic_enum::enum_name(type));
+        return denseResourceID(
+            device_id, row, col, type_index, getRows(), getCols(), NUM_DENSE_NIU_TYPES);
     }
     const std::vector<nocNIUType> &getNIUTypes() const override {
         return _wormhole_b0_model.getNIUTypes();
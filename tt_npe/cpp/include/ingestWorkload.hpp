@@ -7,7 +7,50 @@
 
 namespace tt_npe {
 
+// Version of the conversion of JSON workloads and noc traces into workloads;
+// bump it whenever a change alters the workloads converted from the same
+// files, so that workloads cached by an earlier version are not reused.
+constexpr uint32_t WORKLOAD_CONVERTER_VERSION = 1;
+
+// Creates a workload from a JSON workload or a tt-metal noc trace. If
+// cache_dir is not empty, the converted workload is cached there (see
+// npeWorkloadCache), and later calls on a file with the same contents load it
+// instead of parsing the file again.
 std::optional<npeWorkload> createWorkloadFromJSON(
-    const std::string &wl_filename, const std::string &device_name, bool is_tt_metal_trace_format, bool verbose = false);
+    const std::string &wl_filename,
+    const std::string &device_name,
+    bool is_tt_metal_trace_format,
+    bool verbose = false,
+    const std::string &cache_dir = "");
+
+constexpr size_t DEFAULT_TRACE_INGEST_CHUNK_SIZE = 4 << 20;
+
+// Converts a tt-metal noc trace into a workload. The trace is read in chunks
+// of about chunk_size bytes, which are ingested on num_threads threads (0 uses
+// one per hardware thread). The workload is the same for any chunk size and
+// number of threads.
+std::optional<npeWorkload> convertNocTracesToNpeWorkload(
+    const std::string &input_filepath,
+    const std::string &device_name,
+    bool verbose = false,
+    size_t num_threads = 0,
+    size_t chunk_size = DEFAULT_TRACE_INGEST_CHUNK_SIZE);
+
+// Merges the per-device noc traces of a multichip run into a single workload.
+// Each of trace_files is a trace, or a pattern whose filename may contain '*'
+// and '?' wildcards (e.g. "noc_trace_dev*_AllGatherAsync_ID1.json"). The
+// paths of fabric sends are elaborated from the run's topology.json, and
+// cycles are relative to the earliest event of any trace. If device_name is
+// empty, the cluster type of the topology is used. Traces are read and
+// ingested on num_threads threads (0 uses one per hardware thread). If
+// cache_dir is not empty, the merged workload is cached there as for
+// createWorkloadFromJSON.
+std::optional<npeWorkload> convertNocTraceFilesToNpeWorkload(
+    const std::vector<std::string> &trace_files,
+    const std::string &topology_filepath,
+    const std::string &device_name = "",
+    bool verbose = false,
+    size_t num_threads = 0,
+    const std::string &cache_dir = "");
 
 }  // namespace tt_npe
\ No newline at end of file
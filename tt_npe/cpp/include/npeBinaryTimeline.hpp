@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "npeCommon.hpp"
+
+namespace tt_npe {
+
+// Per-timestep timeline data in columnar form; a compact binary alternative
+// to the timestep_data section of a v1 .npeviz timeline. Transfers, zones and
+// summary stats are only emitted in the .npeviz file.
+//
+// Links and NIUs are dictionary-encoded: each demand entry refers to an
+// endpoint by its index in `endpoints`. Variable length per-timestep data is
+// stored in CSR form; the entries of timestep i are [offsets[i], offsets[i+1]).
+//
+// On disk, cycles are delta-encoded varints, demand is quantized to 16 bits
+// (see SparseDemand) and per-timestep stats are stored as 32-bit floats.
+struct npeBinaryTimeline {
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    // a link or NIU that demand is reported for
+    struct Endpoint {
+        DeviceID device_id;
+        int16_t row;
+        int16_t col;
+        std::string type;  // link type (e.g. "NOC0_EAST") or NIU terminal (e.g. "NOC0_IN")
+
+        bool operator==(const Endpoint &rhs) const = default;
+    };
+
+    std::string device_name;
+    std::string arch;
+    Cycle cycles_per_timestep = 0;
+    std::vector<Endpoint> endpoints;
+
+    // per timestep columns
+    std::vector<Cycle> start_cycle;
+    std::vector<Cycle> end_cycle;
+    std::vector<float> avg_link_demand;
+    std::vector<float> avg_link_util;
+    std::vector<float> mcast_write_link_util;
+    std::vector<float> avg_noc0_link_demand;
+    std::vector<float> avg_noc0_link_util;
+    std::vector<float> max_noc0_link_demand;
+    std::vector<float> avg_noc1_link_demand;
+    std::vector<float> avg_noc1_link_util;
+    std::vector<float> max_noc1_link_demand;
+
+    // transfer groups active in each timestep (as in the .npeviz active_transfers)
+    std::vector<uint32_t> active_transfer_offsets = {0};
+    std::vector<int32_t> active_transfers;
+
+    // link/NIU demand in each timestep
+    std::vector<uint32_t> demand_offsets = {0};
+    std::vector<uint32_t> demand_endpoint;
+    std::vector<float> demand;
+
+    size_t numTimesteps() const { return start_cycle.size(); }
+
+    // writes timeline to filepath; returns false if the file could not be written
+    bool writeToFile(const std::string &filepath) const;
+
+    // reads a timeline written by writeToFile; returns std::nullopt if the file can not be read
+    static std::optional<npeBinaryTimeline> readFromFile(const std::string &filepath);
+};
+
+}  // namespace tt_npe
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace tt_npe {
+
+// Little-endian byte encoding shared by tt-npe's binary file formats.
+// Integers are stored as LEB128 varints (zigzag-encoded if signed), strings
+// as a varint length followed by their bytes.
+class ByteWriter {
+   public:
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            bytes += char(value | 0x80);
+            value >>= 7;
+        }
+        bytes += char(value);
+    }
+    void putZigzag(int64_t value) { putVarint((uint64_t(value) << 1) ^ uint64_t(value >> 63)); }
+    template <typename T>
+    void putRaw(T value) {
+        bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+    void putString(std::string_view str) {
+        putVarint(str.size());
+        bytes += str;
+    }
+    // appends column, prefixed by its size
+    void putColumn(const ByteWriter &column) { putString(column.bytes); }
+
+    std::string bytes;
+};
+
+// Decodes data written by ByteWriter; throws std::runtime_error if it is
+// malformed or truncated.
+class ByteReader {
+   public:
+    explicit ByteReader(std::string_view bytes) : bytes(bytes) {}
+
+    uint64_t getVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = getRaw<uint8_t>();
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("malformed varint");
+    }
+    int64_t getZigzag() {
+        uint64_t value = getVarint();
+        return int64_t(value >> 1) ^ -int64_t(value & 1);
+    }
+    template <typename T>
+    T getRaw() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+    std::string_view getString() { return take(getVarint()); }
+    ByteReader getColumn() { return ByteReader(getString()); }
+    bool atEnd() const { return pos == bytes.size(); }
+
+   private:
+    std::string_view take(size_t size) {
+        if (size > bytes.size() - pos) {
+            throw std::runtime_error("unexpected end of data");
+        }
+        auto taken = bytes.substr(pos, size);
+        pos += size;
+        return taken;
+    }
+
+    std::string_view bytes;
+    size_t pos = 0;
+};
+
+}  // namespace tt_npe
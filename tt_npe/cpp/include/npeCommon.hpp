@@ -26,7 +26,8 @@ enum class npeErrorCode {
     DEVICE_MODEL_INIT_FAILED = 4,
     SIM_ENGINE_INIT_FAILED = 5,
     TRACE_INGEST_FAILED = 6,
-    DEPENDENCY_GEN_FAILED = 7
+    DEPENDENCY_GEN_FAILED = 7,
+    DEPENDENCY_DEADLOCK = 8
 };
 
 enum CoreType {
@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <string_view>
 
 namespace tt_npe {
 
@@ -21,6 +26,23 @@ public:
      */
     static bool compressToFile(const std::string& contents, const std::string& filepath);
 
+    /**
+     * @brief Compresses the given string contents into a single zstd frame in memory.
+     *
+     * @param contents The string data to compress.
+     * @param compression_level The zstd compression level.
+     * @return The compressed frame, or std::nullopt if compression failed.
+     */
+    static std::optional<std::string> compressToString(std::string_view contents, int compression_level);
+
+    /**
+     * @brief Checks that a compression level is supported by zstd.
+     *
+     * @param compression_level The zstd compression level.
+     * @return True if zstd accepts the compression level, false otherwise.
+     */
+    static bool isValidCompressionLevel(int compression_level);
+
 private:
     // Prevent instantiation
     npeCompressionUtil() = delete;
@@ -29,4 +51,67 @@ private:
     npeCompressionUtil& operator=(const npeCompressionUtil&) = delete;
 };
 
+/**
+ * @brief Output stream that compresses everything written to it into a zstd file.
+ *
+ * Data is compressed in chunks as it is written (using ZSTD_compressStream2),
+ * so the uncompressed contents are never held in memory in full. Compression
+ * can be spread over multiple zstd worker threads.
+ *
+ * If a maximum frame size is given, the file is written in the zstd seekable
+ * format: data is split into independently compressed frames, and a seek
+ * table listing every frame is appended on close. The file remains a regular
+ * zstd file to tools that are unaware of the seek table.
+ */
+class npeCompressedFileStream : public std::ostream {
+public:
+    // Magic number of zstd skippable frames; the lower 4 bits are user defined
+    static constexpr uint32_t SKIPPABLE_FRAME_MAGIC = 0x184D2A50;
+    // Skippable frame variant (lower 4 bits) reserved for the seek table
+    static constexpr uint32_t SEEK_TABLE_FRAME_VARIANT = 0xE;
+    static constexpr uint32_t SEEKABLE_MAGIC = 0x8F92EAB1;
+
+    /**
+     * @brief Opens filepath for writing compressed data.
+     *
+     * @param filepath The path to the file where compressed data will be written.
+     * @param compression_level The zstd compression level.
+     * @param num_workers Number of zstd worker threads; 0 compresses on the calling thread.
+     * @param max_frame_size If nonzero, the maximum uncompressed size of each frame of a seekable file.
+     */
+    npeCompressedFileStream(
+        const std::string& filepath, int compression_level, int num_workers, size_t max_frame_size = 0);
+    ~npeCompressedFileStream();
+
+    /**
+     * @brief Ends the current frame and writes payload into a zstd skippable frame.
+     *
+     * Skippable frames are ignored by zstd decompression; they are used to embed
+     * data that is only read by seeking to it.
+     *
+     * @param variant The user defined lower 4 bits of the skippable frame magic number.
+     * @param payload The contents of the frame.
+     * @return The file offset of the payload, or std::nullopt if it could not be written.
+     */
+    std::optional<size_t> writeSkippableFrame(uint32_t variant, std::string_view payload);
+
+    /**
+     * @brief Ends the current frame of a seekable file, so that data written next starts a new frame.
+     *
+     * @return The file offset at which the next frame starts, or std::nullopt if the frame could not be written.
+     */
+    std::optional<size_t> endFrame();
+
+    /**
+     * @brief Ends the zstd frame and closes the file. Called by the destructor if not called explicitly.
+     *
+     * @return True if all data written to the stream was compressed and written successfully, false otherwise.
+     */
+    bool close();
+
+private:
+    class ZstdStreamBuf;
+    std::unique_ptr<ZstdStreamBuf> buf;
+};
+
 } // namespace tt_npe
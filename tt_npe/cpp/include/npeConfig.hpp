@@ -24,10 +24,16 @@ struct npeConfig {
     bool infer_injection_rate_from_src = true;
     bool emit_timeline_file = false;
     bool estimate_cong_impact = true;
+    bool fast_forward_idle_timesteps = false;
+    bool fast_forward_steady_state = false;
     bool workload_is_noc_trace = false;
     bool remove_localized_unicast_transfers = false;
     bool compress_timeline_output_file = false;
+    int timeline_compression_level = 3; // zstd compression level for compressed timeline files
+    int timeline_compression_num_workers = 0; // zstd worker threads; 0 compresses on the calling thread
+    bool seekable_timeline_output_file = false; // write a seekable compressed timeline indexed by split region instead of emitting split files
     bool use_legacy_timeline_format = false;
+    bool emit_binary_timeline_file = false; // also emit timestep data in binary columnar form (.npetl); v1 format only
     std::string timeline_filepath = "";
     float scale_workload_schedule = 0.0f;
     std::string topology_json; // Path to topology JSON file
@@ -52,16 +58,22 @@ struct npeConfig {
         repr += fmt::format("\n  congestion_model_name              = {}", congestion_model_name);
         repr += fmt::format("\n  estimate_cong_impact               = {}", estimate_cong_impact);
         repr += fmt::format("\n  cycles_per_timestep                = {}", cycles_per_timestep);
+        repr += fmt::format("\n  fast_forward_idle_timesteps        = {}", fast_forward_idle_timesteps);
+        repr += fmt::format("\n  fast_forward_steady_state          = {}", fast_forward_steady_state);
         repr += fmt::format(
             "\n  infer_injection_rate_from_src      = {}", infer_injection_rate_from_src);
         repr += "\n";
         repr += fmt::format(
             "\n  compress_timeline_output_file      = {}", compress_timeline_output_file);
+        repr += fmt::format("\n  timeline_compression_level         = {}", timeline_compression_level);
+        repr += fmt::format("\n  timeline_compression_num_workers   = {}", timeline_compression_num_workers);
+        repr += fmt::format("\n  seekable_timeline_output_file      = {}", seekable_timeline_output_file);
         repr += fmt::format("\n  enable_visualizations              = {}", enable_visualizations);
         repr += fmt::format(
             "\n  remove_localized_unicast_transfers = {}", remove_localized_unicast_transfers);
         repr += fmt::format("\n  scale_workload_schedule            = {}", scale_workload_schedule);
         repr += fmt::format("\n  use_legacy_timeline_format         = {}", use_legacy_timeline_format);
+        repr += fmt::format("\n  emit_binary_timeline_file          = {}", emit_binary_timeline_file);
         repr += fmt::format("\n  topology_json                      = \"{}\"", topology_json);
         repr += fmt::format("\n  timeline_split_threshold_timesteps = {}", timeline_split_threshold_timesteps);
         repr += "\n}";
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "npeDeviceTypes.hpp"
+
+namespace tt_npe {
+
+// instruction set used by demand reduction kernels
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+// returns best SimdLevel supported by the host CPU
+SimdLevel getSupportedSimdLevel();
+
+// Per-type reduction of a block of demand values. Blocks are laid out in the
+// dense (row, col, type) order used by every device model, so the type of
+// element i is i % NUM_DENSE_LINK_TYPES (see denseLinkTypeIndex()).
+struct DemandReduction {
+    static constexpr size_t NUM_TYPES = NUM_DENSE_LINK_TYPES;
+    static_assert(NUM_DENSE_NIU_TYPES == NUM_TYPES);
+
+    std::array<double, NUM_TYPES> demand_sum{};
+    // sum of min(demand, max bandwidth)
+    std::array<double, NUM_TYPES> util_sum{};
+    // sum of min(multicast write demand, max bandwidth)
+    std::array<double, NUM_TYPES> mcast_write_util_sum{};
+    std::array<float, NUM_TYPES> max_demand{};
+
+    void merge(const DemandReduction &other);
+
+    double totalDemand() const;
+    double totalUtil() const;
+    double totalMcastWriteUtil() const;
+    float maxDemand() const;
+};
+
+// reduces a block of link demand; block size must be a multiple of NUM_DENSE_LINK_TYPES
+DemandReduction reduceLinkDemand(
+    std::span<const float> link_demand,
+    std::span<const float> mcast_write_link_demand,
+    float max_link_bandwidth,
+    SimdLevel simd_level = getSupportedSimdLevel());
+
+// reduces a block of NIU demand (util sums are left empty); block size must be
+// a multiple of NUM_DENSE_NIU_TYPES
+DemandReduction reduceNIUDemand(
+    std::span<const float> niu_demand, SimdLevel simd_level = getSupportedSimdLevel());
+
+}  // namespace tt_npe
@@ -3,14 +3,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <optional>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "npeAssert.hpp"
 #include "npeCommon.hpp"
 
 namespace tt_npe {
 using npeCheckpointID = int32_t;
+using npeDependentID = int32_t;
 
 class npeTransferDependencyTracker {
    public:
@@ -22,7 +27,8 @@ class npeTransferDependencyTracker {
     static constexpr npeCheckpointID UNDEFINED_CHECKPOINT = -1;
     bool defined(npeCheckpointID id) { return id != UNDEFINED_CHECKPOINT; }
 
-    // increments dep counter for checkpoint
+    // increments dep counter for checkpoint; once all deps are completed, the
+    // checkpoint's dependents are moved to the ready queue
     void updateCheckpoint(npeCheckpointID id, Cycle end_cycle) {
         if (!defined(id))
             return;
@@ -30,6 +36,42 @@ class npeTransferDependencyTracker {
         auto& cp = checkpoints[id];
         cp.dep_completed++;
         cp.end_cycle = std::max(cp.end_cycle, end_cycle);
+        if (cp.allDepsComplete()) {
+            for (const auto& dep : cp.dependents) {
+                pushReady(dep.id, std::max(dep.earliest_release_cycle, cp.end_cycle + cp.delay));
+            }
+        }
+    }
+
+    // registers dependent to be released no earlier than earliest_release_cycle
+    // and after checkpoint id is done; dependents with an undefined checkpoint
+    // are immediately ready
+    void addDependent(npeCheckpointID id, npeDependentID dependent_id, Cycle earliest_release_cycle) {
+        if (!defined(id)) {
+            pushReady(dependent_id, earliest_release_cycle);
+            return;
+        }
+        TT_ASSERT(id < checkpoints.size());
+        checkpoints[id].dependents.push_back({dependent_id, earliest_release_cycle});
+    }
+
+    // returns earliest release cycle of any ready dependent, or nullopt if none are ready
+    std::optional<Cycle> nextReleaseCycle() const {
+        if (ready_queue.empty())
+            return std::nullopt;
+        return ready_queue.front().release_cycle;
+    }
+
+    // pops the next dependent released at or before curr_cycle, if there is
+    // one; dependents are popped in order of release cycle, then id,
+    // regardless of the order in which their checkpoints completed
+    std::optional<std::pair<npeDependentID, Cycle>> popReady(Cycle curr_cycle) {
+        if (ready_queue.empty() || ready_queue.front().release_cycle > curr_cycle)
+            return std::nullopt;
+        std::pop_heap(ready_queue.begin(), ready_queue.end(), std::greater<>());
+        auto entry = ready_queue.back();
+        ready_queue.pop_back();
+        return std::make_pair(entry.id, entry.release_cycle);
     }
 
     Cycle end_cycle(npeCheckpointID id) {
@@ -77,10 +119,30 @@ class npeTransferDependencyTracker {
     void reset() {
         for (auto& c : checkpoints) {
             c.dep_completed = 0;
+            c.end_cycle = 0;
+            c.dependents.clear();
         }
+        ready_queue.clear();
     }
 
    private:
+    struct Dependent {
+        npeDependentID id;
+        Cycle earliest_release_cycle;
+    };
+
+    // ready queue entries are min-ordered by release cycle, then id
+    struct ReadyEntry {
+        Cycle release_cycle;
+        npeDependentID id;
+        auto operator<=>(const ReadyEntry&) const = default;
+    };
+
+    void pushReady(npeDependentID id, Cycle release_cycle) {
+        ready_queue.push_back({release_cycle, id});
+        std::push_heap(ready_queue.begin(), ready_queue.end(), std::greater<>());
+    }
+
     struct npeCheckpoint {
         npeCheckpoint(uint32_t total_dep_count, npeCheckpointID id, Cycle delay) :
             dep_completed(0), dep_total(total_dep_count), id(id), end_cycle(0), delay(delay) {}
@@ -98,8 +160,10 @@ class npeTransferDependencyTracker {
         Cycle end_cycle;
         Cycle delay;
         npeCheckpointID id;
+        boost::container::small_vector<Dependent, 1> dependents;
     };
 
     std::vector<npeCheckpoint> checkpoints;
+    std::vector<ReadyEntry> ready_queue;
 };
 }  // namespace tt_npe
@@ -24,9 +24,20 @@ class npeDeviceModel {
    public:
     virtual ~npeDeviceModel() {}
 
+    // appends link-by-link route from startpoint to destination(s) for the specified noc type
+    // to the end of route
+    virtual void appendRoute(
+        nocType noc_type,
+        const Coord &startpoint,
+        const NocDestination &destination,
+        nocRoute &route) const = 0;
+
     // returns link-by-link route from startpoint to destination(s) for the specified noc type
-    virtual nocRoute route(
-        nocType noc_type, const Coord &startpoint, const NocDestination &destination) const = 0;
+    nocRoute route(nocType noc_type, const Coord &startpoint, const NocDestination &destination) const {
+        nocRoute noc_route;
+        appendRoute(noc_type, startpoint, destination, noc_route);
+        return noc_route;
+    }
 
     // Initialize device state with appropriate dimensions for this device model
     virtual std::unique_ptr<npeDeviceState> initDeviceState() const = 0;
@@ -35,7 +46,7 @@ class npeDeviceModel {
     virtual void computeCurrentTransferRate(
         Cycle start_timestep,
         Cycle end_timestep,
-        std::vector<PETransferState> &transfer_state,
+        PETransferHotState &transfer_state,
         const std::vector<PETransferID> &live_transfer_ids,
         npeDeviceState &device_state,
         bool enable_congestion_model) const = 0;
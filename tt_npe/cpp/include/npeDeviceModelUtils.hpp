@@ -6,6 +6,7 @@
 #include <boost/unordered/unordered_flat_map.hpp>
 
 #include "npeCommon.hpp"
+#include "npeDemandReduction.hpp"
 #include "npeDeviceModelIface.hpp"
 #include "npeStats.hpp"
 #include "npeTransferState.hpp"
@@ -48,60 +49,153 @@ inline float interpolateBW(
     TT_ASSERT(false, "interpolation of bandwidth failed");
     return 0;
 }
+// resets each live transfer's bandwidth to its congestion-free peak; the peak
+// is fixed per transfer, so it is computed once on first use and cached
 inline void updateTransferBandwidth(
-    std::vector<PETransferState> *transfers,
+    PETransferHotState *transfers,
     const std::vector<PETransferID> &live_transfer_ids,
     const TransferBandwidthTable &transfer_bandwidth_table,
     float max_transfer_bandwidth) {
     for (auto &ltid : live_transfer_ids) {
-        auto &lt = (*transfers)[ltid];
-        auto noc_limited_bw = interpolateBW(
-            transfer_bandwidth_table,
-            max_transfer_bandwidth,
-            lt.params.packet_size,
-            lt.params.num_packets);
-        lt.curr_bandwidth = std::fmin(lt.params.injection_rate, noc_limited_bw);
+        float &peak_bandwidth = transfers->peak_bandwidth[ltid];
+        if (peak_bandwidth == PETransferHotState::UNRESOLVED_BANDWIDTH) {
+            auto noc_limited_bw = interpolateBW(
+                transfer_bandwidth_table,
+                max_transfer_bandwidth,
+                transfers->packet_size[ltid],
+                transfers->num_packets[ltid]);
+            peak_bandwidth = std::fmin(transfers->injection_rate[ltid], noc_limited_bw);
+        }
+        transfers->curr_bandwidth[ltid] = peak_bandwidth;
+    }
+}
+
+// resolves the src/sink NIU IDs and sink absorption rate for a transfer
+inline void resolveTransferNIUs(const npeDeviceModel &model, PETransferState &lt) {
+    nocNIUType src_niu_type =
+        lt.params->noc_type == nocType::NOC0 ? nocNIUType::NOC0_SRC : nocNIUType::NOC1_SRC;
+    nocNIUType sink_niu_type =
+        lt.params->noc_type == nocType::NOC0 ? nocNIUType::NOC0_SINK : nocNIUType::NOC1_SINK;
+    lt.src_niu_id = model.getNIUID({lt.params->src, src_niu_type});
+
+    lt.sink_niu_ids.clear();
+    if (std::holds_alternative<Coord>(lt.params->dst)) {
+        const auto &dst = std::get<Coord>(lt.params->dst);
+        lt.sink_niu_ids.push_back(model.getNIUID({dst, sink_niu_type}));
+        lt.sink_absorption_rate = model.getSinkAbsorptionRate(dst);
+    } else {
+        const auto &mcast_dst = std::get<MulticastCoordSet>(lt.params->dst);
+        lt.sink_absorption_rate = 0;
+        for (const auto &c : mcast_dst) {
+            // multicast only loads on WORKER NIUs; other NIUS ignore traffic
+            if (model.getCoreType(c) == CoreType::WORKER) {
+                lt.sink_niu_ids.push_back(model.getNIUID({c, sink_niu_type}));
+                lt.sink_absorption_rate = model.getSinkAbsorptionRate(c);
+            } else if (lt.sink_niu_ids.empty()) {
+                lt.sink_absorption_rate = model.getSinkAbsorptionRate(c);
+            }
+        }
     }
 }
 
+// contiguous block of link and NIU IDs belonging to each device, resolved once
+// per simulation so that updateSimulationStats can reduce each device's
+// demand in a single pass
+struct SimulationStatsLookup {
+    struct DeviceBlock {
+        // null if the device's stats are derived from the mesh stats
+        npeStats::deviceStats *stats = nullptr;
+        size_t link_begin = 0, link_end = 0;
+        size_t niu_begin = 0, niu_end = 0;
+    };
+
+    SimulationStatsLookup(
+        const npeDeviceModel &device_model,
+        npeStats &stats,
+        size_t num_links,
+        size_t num_nius,
+        bool record_timeline) :
+        record_timeline(record_timeline) {
+        // devices without their own stats entry still contribute to mesh stats
+        boost::unordered_flat_map<DeviceID, size_t> device_slot;
+        for (auto device_id : device_model.getDeviceIDs()) {
+            auto it = stats.per_device_stats.find(device_id);
+            device_slot[device_id] = device_blocks.size();
+            device_blocks.push_back({it != stats.per_device_stats.end() ? &it->second : nullptr});
+        }
+        mesh_stats = &stats.per_device_stats.at(MESH_DEVICE);
+
+        // each device's links and NIUs must be laid out densely (see denseResourceID)
+        auto find_device_blocks = [&](size_t num_ids, auto get_device_id, auto get_type_index,
+                                      size_t DeviceBlock::*begin, size_t DeviceBlock::*end) {
+            for (size_t id = 0; id < num_ids; id++) {
+                auto &block = device_blocks[device_slot.at(get_device_id(id))];
+                if (block.*begin == block.*end) {
+                    block.*begin = id;
+                    block.*end = id;
+                }
+                TT_ASSERT(
+                    block.*end == id && get_type_index(id) == id % DemandReduction::NUM_TYPES,
+                    "Link/NIU {} is not laid out densely",
+                    id);
+                block.*end = id + 1;
+            }
+        };
+        find_device_blocks(
+            num_links,
+            [&](size_t id) { return device_model.getLinkAttributes(id).coord.device_id; },
+            [&](size_t id) { return denseLinkTypeIndex(device_model.getLinkAttributes(id).type); },
+            &DeviceBlock::link_begin,
+            &DeviceBlock::link_end);
+        find_device_blocks(
+            num_nius,
+            [&](size_t id) { return device_model.getNIUAttributes(id).coord.device_id; },
+            [&](size_t id) { return denseNIUTypeIndex(device_model.getNIUAttributes(id).type); },
+            &DeviceBlock::niu_begin,
+            &DeviceBlock::niu_end);
+    }
+
+    npeStats::deviceStats *mesh_stats = nullptr;
+    std::vector<DeviceBlock> device_blocks;
+    // record per-timestep timeline data (only needed for timeline output)
+    bool record_timeline = false;
+};
+
 inline void updateSimulationStats(
     const npeDeviceModel &device_model,
+    const SimulationStatsLookup &lookup,
     const LinkDemandGrid &link_demand_grid,
     const LinkDemandGrid &multicast_write_link_demand_grid,
-    const NIUDemandGrid &niu_demand_grid,
-    std::vector<int> &live_transfer_ids,
-    npeStats &stats) {
+    const NIUDemandGrid &niu_demand_grid) {
     float max_link_bandwidth = device_model.getLinkBandwidth(nocLinkID(0));
-    for (auto& [device_id, deviceStats]: stats.per_device_stats) { 
+    constexpr size_t NOC0_EAST = denseLinkTypeIndex(nocLinkType::NOC0_EAST);
+    constexpr size_t NOC0_SOUTH = denseLinkTypeIndex(nocLinkType::NOC0_SOUTH);
+    constexpr size_t NOC1_NORTH = denseLinkTypeIndex(nocLinkType::NOC1_NORTH);
+    constexpr size_t NOC1_WEST = denseLinkTypeIndex(nocLinkType::NOC1_WEST);
+
+    auto record_stats = [&](npeStats::deviceStats &deviceStats,
+                            const DemandReduction &link_reduction,
+                            const DemandReduction &niu_reduction,
+                            bool is_mesh) {
         if (deviceStats.per_timestep_stats.empty()) {
-            continue;
+            return;
         }
         TimestepStats &sim_stats = deviceStats.per_timestep_stats.back();
+        const auto &r = link_reduction;
 
         // Compute link demand and util
-        for (const auto &[link_id, link_demand] : enumerate(link_demand_grid)) {
-            nocLinkAttr link_attr = device_model.getLinkAttributes(link_id);
-            if (device_id == MESH_DEVICE || device_id == link_attr.coord.device_id) {
-                auto multicast_write_link_demand = multicast_write_link_demand_grid[link_id];
-                sim_stats.avg_link_demand += link_demand;
-                sim_stats.avg_link_util += std::fmin(link_demand, max_link_bandwidth);
-                sim_stats.avg_mcast_write_link_util +=
-                    std::fmin(multicast_write_link_demand, max_link_bandwidth);
-                sim_stats.max_link_demand = std::fmax(sim_stats.max_link_demand, link_demand);
-                if (link_attr.type == nocLinkType::NOC0_EAST || link_attr.type == nocLinkType::NOC0_SOUTH) {
-                    sim_stats.avg_noc0_link_demand += link_demand;
-                    sim_stats.avg_noc0_link_util += std::fmin(link_demand, max_link_bandwidth);
-                    sim_stats.max_noc0_link_demand = std::fmax(sim_stats.max_noc0_link_demand, link_demand);
-                } else if (
-                    link_attr.type == nocLinkType::NOC1_NORTH || link_attr.type == nocLinkType::NOC1_WEST) {
-                    sim_stats.avg_noc1_link_demand += link_demand;
-                    sim_stats.avg_noc1_link_util += std::fmin(link_demand, max_link_bandwidth);
-                    sim_stats.max_noc1_link_demand = std::fmax(sim_stats.max_noc1_link_demand, link_demand);
-                }
-            }
-        }
-
-        size_t link_demand_grid_size = device_id == MESH_DEVICE ? link_demand_grid.size() : link_demand_grid.size() / device_model.getNumChips();
+        sim_stats.avg_link_demand = r.totalDemand();
+        sim_stats.avg_link_util = r.totalUtil();
+        sim_stats.avg_mcast_write_link_util = r.totalMcastWriteUtil();
+        sim_stats.max_link_demand = r.maxDemand();
+        sim_stats.avg_noc0_link_demand = r.demand_sum[NOC0_EAST] + r.demand_sum[NOC0_SOUTH];
+        sim_stats.avg_noc0_link_util = r.util_sum[NOC0_EAST] + r.util_sum[NOC0_SOUTH];
+        sim_stats.max_noc0_link_demand = std::fmax(r.max_demand[NOC0_EAST], r.max_demand[NOC0_SOUTH]);
+        sim_stats.avg_noc1_link_demand = r.demand_sum[NOC1_NORTH] + r.demand_sum[NOC1_WEST];
+        sim_stats.avg_noc1_link_util = r.util_sum[NOC1_NORTH] + r.util_sum[NOC1_WEST];
+        sim_stats.max_noc1_link_demand = std::fmax(r.max_demand[NOC1_NORTH], r.max_demand[NOC1_WEST]);
+
+        size_t link_demand_grid_size = is_mesh ? link_demand_grid.size() : link_demand_grid.size() / device_model.getNumChips();
         sim_stats.avg_link_demand *= 100. / (max_link_bandwidth * link_demand_grid_size);
         sim_stats.avg_link_util *= 100. / (max_link_bandwidth * link_demand_grid_size);
         sim_stats.avg_mcast_write_link_util *= 100. / (max_link_bandwidth * link_demand_grid_size);
@@ -118,25 +212,37 @@ inline void updateSimulationStats(
         sim_stats.max_noc1_link_demand *= 100. / max_link_bandwidth;
 
         // Compute NIU demand and util
-        for (const auto &[niu_id, niu_demand] : enumerate(niu_demand_grid)) {
-            auto niu_attr = device_model.getNIUAttributes(niu_id);
-            if (device_id == MESH_DEVICE || device_id == niu_attr.coord.device_id) {
-                sim_stats.avg_niu_demand += niu_demand;
-                sim_stats.max_niu_demand = std::fmax(sim_stats.max_niu_demand, niu_demand);
-            }
-        }
         // Hack: LINK_BANDWIDTH is not always a good approximation of NIU bandwidth
-        size_t niu_demand_grid_size = device_id == MESH_DEVICE ? niu_demand_grid.size() : niu_demand_grid.size() / device_model.getNumChips();
+        sim_stats.avg_niu_demand = niu_reduction.totalDemand();
+        sim_stats.max_niu_demand = niu_reduction.maxDemand();
         sim_stats.avg_niu_demand *= 100. / (max_link_bandwidth * niu_demand_grid.size());
         sim_stats.max_niu_demand *= 100. / max_link_bandwidth;
 
-        // NOTE: copying these is a 10% runtime overhead, so disable these for per device stats
-        if (device_id == MESH_DEVICE) {
-            sim_stats.link_demand_grid = link_demand_grid;
-            sim_stats.niu_demand_grid = niu_demand_grid;
-            sim_stats.live_transfer_ids = live_transfer_ids;
+        // timeline data is only kept for the whole mesh
+        if (is_mesh && lookup.record_timeline) {
+            sim_stats.recordTimelineData(link_demand_grid, niu_demand_grid);
+        }
+    };
+
+    // reduce each device's block of the grids, then combine for the whole mesh
+    std::span<const float> links(link_demand_grid), mcast_write_links(multicast_write_link_demand_grid);
+    std::span<const float> nius(niu_demand_grid);
+    DemandReduction mesh_link_reduction, mesh_niu_reduction;
+    for (const auto &block : lookup.device_blocks) {
+        size_t num_links = block.link_end - block.link_begin;
+        auto link_reduction = reduceLinkDemand(
+            links.subspan(block.link_begin, num_links),
+            mcast_write_links.subspan(block.link_begin, num_links),
+            max_link_bandwidth);
+        auto niu_reduction =
+            reduceNIUDemand(nius.subspan(block.niu_begin, block.niu_end - block.niu_begin));
+        if (block.stats) {
+            record_stats(*block.stats, link_reduction, niu_reduction, false);
         }
+        mesh_link_reduction.merge(link_reduction);
+        mesh_niu_reduction.merge(niu_reduction);
     }
+    record_stats(*lookup.mesh_stats, mesh_link_reduction, mesh_niu_reduction, true);
 }
 
 }  // namespace tt_npe
@@ -3,8 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+
 #include "grid.hpp"
+#include "npeAssert.hpp"
 #include "npeDeviceTypes.hpp"
+#include "npeTransferState.hpp"
 
 namespace tt_npe {
 
@@ -15,8 +20,12 @@ public:
     npeDeviceState(size_t num_nius, size_t num_links) :
         niu_demand_grid(num_nius, 0.0f),
         link_demand_grid(num_links, 0.0f),
-        multicast_write_link_demand_grid(num_links, 0.0f) {}
-    
+        multicast_write_link_demand_grid(num_links, 0.0f),
+        niu_transfers(num_nius),
+        link_transfers(num_links),
+        niu_is_stale(num_nius, false),
+        link_is_stale(num_links, false) {}
+
     // Reset all demand grids to zero
     void reset() {
         std::fill(niu_demand_grid.begin(), niu_demand_grid.end(), 0.0f);
@@ -25,23 +34,205 @@ public:
             multicast_write_link_demand_grid.begin(),
             multicast_write_link_demand_grid.end(),
             0.0f);
+        for (auto &ltids : niu_transfers) {
+            ltids.clear();
+        }
+        for (auto &ltids : link_transfers) {
+            ltids.clear();
+        }
+        std::fill(niu_is_stale.begin(), niu_is_stale.end(), false);
+        std::fill(link_is_stale.begin(), link_is_stale.end(), false);
+        is_accumulated.clear();
+        transfer_live_generation.clear();
+        accumulated_transfer_ids.clear();
+        partial_transfer_ids.clear();
+        stale_niu_ids.clear();
+        stale_link_ids.clear();
+        live_generation = 0;
     }
-    
+
+    // Brings the demand grids up to date with the set of live transfers for
+    // the timestep [start_timestep, end_timestep). Each grid entry is the
+    // float sum of the effective demand of every live transfer loading that
+    // resource, added in live_transfer_ids order; transfers starting mid-way
+    // into the timestep are derated by the fraction of the timestep they are
+    // active for.
+    //
+    // Rather than re-summing every entry each timestep, the live transfers
+    // loading each resource are kept in live order. Newly live transfers are
+    // always appended to the end of live_transfer_ids, so their demand can be
+    // added to the current sum directly. Only resources loaded by transfers
+    // that have completed, or whose demand changed since the previous
+    // timestep, are re-summed from scratch. This produces exactly the same
+    // grids as a full recompute, at a cost proportional to the number of
+    // started/finished transfers rather than all live transfers.
+    //
+    // Multicast write link demand is only tracked if track_multicast_write_demand is set.
+    void updateDemandGrids(
+        Cycle start_timestep,
+        Cycle end_timestep,
+        const PETransferHotState &transfers,
+        const std::vector<PETransferID> &live_transfer_ids,
+        bool track_multicast_write_demand = true) {
+        if (is_accumulated.size() < transfers.size()) {
+            is_accumulated.resize(transfers.size(), false);
+            transfer_live_generation.resize(transfers.size(), 0);
+        }
+        live_generation++;
+        for (auto ltid : live_transfer_ids) {
+            transfer_live_generation[ltid] = live_generation;
+        }
+
+        // demand of completed transfers must be removed, and transfers that
+        // started mid-way into the previous timestep now contribute a
+        // different fraction of their demand
+        std::erase_if(accumulated_transfer_ids, [&](PETransferID ltid) {
+            if (isLive(ltid)) {
+                return false;
+            }
+            markTransferResourcesStale(transfers, ltid);
+            is_accumulated[ltid] = false;
+            return true;
+        });
+        std::erase_if(partial_transfer_ids, [&](PETransferID ltid) {
+            markTransferResourcesStale(transfers, ltid);
+            return !isLive(ltid) || transfers.start_cycle[ltid] <= start_timestep;
+        });
+
+        // add demand of newly live transfers
+        for (auto ltid : live_transfer_ids) {
+            if (is_accumulated[ltid]) {
+                continue;
+            }
+            is_accumulated[ltid] = true;
+            accumulated_transfer_ids.push_back(ltid);
+            if (transfers.start_cycle[ltid] > start_timestep) {
+                partial_transfer_ids.push_back(ltid);
+            }
+
+            float effective_demand =
+                getEffectiveDemand(start_timestep, end_timestep, transfers, ltid);
+            const bool is_multicast_write =
+                track_multicast_write_demand && transfers.is_multicast_write[ltid];
+            auto add_niu_demand = [&](nocNIUID niu_id) {
+                niu_transfers[niu_id].push_back(ltid);
+                if (!niu_is_stale[niu_id]) {
+                    niu_demand_grid[niu_id] += effective_demand;
+                }
+            };
+            add_niu_demand(transfers.src_niu_id[ltid]);
+            for (auto niu_id : transfers.getSinkNIUIDs(ltid)) {
+                add_niu_demand(niu_id);
+            }
+            for (auto link_id : transfers.route[ltid]) {
+                link_transfers[link_id].push_back(ltid);
+                if (!link_is_stale[link_id]) {
+                    link_demand_grid[link_id] += effective_demand;
+                    if (is_multicast_write) {
+                        multicast_write_link_demand_grid[link_id] += effective_demand;
+                    }
+                }
+            }
+        }
+
+        // re-sum stale resources over the transfers still loading them
+        for (auto niu_id : stale_niu_ids) {
+            auto &ltids = niu_transfers[niu_id];
+            std::erase_if(ltids, [&](PETransferID ltid) { return !isLive(ltid); });
+            float demand = 0.0f;
+            for (auto ltid : ltids) {
+                demand += getEffectiveDemand(start_timestep, end_timestep, transfers, ltid);
+            }
+            niu_demand_grid[niu_id] = demand;
+            niu_is_stale[niu_id] = false;
+        }
+        for (auto link_id : stale_link_ids) {
+            auto &ltids = link_transfers[link_id];
+            std::erase_if(ltids, [&](PETransferID ltid) { return !isLive(ltid); });
+            float demand = 0.0f;
+            float multicast_write_demand = 0.0f;
+            for (auto ltid : ltids) {
+                float effective_demand =
+                    getEffectiveDemand(start_timestep, end_timestep, transfers, ltid);
+                demand += effective_demand;
+                if (track_multicast_write_demand && transfers.is_multicast_write[ltid]) {
+                    multicast_write_demand += effective_demand;
+                }
+            }
+            link_demand_grid[link_id] = demand;
+            multicast_write_link_demand_grid[link_id] = multicast_write_demand;
+            link_is_stale[link_id] = false;
+        }
+        stale_niu_ids.clear();
+        stale_link_ids.clear();
+    }
+
     // Accessors
     NIUDemandGrid& getNIUDemandGrid() { return niu_demand_grid; }
     LinkDemandGrid& getLinkDemandGrid() { return link_demand_grid; }
     LinkDemandGrid& getMulticastWriteLinkDemandGrid() { return multicast_write_link_demand_grid; }
-    
+
     const NIUDemandGrid& getNIUDemandGrid() const { return niu_demand_grid; }
     const LinkDemandGrid& getLinkDemandGrid() const { return link_demand_grid; }
     const LinkDemandGrid& getMulticastWriteLinkDemandGrid() const {
         return multicast_write_link_demand_grid;
     }
-    
+
 private:
+    bool isLive(PETransferID ltid) const {
+        return transfer_live_generation[ltid] == live_generation;
+    }
+
+    // demand of transfer ltid over the timestep, derated by the fraction of
+    // the timestep it is active for if it starts mid-way into the timestep
+    static float getEffectiveDemand(
+        Cycle start_timestep,
+        Cycle end_timestep,
+        const PETransferHotState &transfers,
+        PETransferID ltid) {
+        Cycle cycles_per_timestep = end_timestep - start_timestep;
+        Cycle predicted_start = std::max(start_timestep, transfers.start_cycle[ltid]);
+        float effective_demand =
+            float(end_timestep - predicted_start) / float(cycles_per_timestep);
+        effective_demand *= transfers.curr_bandwidth[ltid];
+        return effective_demand;
+    }
+
+    void markTransferResourcesStale(const PETransferHotState &transfers, PETransferID ltid) {
+        auto mark_niu_stale = [this](nocNIUID niu_id) {
+            if (!niu_is_stale[niu_id]) {
+                niu_is_stale[niu_id] = true;
+                stale_niu_ids.push_back(niu_id);
+            }
+        };
+        mark_niu_stale(transfers.src_niu_id[ltid]);
+        for (auto niu_id : transfers.getSinkNIUIDs(ltid)) {
+            mark_niu_stale(niu_id);
+        }
+        for (auto link_id : transfers.route[ltid]) {
+            if (!link_is_stale[link_id]) {
+                link_is_stale[link_id] = true;
+                stale_link_ids.push_back(link_id);
+            }
+        }
+    }
+
     NIUDemandGrid niu_demand_grid;
     LinkDemandGrid link_demand_grid;
     LinkDemandGrid multicast_write_link_demand_grid;
+
+    // bookkeeping for incremental demand grid updates; see updateDemandGrids()
+    std::vector<std::vector<PETransferID>> niu_transfers;
+    std::vector<std::vector<PETransferID>> link_transfers;
+    std::vector<uint8_t> niu_is_stale;
+    std::vector<uint8_t> link_is_stale;
+    std::vector<uint8_t> is_accumulated;
+    std::vector<uint32_t> transfer_live_generation;
+    std::vector<PETransferID> accumulated_transfer_ids;
+    std::vector<PETransferID> partial_transfer_ids;
+    std::vector<nocNIUID> stale_niu_ids;
+    std::vector<nocLinkID> stale_link_ids;
+    uint32_t live_generation = 0;
 };
 
 } // namespace tt_npe
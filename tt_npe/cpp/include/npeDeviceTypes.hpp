@@ -47,6 +47,47 @@ struct nocNIUAttr {
     }
 };
 
+// Link and NIU IDs are laid out densely by every device model, in
+// (device, row, col, type) order with types ordered as returned by
+// getLinkTypes()/getNIUTypes(). This allows IDs to be computed in closed form
+// rather than looked up.
+constexpr size_t NUM_DENSE_LINK_TYPES = 4;
+constexpr size_t NUM_DENSE_NIU_TYPES = 4;
+
+// returns position of link type within a coordinate's block of link IDs
+constexpr size_t denseLinkTypeIndex(nocLinkType type) {
+    switch (type) {
+        case nocLinkType::NOC0_EAST: return 0;
+        case nocLinkType::NOC0_SOUTH: return 1;
+        case nocLinkType::NOC1_NORTH: return 2;
+        case nocLinkType::NOC1_WEST: return 3;
+    }
+    return NUM_DENSE_LINK_TYPES;
+}
+
+// returns position of NIU type within a coordinate's block of NIU IDs, or
+// NUM_DENSE_NIU_TYPES if NIU type is not modelled
+constexpr size_t denseNIUTypeIndex(nocNIUType type) {
+    switch (type) {
+        case nocNIUType::NOC0_SRC: return 0;
+        case nocNIUType::NOC0_SINK: return 1;
+        case nocNIUType::NOC1_SRC: return 2;
+        case nocNIUType::NOC1_SINK: return 3;
+        default: return NUM_DENSE_NIU_TYPES;
+    }
+}
+
+constexpr size_t denseResourceID(
+    size_t device_id,
+    size_t row,
+    size_t col,
+    size_t type_index,
+    size_t num_rows,
+    size_t num_cols,
+    size_t num_types) {
+    return ((device_id * num_rows + row) * num_cols + col) * num_types + type_index;
+}
+
 using CoordToCoreTypeMapping = boost::unordered_flat_map<Coord, CoreType>;
 using DramCoordToControllerMapping = boost::unordered_flat_map<Coord, uint32_t>;
 using CoreTypeToInjectionRate = boost::unordered_flat_map<CoreType, BytesPerCycle>;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <boost/container/small_vector.hpp>
+#include <optional>
 
 #include "grid.hpp"
 #include "npeCommon.hpp"
@@ -12,6 +13,7 @@
 #include "npeDeviceModelIface.hpp"
 #include "npeDeviceState.hpp"
 #include "npeResult.hpp"
+#include "npeRouteArena.hpp"
 #include "npeTransferState.hpp"
 #include "npeWorkload.hpp"
 
@@ -33,23 +35,25 @@ class npeEngine {
     bool validateConfig(const npeConfig &cfg) const;
 
    private:
-    // used to sort transfers by start time
-    struct TransferQueuePair {
-        Cycle start_cycle;
-        PETransferID id;
-    };
-
     // run single simulator run
     npeResult runSinglePerfSim(const npeWorkload &wl, const npeConfig &cfg) const;
 
-    std::vector<PETransferState> initTransferState(const npeWorkload &wl) const;
-
-    std::vector<TransferQueuePair> createTransferQueue(
-        const std::vector<PETransferState> &transfer_state) const;
+    std::vector<PETransferState> initTransferState(
+        const npeWorkload &wl, nocRouteArena &route_arena) const;
 
     npeTransferDependencyTracker genDependencies(
         std::vector<PETransferState> &transfer_state) const;
 
+    // returns number of upcoming timesteps guaranteed to exactly repeat the
+    // timestep that just ended (same live transfers, bandwidths and progress)
+    Timestep getNumSteadyStateTimesteps(
+        const PETransferHotState &transfer_state,
+        const std::vector<PETransferID> &live_transfer_ids,
+        npeTransferDependencyTracker &dep_tracker,
+        std::optional<Cycle> next_activation_cycle,
+        Cycle curr_cycle,
+        Cycle cycles_per_timestep) const;
+
     float interpolateBW(
         const TransferBandwidthTable &tbt,
         float max_transfer_bw,
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "npeCommon.hpp"
+#include "npeNocTraceReader.hpp"
+
+namespace tt_npe {
+
+enum class FabricConfig { FABRIC_1D, FABRIC_1D_RING, FABRIC_2D, FABRIC_2D_TORUS, DISABLED };
+
+enum class RoutingDirection { N, S, E, W };
+
+// The ethernet fabric of a multichip cluster, as described by the
+// topology.json that tt-metal writes alongside per-device noc traces.
+//
+// The fabric send events of per-device traces only record how the send was
+// routed on its source device (the ethernet channel and hop counts). The path
+// of a send across devices is elaborated from the topology, following the
+// same routing as the fabric post-processing of tt-npe's Python tools.
+class npeFabricTopology {
+   public:
+    FabricConfig getFabricConfig() const { return fabric_config; }
+    const std::string &getClusterType() const { return cluster_type; }
+
+    // Elaborates the path of a fabric send event from its routing, replacing
+    // any path it has; segments are appended to batch.fabric_routes, and
+    // dst_device_id is set to the device the send terminates on. Throws
+    // npeException if the routing can not be followed through the topology.
+    void elaborateFabricPath(NocTraceEvent &event, NocTraceEventBatch &batch) const;
+
+    // reads a topology.json (which may contain comments); returns std::nullopt
+    // (and logs the error) if it can not be read or is not supported
+    static std::optional<npeFabricTopology> readFromFile(const std::string &filepath);
+
+   private:
+    // (mesh id, chip id within the mesh)
+    using FabricNodeID = std::pair<int64_t, int64_t>;
+    using Coord2D = std::pair<int64_t, int64_t>;
+
+    // state of a path being elaborated
+    struct PathBuilder {
+        NocTraceEvent &event;
+        NocTraceEventBatch &batch;
+        int64_t routing_plane_id;
+        // direction of the first hop between devices
+        RoutingDirection initial_direction;
+        int64_t device;
+        // ethernet core that received the send on device
+        Coord2D receiver_coord;
+    };
+
+    int64_t getEthChannel(int64_t device, int64_t routing_plane_id, RoutingDirection direction) const;
+    Coord2D getEthCoord(int64_t eth_chan) const;
+    std::pair<int64_t, RoutingDirection> getNextDeviceInDir(int64_t device, RoutingDirection direction) const;
+    PathBuilder startPath(NocTraceEvent &event, NocTraceEventBatch &batch) const;
+    void addHops(
+        PathBuilder &path,
+        int64_t start_distance,
+        int64_t range_devices,
+        RoutingDirection direction,
+        bool terminate,
+        int64_t parent_id) const;
+    void elaborateFabricPath1D(NocTraceEvent &event, NocTraceEventBatch &batch) const;
+    void elaborateFabricPath2D(NocTraceEvent &event, NocTraceEventBatch &batch) const;
+
+    FabricConfig fabric_config = FabricConfig::DISABLED;
+    std::string cluster_type;
+    // (ns_dim, ew_dim) of each mesh
+    boost::unordered_flat_map<int64_t, std::pair<int64_t, int64_t>> mesh_shapes;
+    // ethernet channel of each (device, routing plane, direction)
+    boost::unordered_flat_map<std::tuple<int64_t, int64_t, RoutingDirection>, int64_t> routing_planes;
+    // (routing plane, direction) of each (device, ethernet channel)
+    boost::unordered_flat_map<std::pair<int64_t, int64_t>, std::pair<int64_t, RoutingDirection>>
+        eth_chan_routing_planes;
+    boost::unordered_flat_map<int64_t, FabricNodeID> device_id_to_fabric_node_id;
+    boost::unordered_flat_map<FabricNodeID, int64_t> fabric_node_id_to_device_id;
+    boost::unordered_flat_map<int64_t, Coord2D> eth_chan_to_coord;
+};
+
+}  // namespace tt_npe
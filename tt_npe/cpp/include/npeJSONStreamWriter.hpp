@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "npeAssert.hpp"
+
+namespace tt_npe {
+
+// Writes a JSON document to a stream incrementally, so large documents never
+// need to be held in memory as a nlohmann::json tree. Containers are opened
+// and closed explicitly; leaf values (which may themselves be small nlohmann
+// trees) are dumped in place.
+//
+// Output is formatted exactly as nlohmann::json::dump(indent) formats the
+// equivalent tree, provided object keys are written in sorted order.
+class JSONStreamWriter {
+   public:
+    // indent < 0 produces compact output, as with nlohmann::json::dump()
+    explicit JSONStreamWriter(std::ostream &os, int indent = -1) : os(os), indent(indent) {}
+    JSONStreamWriter(const JSONStreamWriter &) = delete;
+    JSONStreamWriter &operator=(const JSONStreamWriter &) = delete;
+    ~JSONStreamWriter() { flush(); }
+
+    void beginObject() { beginContainer('{', true); }
+    void endObject() { endContainer('}', true); }
+    void beginArray() { beginContainer('[', false); }
+    void endArray() { endContainer(']', false); }
+
+    // sets the key of the next value or container; only valid within an object
+    void key(std::string_view key) {
+        TT_ASSERT(!scopes.empty() && scopes.back().is_object && !key_pending);
+        separate();
+        buffer += nlohmann::json(key).dump();
+        buffer += indent >= 0 ? ": " : ":";
+        key_pending = true;
+    }
+
+    template <typename BasicJsonType>
+    void value(const BasicJsonType &value) {
+        beginValue();
+        std::string dumped = value.dump(indent);
+        if (indent > 0 && !scopes.empty()) {
+            // nested values are indented relative to their enclosing container
+            std::string prefix = "\n" + std::string(scopes.size() * indent, ' ');
+            for (char c : dumped) {
+                if (c == '\n') {
+                    buffer += prefix;
+                } else {
+                    buffer += c;
+                }
+            }
+        } else {
+            buffer += dumped;
+        }
+        flushIfFull();
+    }
+
+    void flush() {
+        os.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+   private:
+    struct Scope {
+        bool is_object;
+        bool empty = true;
+    };
+
+    // emits the separator and indentation preceding an array element
+    void separate() {
+        auto &scope = scopes.back();
+        if (!scope.empty) {
+            buffer += ',';
+        }
+        scope.empty = false;
+        newline(scopes.size());
+    }
+
+    void beginValue() {
+        if (scopes.empty()) {
+            return;
+        }
+        if (scopes.back().is_object) {
+            TT_ASSERT(key_pending, "Values within a JSON object must be preceded by a key");
+            key_pending = false;
+        } else {
+            separate();
+        }
+    }
+
+    void beginContainer(char open, bool is_object) {
+        beginValue();
+        buffer += open;
+        scopes.push_back({is_object});
+    }
+
+    void endContainer(char close, bool is_object) {
+        TT_ASSERT(!scopes.empty() && scopes.back().is_object == is_object && !key_pending);
+        bool empty = scopes.back().empty;
+        scopes.pop_back();
+        if (!empty) {
+            newline(scopes.size());
+        }
+        buffer += close;
+        flushIfFull();
+    }
+
+    void newline(size_t depth) {
+        if (indent >= 0) {
+            buffer += '\n';
+            buffer.append(depth * indent, ' ');
+        }
+    }
+
+    void flushIfFull() {
+        if (buffer.size() >= FLUSH_THRESHOLD) {
+            flush();
+        }
+    }
+
+    static constexpr size_t FLUSH_THRESHOLD = 1 << 20;
+
+    std::ostream &os;
+    int indent;
+    std::string buffer;
+    std::vector<Scope> scopes;
+    bool key_pending = false;
+};
+
+}  // namespace tt_npe
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "npeCommon.hpp"
+#include "npeTransferState.hpp"
+
+namespace tt_npe {
+
+// Index over the live interval [live_start_cycle, live_end_cycle) of every
+// transfer, used to reconstruct which transfers were active during each
+// recorded timestep without storing per-timestep transfer lists.
+//
+// Queries are answered by a sweep: while successive queries move forward in
+// time, the total cost is linear in the number of transfers plus the size of
+// the results. A query that moves backwards restarts the sweep.
+class TransferLivenessIndex {
+   public:
+    // NOTE: transfer_state must outlive this object
+    explicit TransferLivenessIndex(const std::vector<PETransferState> &transfer_state) :
+        transfer_state(transfer_state) {
+        by_live_start.reserve(transfer_state.size());
+        for (PETransferID id = 0; id < PETransferID(transfer_state.size()); id++) {
+            const auto &tr = transfer_state[id];
+            if (tr.live_end_cycle > tr.live_start_cycle) {
+                by_live_start.push_back(id);
+            }
+        }
+        std::stable_sort(by_live_start.begin(), by_live_start.end(), [&](auto lhs, auto rhs) {
+            return transfer_state[lhs].live_start_cycle < transfer_state[rhs].live_start_cycle;
+        });
+    }
+
+    // returns transfers live at any point in [start_cycle, end_cycle), in no particular order
+    const std::vector<PETransferID> &liveDuring(Cycle start_cycle, Cycle end_cycle) {
+        if (end_cycle <= start_cycle) {
+            return none;
+        }
+        if (start_cycle < prev_start_cycle || end_cycle < prev_end_cycle) {
+            next = 0;
+            active.clear();
+        }
+        prev_start_cycle = start_cycle;
+        prev_end_cycle = end_cycle;
+
+        while (next < by_live_start.size() &&
+               transfer_state[by_live_start[next]].live_start_cycle < end_cycle) {
+            active.push_back(by_live_start[next++]);
+        }
+        std::erase_if(active, [&](PETransferID id) {
+            return transfer_state[id].live_end_cycle <= start_cycle;
+        });
+        return active;
+    }
+
+   private:
+    const std::vector<PETransferState> &transfer_state;
+    std::vector<PETransferID> by_live_start;
+
+    // sweep state
+    size_t next = 0;
+    std::vector<PETransferID> active;
+    const std::vector<PETransferID> none;
+    Cycle prev_start_cycle = 0;
+    Cycle prev_end_cycle = 0;
+};
+
+}  // namespace tt_npe
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "npeCommon.hpp"
+#include "simdjson.h"
+
+namespace tt_npe {
+
+// Routing of a fabric send event as recorded on its source device, before its
+// path is elaborated from the fabric topology (see npeFabricTopology). Fields
+// missing from the event are std::nullopt.
+struct NocTraceFabricRouting {
+    std::optional<int64_t> eth_chan;
+    // 1D fabric routing
+    std::optional<int64_t> start_distance;
+    std::optional<int64_t> range;
+    // 2D fabric routing
+    std::optional<int64_t> ns_hops;
+    std::optional<int64_t> e_hops;
+    std::optional<int64_t> w_hops;
+    std::optional<bool> is_mcast;
+
+    // set if the send is routed through a fabric mux core
+    bool has_fabric_mux = false;
+    int64_t fabric_mux_x = -1;
+    int64_t fabric_mux_y = -1;
+    std::string_view fabric_mux_noc;
+};
+
+// Fields of a tt-metal noc trace event, as read by npeNocTraceReader. Fields
+// that are missing from the event (or have the wrong type) keep the defaults
+// below. Strings refer to the reader's parse buffers, and are only valid until
+// the next batch is read.
+struct NocTraceEvent {
+    std::string_view proc;
+    std::string_view type;
+    std::string_view noc;
+    std::string_view zone;
+    std::string_view zone_phase;
+    int64_t num_bytes = 0;
+    int64_t sx = -1;
+    int64_t sy = -1;
+    int64_t dx = -1;
+    int64_t dy = -1;
+    int64_t src_device_id = 0;
+    std::optional<int64_t> dst_device_id;
+    Cycle timestamp = 0;
+    int64_t mcast_start_x = -1;
+    int64_t mcast_start_y = -1;
+    int64_t mcast_end_x = -1;
+    int64_t mcast_end_y = -1;
+
+    // set if the event has a "fabric_send" object; its path segments are
+    // [fabric_routes_begin, fabric_routes_end) of the batch's fabric_routes
+    bool has_fabric_send = false;
+    uint32_t fabric_routes_begin = 0;
+    uint32_t fabric_routes_end = 0;
+    NocTraceFabricRouting fabric_routing;
+
+    // set if the event has a "dst" array of the writes a fabric send makes on
+    // its destination devices; they are [dst_begin, dst_end) of the batch's
+    // local_writes
+    bool has_dst = false;
+    uint32_t dst_begin = 0;
+    uint32_t dst_end = 0;
+};
+
+// A segment of the path of a fabric send event
+struct NocTraceFabricRoute {
+    std::string_view noc;
+    int64_t device = -1;
+    int64_t segment_start_x = -1;
+    int64_t segment_start_y = -1;
+    int64_t forward_x = -1;
+    int64_t forward_y = -1;
+    int64_t parent_id = -1;
+
+    // set if the segment has a "local_writes" array; its writes are
+    // [local_writes_begin, local_writes_end) of the batch's local_writes
+    bool has_local_writes = false;
+    uint32_t local_writes_begin = 0;
+    uint32_t local_writes_end = 0;
+};
+
+// A write to a worker core local to a fabric route segment
+struct NocTraceLocalWrite {
+    int64_t dx = -1;
+    int64_t dy = -1;
+    int64_t num_bytes = -1;
+};
+
+// Events read from a noc trace by one call to npeNocTraceReader::readBatch(),
+// in document order. Nested fabric send data is stored in flat arrays
+// referenced by index ranges, so the batch can be reused without reallocating.
+struct NocTraceEventBatch {
+    std::vector<NocTraceEvent> events;
+    std::vector<NocTraceFabricRoute> fabric_routes;
+    std::vector<NocTraceLocalWrite> local_writes;
+
+    void clear() {
+        events.clear();
+        fabric_routes.clear();
+        local_writes.clear();
+    }
+
+    std::span<const NocTraceFabricRoute> getFabricRoutes(const NocTraceEvent &event) const {
+        return std::span(fabric_routes).subspan(
+            event.fabric_routes_begin, event.fabric_routes_end - event.fabric_routes_begin);
+    }
+    std::span<const NocTraceLocalWrite> getLocalWrites(const NocTraceFabricRoute &route) const {
+        return std::span(local_writes).subspan(
+            route.local_writes_begin, route.local_writes_end - route.local_writes_begin);
+    }
+    std::span<const NocTraceLocalWrite> getDstWrites(const NocTraceEvent &event) const {
+        return std::span(local_writes).subspan(event.dst_begin, event.dst_end - event.dst_begin);
+    }
+};
+
+// The JSON of a run of complete events read by npeNocTraceReader::readChunk().
+// A chunk owns its data, so it can be decoded independently of the reader
+// (e.g. on another thread) with npeNocTraceReader::decodeChunk().
+struct NocTraceChunk {
+    // JSON array of the events, followed by the padding simdjson requires
+    std::vector<char> json;
+    // bytes of json before the padding
+    size_t size = 0;
+};
+
+// Streams the events of a tt-metal noc trace file (a JSON array of event
+// objects) in document order, without building a DOM for the whole trace.
+//
+// The file is read in windows of window_size bytes. The complete events in
+// each window are parsed with the simdjson On-Demand API, visiting the fields
+// of each event once, in the order they appear. Memory use is bounded by the
+// window size (which only grows if a single event does not fit in it) rather
+// than the size of the trace.
+class npeNocTraceReader {
+   public:
+    static constexpr size_t DEFAULT_WINDOW_SIZE = 16 << 20;
+
+    explicit npeNocTraceReader(const std::string &filepath, size_t window_size = DEFAULT_WINDOW_SIZE);
+
+    // Reads the next batch of events into batch. Returns false once all events
+    // have been read, or if the trace could not be read (see hasFailed()).
+    bool readBatch(NocTraceEventBatch &batch);
+
+    // Reads the next run of complete events into chunk without decoding them.
+    // Returns false once all events have been read, or if the trace could not
+    // be read (see hasFailed()).
+    bool readChunk(NocTraceChunk &chunk);
+
+    // Decodes the events of chunk into batch with chunk_parser; safe to call
+    // concurrently with distinct parsers. Returns false (and logs the error) if
+    // the chunk is not valid JSON. Does not affect hasFailed().
+    bool decodeChunk(
+        const NocTraceChunk &chunk, simdjson::ondemand::parser &chunk_parser, NocTraceEventBatch &batch) const;
+
+    // true if reading failed; the error has been logged
+    bool hasFailed() const { return failed; }
+
+   private:
+    bool nextEvents(size_t &begin, size_t &end);
+    void scan();
+    bool refill();
+    void logError(std::string_view error) const;
+    void fail(std::string_view error);
+
+    static constexpr size_t NO_SEPARATOR = size_t(-1);
+
+    std::string filepath;
+    std::ifstream file;
+    simdjson::ondemand::parser parser;
+
+    // buffer holds window_size bytes of trace data, followed by the padding
+    // simdjson requires; [data_begin, data_end) is read but not yet parsed
+    std::vector<char> buffer;
+    size_t window_size;
+    size_t data_begin = 0;
+    size_t data_end = 0;
+    bool at_eof = false;
+    bool failed = false;
+
+    // state of the scan for separators between events, which has reached scan_pos
+    size_t scan_pos = 0;
+    size_t depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+    bool array_opened = false;
+    bool array_closed = false;
+    bool seen_events = false;
+    // position of the last ',' or closing ']' of the event array found by the scan
+    size_t last_separator = NO_SEPARATOR;
+};
+
+}  // namespace tt_npe
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <boost/unordered/unordered_flat_set.hpp>
+
+#include "npeAssert.hpp"
+#include "npeDeviceTypes.hpp"
+#include "npeUtil.hpp"
+
+namespace tt_npe {
+
+using nocRouteView = std::span<const nocLinkID>;
+
+// Owns the routes of every transfer in a simulation, packed back-to-back in a
+// single buffer (CSR layout). Each route is addressed by its offset and length
+// in that buffer. Device models append routes straight into the buffer (see
+// npeDeviceModel::appendRoute), and identical routes are interned so that they
+// share storage.
+//
+// The buffer is reallocated as it grows, so views returned by getRoute() are
+// only stable once every route has been added.
+class nocRouteArena {
+   public:
+    struct RouteRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    nocRouteArena() :
+        interned_routes(0, RouteHash{&links}, RouteEqual{&links}) {}
+    nocRouteArena(const nocRouteArena &) = delete;
+    nocRouteArena &operator=(const nocRouteArena &) = delete;
+
+    // calls append_route(nocRoute &) to append a route to the end of the
+    // arena's buffer, then interns it
+    template <typename AppendRouteFn>
+    RouteRef addRoute(AppendRouteFn &&append_route) {
+        size_t offset = links.size();
+        append_route(links);
+        return internTail(offset);
+    }
+
+    // interns a copy of route
+    RouteRef intern(nocRouteView route) {
+        return addRoute([route](nocRoute &links) {
+            links.insert(links.end(), route.begin(), route.end());
+        });
+    }
+
+    nocRouteView getRoute(RouteRef ref) const {
+        return {links.data() + ref.offset, ref.length};
+    }
+
+    size_t getNumRoutes() const { return interned_routes.size(); }
+    size_t getNumLinks() const { return links.size(); }
+
+   private:
+    // interns the route occupying links[offset:], dropping it from the buffer
+    // again if an identical route is already present
+    RouteRef internTail(size_t offset) {
+        TT_ASSERT(links.size() - offset <= std::numeric_limits<uint32_t>::max());
+        RouteRef ref{uint32_t(offset), uint32_t(links.size() - offset)};
+        if (ref.length == 0) {
+            return {};
+        }
+        auto [it, inserted] = interned_routes.insert(ref);
+        if (!inserted) {
+            links.resize(offset);
+        }
+        return *it;
+    }
+
+    struct RouteHash {
+        const nocRoute *links;
+        size_t operator()(RouteRef ref) const {
+            nocRouteView route(links->data() + ref.offset, ref.length);
+            return hash_container(route.size(), route);
+        }
+    };
+    struct RouteEqual {
+        const nocRoute *links;
+        bool operator()(RouteRef lhs, RouteRef rhs) const {
+            return std::ranges::equal(
+                nocRouteView(links->data() + lhs.offset, lhs.length),
+                nocRouteView(links->data() + rhs.offset, rhs.length));
+        }
+    };
+
+    nocRoute links;
+    boost::unordered_flat_set<RouteRef, RouteHash, RouteEqual> interned_routes;
+};
+
+}  // namespace tt_npe
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include "npeCommon.hpp"
+#include "npeDeviceTypes.hpp"
+#include "npeRouteArena.hpp"
+#include "npeUtil.hpp"
+
+namespace tt_npe {
+
+// Precomputed routes for a single chip with a fixed rows x cols grid.
+//
+// The unicast routes between every pair of cores on both NoCs are computed up
+// front and packed back-to-back, so unicast lookup is a pair of index loads.
+// Multicast routes are computed on first use and cached by source core and
+// destination rectangle. Apart from that cache, which is guarded by a lock,
+// the table is immutable and can be shared by every model instance and thread.
+class nocRouteTable {
+   public:
+    // unicast_route(noc_type, src_row, src_col, dst_row, dst_col) -> nocRoute
+    template <typename UnicastRouteFn>
+    nocRouteTable(size_t rows, size_t cols, UnicastRouteFn &&unicast_route) :
+        rows(rows), cols(cols) {
+        size_t num_routes = NUM_NOCS * rows * cols * rows * cols;
+        route_offsets.reserve(num_routes + 1);
+        route_offsets.push_back(0);
+        for (auto noc_type : {nocType::NOC0, nocType::NOC1}) {
+            for (size_t src_row = 0; src_row < rows; src_row++) {
+                for (size_t src_col = 0; src_col < cols; src_col++) {
+                    for (size_t dst_row = 0; dst_row < rows; dst_row++) {
+                        for (size_t dst_col = 0; dst_col < cols; dst_col++) {
+                            nocRoute route =
+                                unicast_route(noc_type, src_row, src_col, dst_row, dst_col);
+                            links.insert(links.end(), route.begin(), route.end());
+                            route_offsets.push_back(links.size());
+                        }
+                    }
+                }
+            }
+        }
+        TT_ASSERT(route_offsets.size() == num_routes + 1);
+    }
+    nocRouteTable(const nocRouteTable &) = delete;
+    nocRouteTable &operator=(const nocRouteTable &) = delete;
+
+    nocRouteView unicastRoute(
+        nocType noc_type, const Coord &startpoint, const Coord &endpoint) const {
+        TT_ASSERT(
+            inBounds(startpoint) && inBounds(endpoint),
+            "Can not route between out of bounds coords {} and {}",
+            startpoint,
+            endpoint);
+        size_t route_index = (size_t(noc_type) * rows * cols +
+                              size_t(startpoint.row) * cols + size_t(startpoint.col)) *
+                                 rows * cols +
+                             size_t(endpoint.row) * cols + size_t(endpoint.col);
+        uint32_t begin = route_offsets[route_index];
+        uint32_t end = route_offsets[route_index + 1];
+        return {links.data() + begin, end - begin};
+    }
+
+    // returns cached multicast route, calling compute_route() to fill the
+    // cache on first use. Cached routes are never evicted, and their links do
+    // not move when the cache grows, so the view stays valid for the lifetime
+    // of the table.
+    template <typename MulticastRouteFn>
+    nocRouteView multicastRoute(
+        nocType noc_type,
+        const Coord &startpoint,
+        const MulticastCoordSet::CoordGrid &grid,
+        MulticastRouteFn &&compute_route) const {
+        MulticastKey key{
+            noc_type,
+            startpoint.row,
+            startpoint.col,
+            grid.start_coord.row,
+            grid.start_coord.col,
+            grid.end_coord.row,
+            grid.end_coord.col};
+        {
+            std::shared_lock lock(multicast_mutex);
+            auto it = multicast_routes.find(key);
+            if (it != multicast_routes.end()) {
+                return it->second;
+            }
+        }
+        nocRoute route = compute_route();
+        std::unique_lock lock(multicast_mutex);
+        auto [it, _] = multicast_routes.try_emplace(key, std::move(route));
+        return it->second;
+    }
+
+    size_t getNumCachedMulticastRoutes() const {
+        std::shared_lock lock(multicast_mutex);
+        return multicast_routes.size();
+    }
+
+   private:
+    static constexpr size_t NUM_NOCS = 2;
+
+    bool inBounds(const Coord &c) const {
+        return c.row >= 0 && c.col >= 0 && size_t(c.row) < rows && size_t(c.col) < cols;
+    }
+
+    // device_id is deliberately not part of the key; routes are per-chip
+    struct MulticastKey {
+        nocType noc_type;
+        int32_t src_row, src_col;
+        int32_t start_row, start_col;
+        int32_t end_row, end_col;
+        bool operator==(const MulticastKey &) const = default;
+    };
+    struct MulticastKeyHash {
+        size_t operator()(const MulticastKey &key) const {
+            size_t seed = size_t(key.noc_type);
+            for (int32_t v :
+                 {key.src_row, key.src_col, key.start_row, key.start_col, key.end_row, key.end_col}) {
+                seed = hash_combine(seed, v);
+            }
+            return seed;
+        }
+    };
+
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<uint32_t> route_offsets;
+    std::vector<nocLinkID> links;
+
+    mutable std::shared_mutex multicast_mutex;
+    mutable boost::unordered_flat_map<MulticastKey, nocRoute, MulticastKeyHash> multicast_routes;
+};
+
+}  // namespace tt_npe
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "npeCommon.hpp"
+
+namespace tt_npe {
+
+// A seekable timeline is a compressed .npeviz file written in the zstd
+// seekable format. Decompressed as a whole, it is the full timeline. Its
+// frames are ended on the boundaries of cycle regions (the timestep ranges of
+// the split files otherwise emitted for long timelines), so the timestep_data
+// entries of each region are compressed independently of the rest of the
+// file. A region index, stored in a zstd skippable frame, maps timestep and
+// cycle ranges to these frames so that a single region can be read without
+// decompressing the rest. The index is written even if the timeline fits in a
+// single region.
+struct npeTimelineRegionIndexEntry {
+    Timestep start_timestep_idx;  // inclusive
+    Timestep end_timestep_idx;    // exclusive
+    Cycle start_cycle;
+    Cycle end_cycle;
+    uint64_t offset;  // file offset of the region's first frame
+    uint64_t size;    // compressed size of the region's frames
+
+    bool operator==(const npeTimelineRegionIndexEntry &rhs) const = default;
+};
+
+// Skippable frame variant (see npeCompressedFileStream::writeSkippableFrame)
+// holding the region index of a seekable timeline
+constexpr uint32_t TIMELINE_REGION_INDEX_FRAME_VARIANT = 0x1;
+
+// serializes a region index into the payload of its skippable frame
+std::string encodeTimelineRegionIndex(const std::vector<npeTimelineRegionIndexEntry> &regions);
+
+// Reads regions from a seekable timeline file
+class npeSeekableTimelineReader {
+   public:
+    // opens filepath and reads its region index; returns std::nullopt if the
+    // file is not a seekable timeline
+    static std::optional<npeSeekableTimelineReader> open(const std::string &filepath);
+
+    const std::vector<npeTimelineRegionIndexEntry> &getRegions() const { return regions; }
+
+    // returns the index of the first region whose cycle range contains cycle
+    std::optional<size_t> findRegion(Cycle cycle) const;
+
+    // returns the timestep_data entries of a region as a json array
+    std::optional<std::string> readRegion(size_t region_idx) const;
+
+   private:
+    npeSeekableTimelineReader(std::string filepath, std::vector<npeTimelineRegionIndexEntry> regions) :
+        filepath(std::move(filepath)), regions(std::move(regions)) {}
+
+    std::string filepath;
+    std::vector<npeTimelineRegionIndexEntry> regions;
+};
+
+}  // namespace tt_npe
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <bit>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include "nlohmann/json.hpp"
@@ -17,9 +20,32 @@ class npeDeviceModel;
 class npeWorkload;
 class PETransferState;
 
+// Demand on a single link or NIU, kept for timeline output. Demand is rounded
+// to bfloat16 precision (8 significant bits) so an entry packs into 4 bytes.
+struct SparseDemand {
+    int16_t id = 0;  // nocLinkID or nocNIUID
+    uint16_t quantized_demand = 0;
+
+    SparseDemand() = default;
+    SparseDemand(int16_t id, float demand) : id(id) {
+        // round to nearest even on the upper half of the float
+        uint32_t bits = std::bit_cast<uint32_t>(demand);
+        bits += 0x7FFF + ((bits >> 16) & 1);
+        quantized_demand = bits >> 16;
+    }
+    float demand() const { return std::bit_cast<float>(uint32_t(quantized_demand) << 16); }
+};
+
 struct TimestepStats {
+    // link/NIU demand at or below this is left out of timeline data
+    static constexpr float DEMAND_SIGNIFICANCE_THRESHOLD = 0.001;
+
+
     Cycle start_cycle = 0;
     Cycle end_cycle = 0;
+    // number of consecutive identical timesteps covered by this entry; greater
+    // than one when an idle gap or a steady-state run is compressed into a span
+    Timestep num_timesteps = 1;
     // NB: link/niu _demand_ expresses the summed demand over the timestep; it
     // can exceed 100% if multiple NoC packet routes overlap in time
     double avg_link_demand = 0;
@@ -41,9 +67,14 @@ struct TimestepStats {
     // multicast write stats (absolute util over all NoC links)
     double avg_mcast_write_link_util = 0;
 
-    LinkDemandGrid link_demand_grid;
-    NIUDemandGrid niu_demand_grid;
-    std::vector<int> live_transfer_ids;
+    // Timeline data: significant link/NIU demand in id order. Only recorded
+    // for MESH_DEVICE, and only when a timeline file is requested. The
+    // transfers active in a timestep are reconstructed from each transfer's
+    // live interval (see PETransferState::live_start_cycle).
+    std::vector<SparseDemand> link_demand;
+    std::vector<SparseDemand> niu_demand;
+
+    void recordTimelineData(const LinkDemandGrid& link_demand_grid, const NIUDemandGrid& niu_demand_grid);
 };
 
 // various results from npe simulation
@@ -106,10 +137,23 @@ struct npeStats {
     std::unordered_map<DeviceID, deviceStats> per_device_stats;
 
     npeStats() = default;
-    npeStats(const npeDeviceModel* device_model);
+    // If wl is given and describes a single-chip run, only the MESH_DEVICE
+    // stats are tracked during simulation; the per-device stats are identical
+    // and are derived from them by computeSummaryStats().
+    npeStats(const npeDeviceModel* device_model, const npeWorkload* wl = nullptr);
     
     void insertTimestep(Cycle start_cycle, Cycle end_cycle, const npeWorkload& wl);
 
+    // records the idle timesteps in [start_cycle, end_cycle) as a single compressed span
+    void insertIdleSpan(Cycle start_cycle, Cycle end_cycle, Cycle cycles_per_timestep, const npeWorkload& wl);
+
+    // returns how many times the timestep ending at end_cycle can be repeated
+    // before a device without any recorded timesteps would need a fresh entry
+    Timestep maxTimestepRepeats(Cycle end_cycle, Cycle cycles_per_timestep, const npeWorkload& wl) const;
+
+    // extends the most recent timestep on each device by num_repeats identical timesteps
+    void repeatLastTimestep(Timestep num_repeats, Cycle cycles_per_timestep);
+
     std::string to_string(bool verbose = false) const;
 
     // populates summary stat fields from per-timestep stats
@@ -126,6 +170,10 @@ struct npeStats {
         const npeConfig &cfg) const;
 
     static constexpr const char* CURRENT_TIMELINE_SCHEMA_VERSION = "1.0.0";
+
+   private:
+    // device whose stats are derived from MESH_DEVICE stats (single-chip runs only)
+    std::optional<DeviceID> mirrored_device_id;
 };
 
 }  // namespace tt_npe
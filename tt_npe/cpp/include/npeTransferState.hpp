@@ -4,11 +4,13 @@
 #pragma once
 
 #include <boost/container/small_vector.hpp>
+#include <span>
 
 #include "npeCommon.hpp"
 #include "npeDependencyTracker.hpp"
 #include "npeWorkload.hpp"
 #include "npeDeviceTypes.hpp"
+#include "npeRouteArena.hpp"
 
 namespace bc = boost::container;
 
@@ -18,16 +20,29 @@ using PETransferID = int;
 
 struct PETransferState {
     PETransferState() = default;
+    // NOTE: wl_transfer must outlive this object
     PETransferState(
-        const npeWorkloadTransfer &wl_transfer, Cycle start_cycle, nocRoute &&route) :
-        params(wl_transfer), start_cycle(start_cycle), end_cycle(0), route(std::move(route)) {}
+        const npeWorkloadTransfer &wl_transfer, Cycle start_cycle, nocRouteView route) :
+        params(&wl_transfer), route(route), start_cycle(start_cycle), end_cycle(0) {}
 
-    npeWorkloadTransfer params;
+    const npeWorkloadTransfer *params = nullptr;  // owned by the npeWorkload
     bc::small_vector<npeCheckpointID, 2> required_by;
     npeCheckpointID depends_on = npeTransferDependencyTracker::UNDEFINED_CHECKPOINT;
-    nocRoute route;
+    nocRouteView route;  // owned by a nocRouteArena
     Cycle start_cycle = 0;
     Cycle end_cycle = 0;
+    // Cycles over which the transfer was in the simulation's live set, from
+    // the start of the timestep it was activated in to the end of the
+    // timestep it completed in. Used to reconstruct per-timestep activity.
+    Cycle live_start_cycle = 0;
+    Cycle live_end_cycle = 0;
+
+    // NIUs loaded by this transfer and the rate at which its sink NIU(s) absorb
+    // data; fixed for the transfer's lifetime, so resolved once up front by
+    // resolveTransferNIUs(). Multicast transfers only load WORKER sink NIUs.
+    nocNIUID src_niu_id = -1;
+    bc::small_vector<nocNIUID, 1> sink_niu_ids;
+    float sink_absorption_rate = 0;
 
     float curr_bandwidth = 0;
     size_t total_bytes_transferred = 0;
@@ -35,4 +50,108 @@ struct PETransferState {
     bool operator<(const auto &rhs) const { return start_cycle < rhs.start_cycle; }
     bool operator>(const auto &rhs) const { return start_cycle > rhs.start_cycle; }
 };
+
+// Structure-of-arrays copy of the per-transfer state read and written every
+// timestep by the simulation loop and congestion models, indexed by
+// PETransferID. Keeping these fields in parallel arrays avoids pulling the
+// cold workload params (strings, destination variant, ...) of every live
+// transfer into cache each timestep.
+//
+// PETransferState remains the record of each transfer; the mutable fields
+// here must be copied back with writeBack() once a transfer completes.
+struct PETransferHotState {
+    PETransferHotState() = default;
+    // NOTE: route aliases into the nocRouteArena owning each transfer's route
+    explicit PETransferHotState(const std::vector<PETransferState> &transfers) {
+        size_t num_transfers = transfers.size();
+        curr_bandwidth.resize(num_transfers, 0.0f);
+        total_bytes_transferred.resize(num_transfers);
+        start_cycle.resize(num_transfers);
+        end_cycle.resize(num_transfers);
+        total_bytes.resize(num_transfers);
+        depends_on.resize(num_transfers);
+        peak_bandwidth.resize(num_transfers, UNRESOLVED_BANDWIDTH);
+        injection_rate.resize(num_transfers);
+        packet_size.resize(num_transfers);
+        num_packets.resize(num_transfers);
+        src_niu_id.resize(num_transfers);
+        sink_niu_offset.resize(num_transfers);
+        num_sink_nius.resize(num_transfers);
+        sink_absorption_rate.resize(num_transfers);
+        route.resize(num_transfers);
+        is_multicast.resize(num_transfers);
+        is_multicast_write.resize(num_transfers);
+
+        size_t total_sink_nius = 0;
+        for (const auto &tr : transfers) {
+            total_sink_nius += tr.sink_niu_ids.size();
+        }
+        sink_niu_id_data.reserve(total_sink_nius);
+
+        for (size_t id = 0; id < num_transfers; id++) {
+            const auto &tr = transfers[id];
+            curr_bandwidth[id] = tr.curr_bandwidth;
+            total_bytes_transferred[id] = tr.total_bytes_transferred;
+            start_cycle[id] = tr.start_cycle;
+            end_cycle[id] = tr.end_cycle;
+            total_bytes[id] = tr.params->total_bytes;
+            depends_on[id] = tr.depends_on;
+            injection_rate[id] = tr.params->injection_rate;
+            packet_size[id] = tr.params->packet_size;
+            num_packets[id] = tr.params->num_packets;
+            src_niu_id[id] = tr.src_niu_id;
+            sink_niu_offset[id] = sink_niu_id_data.size();
+            num_sink_nius[id] = tr.sink_niu_ids.size();
+            sink_niu_id_data.insert(
+                sink_niu_id_data.end(), tr.sink_niu_ids.begin(), tr.sink_niu_ids.end());
+            sink_absorption_rate[id] = tr.sink_absorption_rate;
+            route[id] = tr.route;
+            is_multicast[id] = std::holds_alternative<MulticastCoordSet>(tr.params->dst);
+            is_multicast_write[id] = tr.params->noc_event_type == nocEventType::WRITE_MULTICAST;
+        }
+    }
+
+    size_t size() const { return curr_bandwidth.size(); }
+    bool isComplete(PETransferID id) const {
+        return total_bytes_transferred[id] == total_bytes[id];
+    }
+    std::span<const nocNIUID> getSinkNIUIDs(PETransferID id) const {
+        return {sink_niu_id_data.data() + sink_niu_offset[id], num_sink_nius[id]};
+    }
+
+    // copies mutable simulation state for transfer id back into tr
+    void writeBack(PETransferID id, PETransferState &tr) const {
+        tr.curr_bandwidth = curr_bandwidth[id];
+        tr.total_bytes_transferred = total_bytes_transferred[id];
+        tr.start_cycle = start_cycle[id];
+        tr.end_cycle = end_cycle[id];
+    }
+
+    static constexpr float UNRESOLVED_BANDWIDTH = -1.0f;
+
+    // mutable simulation state
+    std::vector<float> curr_bandwidth;
+    std::vector<size_t> total_bytes_transferred;
+    std::vector<Cycle> start_cycle;
+    std::vector<Cycle> end_cycle;
+
+    // fixed for the lifetime of the transfer
+    std::vector<size_t> total_bytes;
+    std::vector<npeCheckpointID> depends_on;
+    // congestion-free bandwidth; resolved lazily by updateTransferBandwidth()
+    std::vector<float> peak_bandwidth;
+    std::vector<float> injection_rate;
+    std::vector<uint32_t> packet_size;
+    std::vector<uint32_t> num_packets;
+    std::vector<nocNIUID> src_niu_id;
+    // sink NIUs of all transfers packed back to back; those of transfer id
+    // start at sink_niu_offset[id] (see getSinkNIUIDs())
+    std::vector<nocNIUID> sink_niu_id_data;
+    std::vector<uint32_t> sink_niu_offset;
+    std::vector<uint32_t> num_sink_nius;
+    std::vector<float> sink_absorption_rate;
+    std::vector<nocRouteView> route;
+    std::vector<uint8_t> is_multicast;
+    std::vector<uint8_t> is_multicast_write;
+};
 }  // namespace tt_npe
\ No newline at end of file
@@ -6,8 +6,10 @@
 #include <vector>
 #include <filesystem>
 #include <optional>
+#include <string_view>
 
 #include "fmt/core.h"
+#include "npeCommon.hpp"
 #include "npeUtil.hpp"
 #include "nlohmann/json.hpp"
 
@@ -18,6 +20,46 @@ using npeWorkloadTransferID = int;
 using npeWorkloadTransferGroupID = int;
 using npeWorkloadTransferGroupIndex = int;
 using npeWorkloadTransferGroupParent = int;
+using npeZonePathID = int32_t;
+
+// ID 0 of every workload's zone path pool is the empty path
+constexpr npeZonePathID EMPTY_ZONE_PATH = 0;
+
+// NoC event types recognized in noc traces. Transfers built programmatically,
+// or with an unrecognized event type, are UNKNOWN.
+enum class nocEventType : uint8_t {
+    UNKNOWN,
+    READ,
+    READ_SET_STATE,
+    READ_WITH_STATE,
+    READ_WITH_STATE_AND_TRID,
+    READ_DRAM_SHARDED_SET_STATE,
+    READ_DRAM_SHARDED_WITH_STATE,
+    WRITE_,
+    WRITE_MULTICAST,
+    WRITE_SET_STATE,
+    WRITE_WITH_STATE,
+    FABRIC_UNICAST_WRITE,
+    FABRIC_UNICAST_INLINE_WRITE,
+    FABRIC_UNICAST_ATOMIC_INC,
+    FABRIC_FUSED_UNICAST_ATOMIC_INC,
+    FABRIC_UNICAST_SCATTER_WRITE,
+};
+
+// returns UNKNOWN if noc_event_type is not a recognized noc event type name
+inline nocEventType parseNocEventType(std::string_view noc_event_type) {
+    return magic_enum::enum_cast<nocEventType>(noc_event_type).value_or(nocEventType::UNKNOWN);
+}
+
+// returns noc event type name as it appears in noc traces; UNKNOWN is empty
+inline std::string_view nocEventTypeName(nocEventType noc_event_type) {
+    return noc_event_type == nocEventType::UNKNOWN ? std::string_view{}
+                                                   : magic_enum::enum_name(noc_event_type);
+}
+
+inline bool isFabricEventType(nocEventType noc_event_type) {
+    return nocEventTypeName(noc_event_type).starts_with("FABRIC_");
+}
 
 class npeWorkload;
 class npeDeviceModel;
@@ -34,8 +76,8 @@ struct npeWorkloadTransfer {
         float injection_rate_arg,
         Cycle phase_cycle_offset_arg,
         nocType noc_type,
-        std::string_view noc_event_type = "",
-        std::string enclosing_zone_path_arg = "",
+        nocEventType noc_event_type = nocEventType::UNKNOWN,
+        npeZonePathID enclosing_zone_path_id_arg = EMPTY_ZONE_PATH,
         npeWorkloadTransferGroupID transfer_group_id_arg = -1,
         npeWorkloadTransferGroupIndex transfer_group_index_arg = -1,
         npeWorkloadTransferGroupParent transfer_group_parent_arg = -1) :
@@ -47,8 +89,8 @@ struct npeWorkloadTransfer {
         phase_cycle_offset(phase_cycle_offset_arg),
         noc_type(noc_type),
         noc_event_type(noc_event_type),
-        enclosing_zone_path(enclosing_zone_path_arg),
         total_bytes(packet_size_arg * num_packets_arg),
+        enclosing_zone_path_id(enclosing_zone_path_id_arg),
         transfer_group_id(transfer_group_id_arg),
         transfer_group_index(transfer_group_index_arg),
         transfer_group_parent(transfer_group_parent_arg),
@@ -63,9 +105,10 @@ struct npeWorkloadTransfer {
     Cycle phase_cycle_offset =
         0;  // when this transfer can start relative to beginning of its phase
     nocType noc_type;
-    std::string noc_event_type;
+    nocEventType noc_event_type;
     uint32_t total_bytes;
-    std::string enclosing_zone_path;
+    // index into zone path pool of the enclosing npeWorkload; see npeWorkload::getZonePath()
+    npeZonePathID enclosing_zone_path_id;
 
     npeWorkloadTransferGroupID transfer_group_id = -1;
     npeWorkloadTransferGroupIndex transfer_group_index = -1;
@@ -138,13 +181,31 @@ class npeWorkload {
     const boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>>& getZones() const { return zones; }
     void setZones(boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>> zones_arg) { zones = zones_arg; }
 
+    // Zone paths are interned per workload; transfers store only the returned
+    // ID. Interning the same path again returns the same ID.
+    npeZonePathID internZonePath(std::string_view zone_path);
+    const std::string &getZonePath(npeZonePathID zone_path_id) const {
+        return zone_paths.at(zone_path_id);
+    }
+    size_t getNumZonePaths() const { return zone_paths.size(); }
+
    private:
+    struct ZonePathHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view zone_path) const {
+            return std::hash<std::string_view>{}(zone_path);
+        }
+    };
+
     std::optional<std::filesystem::path> source_filepath;
     std::vector<npeWorkloadPhase> phases;
     npeWorkloadTransferID gbl_transfer_id = 0;
     npeWorkloadTransferGroupID num_transfer_groups = 0;
     boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
     boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>> zones;
+    std::vector<std::string> zone_paths = {""};
+    boost::unordered_flat_map<std::string, npeZonePathID, ZonePathHash, std::equal_to<>>
+        zone_path_ids = {{"", EMPTY_ZONE_PATH}};
 };
 
 }  // namespace tt_npe
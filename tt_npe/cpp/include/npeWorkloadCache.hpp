@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "npeWorkload.hpp"
+
+namespace tt_npe {
+
+// returns the XXH64 hash of bytes
+uint64_t hashBytes(std::string_view bytes, uint64_t seed = 0);
+
+// A directory of converted workloads, each stored in a compact binary form
+// (.npewl) so that converting the same inputs again skips parsing them.
+//
+// An entry is keyed by a hash of the contents of the files a workload was
+// converted from and of a string describing how it was converted (the
+// converter version and any options that change the result); changing either
+// yields a different key. Entries are never evicted; the directory can be
+// deleted at any time.
+class npeWorkloadCache {
+   public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    explicit npeWorkloadCache(std::filesystem::path cache_dir) : cache_dir(std::move(cache_dir)) {}
+
+    // returns the key of the workload converted from input_files as described
+    // by converter_options; std::nullopt if an input file can not be read
+    std::optional<std::string> computeKey(
+        const std::vector<std::string> &input_files, std::string_view converter_options) const;
+
+    std::filesystem::path getEntryPath(const std::string &key) const;
+
+    // Memory-maps the entry for key and decodes its workload; returns
+    // std::nullopt if there is no entry (or it is unreadable, which is logged
+    // as a warning). The workload's source file path is not set.
+    std::optional<npeWorkload> load(const std::string &key) const;
+
+    // Writes wl as the entry for key, atomically replacing any existing entry
+    // so that concurrent readers see either. Returns false (and logs a
+    // warning) on failure.
+    bool store(const std::string &key, const npeWorkload &wl) const;
+
+    static std::string serialize(const npeWorkload &wl);
+    // throws std::runtime_error if bytes are not a valid serialized workload
+    static npeWorkload deserialize(std::string_view bytes);
+
+   private:
+    std::filesystem::path cache_dir;
+};
+
+}  // namespace tt_npe
@@ -1,11 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include "ingestWorkload.hpp"
+#include "npeBinaryTimeline.hpp"
 #include "npeAPI.hpp"
+#include "npeSeekableTimeline.hpp"
 
 namespace py = pybind11;
 
@@ -197,6 +200,95 @@ PYBIND11_MODULE(tt_npe_pybind, m) {
             return stats;
         }));
 
+    //---- binary timeline bindings -------------------------------------------
+    // columns are returned as numpy arrays (copies of the decoded columns)
+    auto column = [](auto member) {
+        return [member](const tt_npe::npeBinaryTimeline& timeline) {
+            const auto& values = timeline.*member;
+            return py::array(py::ssize_t(values.size()), values.data());
+        };
+    };
+    py::class_<tt_npe::npeBinaryTimeline> binary_timeline(
+        m,
+        "BinaryTimeline",
+        "Per-timestep timeline data in columnar form, as read from a binary (.npetl) timeline file. "
+        "Demand entries refer to links/NIUs by their index into `endpoints`; the entries of "
+        "timestep i are [demand_offsets[i], demand_offsets[i+1]) (likewise for active transfers).");
+    binary_timeline
+        .def_readonly("device_name", &tt_npe::npeBinaryTimeline::device_name)
+        .def_readonly("arch", &tt_npe::npeBinaryTimeline::arch)
+        .def_readonly("cycles_per_timestep", &tt_npe::npeBinaryTimeline::cycles_per_timestep)
+        .def_property_readonly(
+            "endpoints",
+            [](const tt_npe::npeBinaryTimeline& timeline) {
+                py::list endpoints;
+                for (const auto& endpoint : timeline.endpoints) {
+                    endpoints.append(py::make_tuple(endpoint.device_id, endpoint.row, endpoint.col, endpoint.type));
+                }
+                return endpoints;
+            },
+            "List of (device_id, row, col, type) tuples for each link/NIU")
+        .def_property_readonly("start_cycle", column(&tt_npe::npeBinaryTimeline::start_cycle))
+        .def_property_readonly("end_cycle", column(&tt_npe::npeBinaryTimeline::end_cycle))
+        .def_property_readonly("avg_link_demand", column(&tt_npe::npeBinaryTimeline::avg_link_demand))
+        .def_property_readonly("avg_link_util", column(&tt_npe::npeBinaryTimeline::avg_link_util))
+        .def_property_readonly("mcast_write_link_util", column(&tt_npe::npeBinaryTimeline::mcast_write_link_util))
+        .def_property_readonly("avg_noc0_link_demand", column(&tt_npe::npeBinaryTimeline::avg_noc0_link_demand))
+        .def_property_readonly("avg_noc0_link_util", column(&tt_npe::npeBinaryTimeline::avg_noc0_link_util))
+        .def_property_readonly("max_noc0_link_demand", column(&tt_npe::npeBinaryTimeline::max_noc0_link_demand))
+        .def_property_readonly("avg_noc1_link_demand", column(&tt_npe::npeBinaryTimeline::avg_noc1_link_demand))
+        .def_property_readonly("avg_noc1_link_util", column(&tt_npe::npeBinaryTimeline::avg_noc1_link_util))
+        .def_property_readonly("max_noc1_link_demand", column(&tt_npe::npeBinaryTimeline::max_noc1_link_demand))
+        .def_property_readonly("active_transfer_offsets", column(&tt_npe::npeBinaryTimeline::active_transfer_offsets))
+        .def_property_readonly("active_transfers", column(&tt_npe::npeBinaryTimeline::active_transfers))
+        .def_property_readonly("demand_offsets", column(&tt_npe::npeBinaryTimeline::demand_offsets))
+        .def_property_readonly("demand_endpoint", column(&tt_npe::npeBinaryTimeline::demand_endpoint))
+        .def_property_readonly("demand", column(&tt_npe::npeBinaryTimeline::demand))
+        .def("num_timesteps", &tt_npe::npeBinaryTimeline::numTimesteps);
+
+    m.def(
+        "readBinaryTimeline",
+        &tt_npe::npeBinaryTimeline::readFromFile,
+        py::arg("filepath"),
+        "Reads a binary (.npetl) timeline file emitted when `npe.Config.emit_binary_timeline_file` "
+        "is set. Returns None if the file can not be read.");
+
+    //---- seekable timeline bindings -----------------------------------------
+    py::class_<tt_npe::npeTimelineRegionIndexEntry>(
+        m,
+        "SeekableTimelineRegion",
+        "Cycle range covered by a region of a seekable timeline. Timestep indices are "
+        "[start_timestep_idx, end_timestep_idx).")
+        .def_readonly("start_timestep_idx", &tt_npe::npeTimelineRegionIndexEntry::start_timestep_idx)
+        .def_readonly("end_timestep_idx", &tt_npe::npeTimelineRegionIndexEntry::end_timestep_idx)
+        .def_readonly("start_cycle", &tt_npe::npeTimelineRegionIndexEntry::start_cycle)
+        .def_readonly("end_cycle", &tt_npe::npeTimelineRegionIndexEntry::end_cycle);
+
+    py::class_<tt_npe::npeSeekableTimelineReader>(
+        m,
+        "SeekableTimelineReader",
+        "Reads single regions of a seekable compressed timeline without decompressing the rest "
+        "of the file.")
+        .def_property_readonly("regions", &tt_npe::npeSeekableTimelineReader::getRegions)
+        .def(
+            "find_region",
+            &tt_npe::npeSeekableTimelineReader::findRegion,
+            py::arg("cycle"),
+            "Returns the index of the region containing cycle, or None.")
+        .def(
+            "read_region",
+            &tt_npe::npeSeekableTimelineReader::readRegion,
+            py::arg("region_idx"),
+            "Returns the timestep_data entries of a region as a JSON array, or None if it can not be "
+            "read.");
+
+    m.def(
+        "openSeekableTimeline",
+        &tt_npe::npeSeekableTimelineReader::open,
+        py::arg("filepath"),
+        "Opens a compressed timeline file emitted when `npe.Config.seekable_timeline_output_file` "
+        "is set. Returns None if the file is not a seekable timeline.");
+
     py::class_<tt_npe::npeException> exception(
         m,
         "Exception",
@@ -223,9 +315,15 @@ PYBIND11_MODULE(tt_npe_pybind, m) {
         .def_readwrite("remove_localized_unicast_transfers", &tt_npe::npeConfig::remove_localized_unicast_transfers)
         .def_readwrite("workload_is_noc_trace", &tt_npe::npeConfig::workload_is_noc_trace)
         .def_readwrite("compress_timeline_output_file", &tt_npe::npeConfig::compress_timeline_output_file)
+        .def_readwrite("timeline_compression_level", &tt_npe::npeConfig::timeline_compression_level)
+        .def_readwrite("timeline_compression_num_workers", &tt_npe::npeConfig::timeline_compression_num_workers)
+        .def_readwrite("seekable_timeline_output_file", &tt_npe::npeConfig::seekable_timeline_output_file)
         .def_readwrite("timeline_filepath", &tt_npe::npeConfig::timeline_filepath)
         .def_readwrite("use_legacy_timeline_format", &tt_npe::npeConfig::use_legacy_timeline_format)
+        .def_readwrite("emit_binary_timeline_file", &tt_npe::npeConfig::emit_binary_timeline_file)
         .def_readwrite("estimate_cong_impact", &tt_npe::npeConfig::estimate_cong_impact)
+        .def_readwrite("fast_forward_idle_timesteps", &tt_npe::npeConfig::fast_forward_idle_timesteps)
+        .def_readwrite("fast_forward_steady_state", &tt_npe::npeConfig::fast_forward_steady_state)
         .def_readwrite(
             "infer_injection_rate_from_src", &tt_npe::npeConfig::infer_injection_rate_from_src)
         .def_readwrite("topology_json", &tt_npe::npeConfig::topology_json)
@@ -329,6 +427,22 @@ PYBIND11_MODULE(tt_npe_pybind, m) {
         py::arg("device_name") = "",
         py::arg("is_noc_trace_format") = false,
         py::arg("verbose") = false,
+        py::arg("cache_dir") = "",
         "Returns an `npe.Workload` object from a pre-defined workload in a JSON file. If using a "
-        "raw tt-metal profiler noc trace, set 'is_noc_trace_format' True ");
+        "raw tt-metal profiler noc trace, set 'is_noc_trace_format' True. If 'cache_dir' is set, the "
+        "converted workload is cached there and reused while the file is unchanged.");
+    m.def(
+        "createWorkloadFromNocTraces",
+        &tt_npe::convertNocTraceFilesToNpeWorkload,
+        py::arg("noc_trace_files"),
+        py::arg("topology_json"),
+        py::arg("device_name") = "",
+        py::arg("verbose") = false,
+        py::arg("num_threads") = 0,
+        py::arg("cache_dir") = "",
+        "Returns an `npe.Workload` object merging the per-device tt-metal noc traces of a multichip "
+        "run. Each entry of 'noc_trace_files' is a trace file or a filename pattern with '*' and '?' "
+        "wildcards. Fabric send paths are elaborated from 'topology_json'. If 'device_name' is empty, "
+        "the cluster type of the topology is used. If 'cache_dir' is set, the merged workload is cached "
+        "there and reused while the traces and topology are unchanged.");
 }
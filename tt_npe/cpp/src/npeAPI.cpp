@@ -4,6 +4,7 @@
 #include "npeAPI.hpp"
 
 #include "npeCommon.hpp"
+#include "npeCompressionUtil.hpp"
 #include "npeEngine.hpp"
 
 namespace tt_npe {
@@ -24,6 +25,29 @@ void npeAPI::validateConfig() const {
             fmt::format(
                 "Illegal congestion model name '{}' in npeConfig", cfg.congestion_model_name));
     }
+    if (!npeCompressionUtil::isValidCompressionLevel(cfg.timeline_compression_level)) {
+        throw npeException(
+            npeErrorCode::INVALID_CONFIG,
+            fmt::format(
+                "Illegal timeline compression level '{}' in npeConfig", cfg.timeline_compression_level));
+    }
+    if (cfg.timeline_compression_num_workers < 0) {
+        throw npeException(
+            npeErrorCode::INVALID_CONFIG,
+            fmt::format(
+                "Illegal timeline compression worker count '{}' in npeConfig",
+                cfg.timeline_compression_num_workers));
+    }
+    if (cfg.seekable_timeline_output_file && !cfg.compress_timeline_output_file) {
+        throw npeException(
+            npeErrorCode::INVALID_CONFIG,
+            "Seekable timeline output requires compress_timeline_output_file in npeConfig");
+    }
+    if (cfg.emit_binary_timeline_file && cfg.use_legacy_timeline_format) {
+        throw npeException(
+            npeErrorCode::INVALID_CONFIG,
+            "Binary timeline output is not supported with use_legacy_timeline_format in npeConfig");
+    }
 }
 
 npeWorkload npeAPI::preprocessWorkload(npeWorkload wl) const {
@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#include "npeBinaryTimeline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+#include "npeAssert.hpp"
+#include "npeByteCodec.hpp"
+#include "npeStats.hpp"
+#include "npeUtil.hpp"
+
+namespace tt_npe {
+
+// File layout (all integers little-endian):
+//
+//   magic "NPETLBIN", u32 format version
+//   device_name, arch (strings), cycles_per_timestep (varint)
+//   endpoint type names: count, then strings
+//   endpoints: count, then (device_id, row, col, type index) zigzag varints
+//   num_timesteps (varint)
+//   columns, each prefixed by its size in bytes (varint):
+//     start_cycle         zigzag varint delta from previous timestep
+//     duration            varint (end_cycle - start_cycle)
+//     stats               one f32 column per per-timestep stat
+//     active counts       varint per timestep
+//     active transfers    zigzag varint delta from previous id in the timestep
+//     demand counts       varint per timestep
+//     demand endpoints    varint per entry
+//     demand values       u16 per entry (upper half of f32)
+//
+// Strings are stored as a varint length followed by their bytes.
+
+namespace {
+
+constexpr std::string_view MAGIC = "NPETLBIN";
+
+// per-timestep stat columns, in file order
+template <typename Timeline>
+auto statColumns(Timeline &timeline) {
+    return std::array{
+        &timeline.avg_link_demand,
+        &timeline.avg_link_util,
+        &timeline.mcast_write_link_util,
+        &timeline.avg_noc0_link_demand,
+        &timeline.avg_noc0_link_util,
+        &timeline.max_noc0_link_demand,
+        &timeline.avg_noc1_link_demand,
+        &timeline.avg_noc1_link_util,
+        &timeline.max_noc1_link_demand};
+}
+
+}  // namespace
+
+bool npeBinaryTimeline::writeToFile(const std::string &filepath) const {
+    size_t num_timesteps = numTimesteps();
+    TT_ASSERT(end_cycle.size() == num_timesteps);
+    TT_ASSERT(active_transfer_offsets.size() == num_timesteps + 1);
+    TT_ASSERT(demand_offsets.size() == num_timesteps + 1);
+    TT_ASSERT(demand_endpoint.size() == demand.size());
+    for (const auto *column : statColumns(*this)) {
+        TT_ASSERT(column->size() == num_timesteps);
+    }
+
+    ByteWriter out;
+    out.bytes += MAGIC;
+    out.putRaw<uint32_t>(FORMAT_VERSION);
+    out.putString(device_name);
+    out.putString(arch);
+    out.putVarint(cycles_per_timestep);
+
+    // endpoint dictionary; endpoint types are themselves dictionary encoded
+    std::vector<std::string_view> type_names;
+    std::vector<uint64_t> endpoint_types;
+    for (const auto &endpoint : endpoints) {
+        auto it = std::find(type_names.begin(), type_names.end(), endpoint.type);
+        endpoint_types.push_back(it - type_names.begin());
+        if (it == type_names.end()) {
+            type_names.push_back(endpoint.type);
+        }
+    }
+    out.putVarint(type_names.size());
+    for (auto type_name : type_names) {
+        out.putString(type_name);
+    }
+    out.putVarint(endpoints.size());
+    for (size_t i = 0; i < endpoints.size(); i++) {
+        out.putZigzag(endpoints[i].device_id);
+        out.putZigzag(endpoints[i].row);
+        out.putZigzag(endpoints[i].col);
+        out.putVarint(endpoint_types[i]);
+    }
+
+    out.putVarint(num_timesteps);
+
+    ByteWriter start_cycles, durations;
+    Cycle prev_start_cycle = 0;
+    for (size_t i = 0; i < num_timesteps; i++) {
+        start_cycles.putZigzag(int64_t(start_cycle[i] - prev_start_cycle));
+        durations.putVarint(end_cycle[i] - start_cycle[i]);
+        prev_start_cycle = start_cycle[i];
+    }
+    out.putColumn(start_cycles);
+    out.putColumn(durations);
+
+    for (const auto *column : statColumns(*this)) {
+        ByteWriter stats;
+        for (float value : *column) {
+            stats.putRaw(value);
+        }
+        out.putColumn(stats);
+    }
+
+    ByteWriter active_counts, active_ids;
+    for (size_t i = 0; i < num_timesteps; i++) {
+        active_counts.putVarint(active_transfer_offsets[i + 1] - active_transfer_offsets[i]);
+        int64_t prev_id = 0;
+        for (size_t j = active_transfer_offsets[i]; j < active_transfer_offsets[i + 1]; j++) {
+            active_ids.putZigzag(active_transfers[j] - prev_id);
+            prev_id = active_transfers[j];
+        }
+    }
+    out.putColumn(active_counts);
+    out.putColumn(active_ids);
+
+    ByteWriter demand_counts, demand_endpoints, demand_values;
+    for (size_t i = 0; i < num_timesteps; i++) {
+        demand_counts.putVarint(demand_offsets[i + 1] - demand_offsets[i]);
+    }
+    for (size_t j = 0; j < demand.size(); j++) {
+        demand_endpoints.putVarint(demand_endpoint[j]);
+        demand_values.putRaw(SparseDemand(0, demand[j]).quantized_demand);
+    }
+    out.putColumn(demand_counts);
+    out.putColumn(demand_endpoints);
+    out.putColumn(demand_values);
+
+    std::ofstream ofs(filepath, std::ios::binary);
+    if (!ofs) {
+        log_error("Was not able to open binary timeline file '{}'", filepath);
+        return false;
+    }
+    ofs.write(out.bytes.data(), out.bytes.size());
+    if (!ofs) {
+        log_error("Error writing binary timeline file '{}'", filepath);
+        return false;
+    }
+    return true;
+}
+
+std::optional<npeBinaryTimeline> npeBinaryTimeline::readFromFile(const std::string &filepath) {
+    std::ifstream ifs(filepath, std::ios::binary);
+    if (!ifs) {
+        log_error("Was not able to open binary timeline file '{}'", filepath);
+        return std::nullopt;
+    }
+    std::string bytes{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+
+    try {
+        ByteReader in(bytes);
+        for (char c : MAGIC) {
+            if (in.getRaw<char>() != c) {
+                throw std::runtime_error("not a binary timeline file");
+            }
+        }
+        auto version = in.getRaw<uint32_t>();
+        if (version != FORMAT_VERSION) {
+            throw std::runtime_error(fmt::format("unsupported format version {}", version));
+        }
+
+        npeBinaryTimeline timeline;
+        timeline.device_name = in.getString();
+        timeline.arch = in.getString();
+        timeline.cycles_per_timestep = in.getVarint();
+
+        std::vector<std::string_view> type_names(in.getVarint());
+        for (auto &type_name : type_names) {
+            type_name = in.getString();
+        }
+        timeline.endpoints.resize(in.getVarint());
+        for (auto &endpoint : timeline.endpoints) {
+            endpoint.device_id = in.getZigzag();
+            endpoint.row = in.getZigzag();
+            endpoint.col = in.getZigzag();
+            endpoint.type = type_names.at(in.getVarint());
+        }
+
+        size_t num_timesteps = in.getVarint();
+        ByteReader start_cycles = in.getColumn();
+        ByteReader durations = in.getColumn();
+        timeline.start_cycle.resize(num_timesteps);
+        timeline.end_cycle.resize(num_timesteps);
+        Cycle prev_start_cycle = 0;
+        for (size_t i = 0; i < num_timesteps; i++) {
+            timeline.start_cycle[i] = prev_start_cycle + start_cycles.getZigzag();
+            timeline.end_cycle[i] = timeline.start_cycle[i] + durations.getVarint();
+            prev_start_cycle = timeline.start_cycle[i];
+        }
+
+        for (auto *column : statColumns(timeline)) {
+            ByteReader stats = in.getColumn();
+            column->resize(num_timesteps);
+            for (auto &value : *column) {
+                value = stats.getRaw<float>();
+            }
+        }
+
+        ByteReader active_counts = in.getColumn();
+        ByteReader active_ids = in.getColumn();
+        timeline.active_transfer_offsets.resize(num_timesteps + 1);
+        for (size_t i = 0; i < num_timesteps; i++) {
+            timeline.active_transfer_offsets[i + 1] = timeline.active_transfer_offsets[i] + active_counts.getVarint();
+        }
+        timeline.active_transfers.resize(timeline.active_transfer_offsets.back());
+        for (size_t i = 0; i < num_timesteps; i++) {
+            int64_t prev_id = 0;
+            for (size_t j = timeline.active_transfer_offsets[i]; j < timeline.active_transfer_offsets[i + 1]; j++) {
+                timeline.active_transfers[j] = prev_id + active_ids.getZigzag();
+                prev_id = timeline.active_transfers[j];
+            }
+        }
+
+        ByteReader demand_counts = in.getColumn();
+        ByteReader demand_endpoints = in.getColumn();
+        ByteReader demand_values = in.getColumn();
+        timeline.demand_offsets.resize(num_timesteps + 1);
+        for (size_t i = 0; i < num_timesteps; i++) {
+            timeline.demand_offsets[i + 1] = timeline.demand_offsets[i] + demand_counts.getVarint();
+        }
+        size_t num_demand_entries = timeline.demand_offsets.back();
+        timeline.demand_endpoint.resize(num_demand_entries);
+        timeline.demand.resize(num_demand_entries);
+        for (size_t j = 0; j < num_demand_entries; j++) {
+            timeline.demand_endpoint[j] = demand_endpoints.getVarint();
+            if (timeline.demand_endpoint[j] >= timeline.endpoints.size()) {
+                throw std::runtime_error("demand entry refers to unknown endpoint");
+            }
+            SparseDemand sparse_demand;
+            sparse_demand.quantized_demand = demand_values.getRaw<uint16_t>();
+            timeline.demand[j] = sparse_demand.demand();
+        }
+
+        if (!in.atEnd()) {
+            throw std::runtime_error("unexpected data after last column");
+        }
+        return timeline;
+    } catch (const std::exception &e) {
+        log_error("Failed to read binary timeline file '{}': {}", filepath, e.what());
+        return std::nullopt;
+    }
+}
+
+}  // namespace tt_npe
@@ -2,12 +2,15 @@
 // SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
 
 #include "npeCompressionUtil.hpp"
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <vector>
 #include "zstd.h"
 #include <stdexcept> // For error reporting, though we return bool
 #include <iostream> // For potential error logging
 #include "npeAssert.hpp"
+#include "npeUtil.hpp"
 
 namespace tt_npe {
 bool npeCompressionUtil::compressToFile(const std::string& contents, const std::string& filepath) {
@@ -56,4 +59,299 @@ bool npeCompressionUtil::compressToFile(const std::string& contents, const std::
     outFile.close();
     return true;
 }
+
+std::optional<std::string> npeCompressionUtil::compressToString(std::string_view contents, int compression_level) {
+    std::string compressed(ZSTD_compressBound(contents.size()), '\0');
+    size_t const compressedSize =
+        ZSTD_compress(compressed.data(), compressed.size(), contents.data(), contents.size(), compression_level);
+    if (ZSTD_isError(compressedSize)) {
+        std::cerr << "Compression error: " << ZSTD_getErrorName(compressedSize) << std::endl;
+        return std::nullopt;
+    }
+    compressed.resize(compressedSize);
+    return compressed;
+}
+
+bool npeCompressionUtil::isValidCompressionLevel(int compression_level) {
+    return compression_level >= ZSTD_minCLevel() && compression_level <= ZSTD_maxCLevel();
+}
+
+// Buffers writes and feeds them through a zstd compression stream into the file
+class npeCompressedFileStream::ZstdStreamBuf : public std::streambuf {
+public:
+    ZstdStreamBuf(const std::string& filepath, int compression_level, int num_workers, size_t max_frame_size) :
+        filepath(filepath),
+        max_frame_size(max_frame_size),
+        in_buffer(ZSTD_CStreamInSize()),
+        out_buffer(ZSTD_CStreamOutSize()) {
+        outFile.open(filepath, std::ios::binary | std::ios::trunc);
+        if (!outFile) {
+            std::cerr << "Error opening file for writing: " << filepath << std::endl;
+            failed = true;
+            return;
+        }
+
+        cctx = ZSTD_createCCtx();
+        TT_ASSERT(cctx != nullptr, "Failed to create zstd compression context");
+        size_t const result = ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, compression_level);
+        if (ZSTD_isError(result)) {
+            std::cerr << "Error setting compression level: " << ZSTD_getErrorName(result) << std::endl;
+            failed = true;
+            return;
+        }
+        // as in zstd, 0 workers compresses on the calling thread
+        if (num_workers > 0) {
+            size_t const workers_result = ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, num_workers);
+            if (ZSTD_isError(workers_result)) {
+                log_warn(
+                    "Can not compress with {} zstd worker threads ({}); compressing on the calling thread",
+                    num_workers,
+                    ZSTD_getErrorName(workers_result));
+            }
+        }
+
+        setp(in_buffer.data(), in_buffer.data() + in_buffer.size());
+    }
+
+    ~ZstdStreamBuf() override {
+        finish();
+        ZSTD_freeCCtx(cctx);
+    }
+
+    bool finish() {
+        if (finished) {
+            return !failed;
+        }
+        finished = true;
+        if (!failed) {
+            if (isSeekable()) {
+                write(pbase(), pptr() - pbase()) && endFrame() && writeSeekTable();
+            } else {
+                compress(pbase(), pptr() - pbase(), ZSTD_e_end);
+            }
+        }
+        setp(nullptr, nullptr);
+        if (outFile.is_open()) {
+            outFile.close();
+            if (!outFile) {
+                failed = true;
+            }
+        }
+        return !failed;
+    }
+
+    bool hasFailed() const { return failed; }
+
+    std::optional<size_t> writeSkippableFrame(uint32_t variant, std::string_view payload) {
+        if (!drain() || !endFrame()) {
+            return std::nullopt;
+        }
+        TT_ASSERT(variant <= 0xF, "Skippable frame variant must fit in 4 bits");
+        if (payload.size() > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "Skippable frame payload is too large: " << payload.size() << " bytes" << std::endl;
+            failed = true;
+            return std::nullopt;
+        }
+        std::string frame;
+        appendLE32(frame, SKIPPABLE_FRAME_MAGIC | variant);
+        appendLE32(frame, payload.size());
+        frame += payload;
+        size_t payload_offset = file_offset + SKIPPABLE_FRAME_HEADER_SIZE;
+        if (!writeToFile(frame.data(), frame.size())) {
+            return std::nullopt;
+        }
+        if (isSeekable()) {
+            seek_table.push_back({uint32_t(frame.size()), 0});
+        }
+        return payload_offset;
+    }
+
+    std::optional<size_t> endFrameAndGetOffset() {
+        if (!drain() || !endFrame()) {
+            return std::nullopt;
+        }
+        return file_offset;
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!drain()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        // large writes are compressed in place rather than copied through in_buffer
+        if (n < epptr() - pptr()) {
+            return std::streambuf::xsputn(s, n);
+        }
+        if (!drain() || !write(s, n)) {
+            return 0;
+        }
+        return n;
+    }
+
+    int sync() override { return drain() ? 0 : -1; }
+
+private:
+    // compresses all buffered data
+    bool drain() {
+        if (finished || failed) {
+            return false;
+        }
+        bool success = write(pbase(), pptr() - pbase());
+        setp(in_buffer.data(), in_buffer.data() + in_buffer.size());
+        return success;
+    }
+
+    bool isSeekable() const { return max_frame_size > 0; }
+
+    // compresses data, ending frames at max_frame_size boundaries in a seekable file
+    bool write(const char* data, size_t size) {
+        if (!isSeekable()) {
+            return compress(data, size, ZSTD_e_continue);
+        }
+        while (size > 0) {
+            size_t chunk = std::min(size, max_frame_size - frame_decompressed_size);
+            if (!compress(data, chunk, ZSTD_e_continue)) {
+                return false;
+            }
+            data += chunk;
+            size -= chunk;
+            if (frame_decompressed_size == max_frame_size && !endFrame()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // ends the current frame of a seekable file, recording it in the seek table
+    bool endFrame() {
+        if (!isSeekable() || frame_decompressed_size == 0) {
+            return true;
+        }
+        if (!compress(nullptr, 0, ZSTD_e_end)) {
+            return false;
+        }
+        seek_table.push_back({uint32_t(frame_compressed_size), uint32_t(frame_decompressed_size)});
+        frame_compressed_size = 0;
+        frame_decompressed_size = 0;
+        return true;
+    }
+
+    // Appends the seek table as a skippable frame: an entry of (compressed
+    // size, decompressed size) per frame followed by a footer holding the
+    // number of frames, a descriptor (no checksums) and the seekable magic
+    bool writeSeekTable() {
+        std::string frame;
+        appendLE32(frame, SKIPPABLE_FRAME_MAGIC | SEEK_TABLE_FRAME_VARIANT);
+        appendLE32(frame, seek_table.size() * 8 + SEEK_TABLE_FOOTER_SIZE);
+        for (const auto& [compressed_size, decompressed_size] : seek_table) {
+            appendLE32(frame, compressed_size);
+            appendLE32(frame, decompressed_size);
+        }
+        appendLE32(frame, seek_table.size());
+        frame += '\0';
+        appendLE32(frame, SEEKABLE_MAGIC);
+        return writeToFile(frame.data(), frame.size());
+    }
+
+    bool compress(const char* data, size_t size, ZSTD_EndDirective mode) {
+        ZSTD_inBuffer input = {data, size, 0};
+        bool done = false;
+        while (!done) {
+            ZSTD_outBuffer output = {out_buffer.data(), out_buffer.size(), 0};
+            size_t const remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+            if (ZSTD_isError(remaining)) {
+                std::cerr << "Compression error: " << ZSTD_getErrorName(remaining) << std::endl;
+                failed = true;
+                return false;
+            }
+            if (!writeToFile(out_buffer.data(), output.pos)) {
+                return false;
+            }
+            frame_compressed_size += output.pos;
+            // with worker threads, a call may return before consuming all input
+            done = mode == ZSTD_e_end ? remaining == 0 : input.pos == input.size;
+        }
+        frame_decompressed_size += size;
+        return true;
+    }
+
+    bool writeToFile(const char* data, size_t size) {
+        outFile.write(data, size);
+        if (!outFile.good()) {
+            std::cerr << "Error writing compressed data to file: " << filepath << std::endl;
+            failed = true;
+            return false;
+        }
+        file_offset += size;
+        return true;
+    }
+
+    static void appendLE32(std::string& bytes, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            bytes += char(value >> (8 * i));
+        }
+    }
+
+    static constexpr size_t SKIPPABLE_FRAME_HEADER_SIZE = 8;
+    static constexpr size_t SEEK_TABLE_FOOTER_SIZE = 9;
+
+    std::string filepath;
+    size_t max_frame_size;
+    size_t frame_decompressed_size = 0;
+    size_t frame_compressed_size = 0;
+    size_t file_offset = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> seek_table;
+    std::ofstream outFile;
+    ZSTD_CCtx* cctx = nullptr;
+    std::vector<char> in_buffer;
+    std::vector<char> out_buffer;
+    bool failed = false;
+    bool finished = false;
+};
+
+npeCompressedFileStream::npeCompressedFileStream(
+    const std::string& filepath, int compression_level, int num_workers, size_t max_frame_size) :
+    std::ostream(nullptr),
+    buf(std::make_unique<ZstdStreamBuf>(filepath, compression_level, num_workers, max_frame_size)) {
+    rdbuf(buf.get());
+    if (buf->hasFailed()) {
+        setstate(std::ios::badbit);
+    }
+}
+
+npeCompressedFileStream::~npeCompressedFileStream() { close(); }
+
+std::optional<size_t> npeCompressedFileStream::writeSkippableFrame(uint32_t variant, std::string_view payload) {
+    flush();
+    auto payload_offset = buf->writeSkippableFrame(variant, payload);
+    if (!payload_offset.has_value()) {
+        setstate(std::ios::badbit);
+    }
+    return payload_offset;
+}
+
+std::optional<size_t> npeCompressedFileStream::endFrame() {
+    flush();
+    auto frame_offset = buf->endFrameAndGetOffset();
+    if (!frame_offset.has_value()) {
+        setstate(std::ios::badbit);
+    }
+    return frame_offset;
+}
+
+bool npeCompressedFileStream::close() {
+    if (!buf->finish()) {
+        setstate(std::ios::badbit);
+        return false;
+    }
+    return good();
+}
 } // namespace tt_npe
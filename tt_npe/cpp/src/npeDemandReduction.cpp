@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#include "npeDemandReduction.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "npeAssert.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define NPE_X86_SIMD 1
+#endif
+
+namespace tt_npe {
+
+void DemandReduction::merge(const DemandReduction &other) {
+    for (size_t t = 0; t < NUM_TYPES; t++) {
+        demand_sum[t] += other.demand_sum[t];
+        util_sum[t] += other.util_sum[t];
+        mcast_write_util_sum[t] += other.mcast_write_util_sum[t];
+        max_demand[t] = std::fmax(max_demand[t], other.max_demand[t]);
+    }
+}
+
+double DemandReduction::totalDemand() const {
+    return demand_sum[0] + demand_sum[1] + demand_sum[2] + demand_sum[3];
+}
+double DemandReduction::totalUtil() const {
+    return util_sum[0] + util_sum[1] + util_sum[2] + util_sum[3];
+}
+double DemandReduction::totalMcastWriteUtil() const {
+    return mcast_write_util_sum[0] + mcast_write_util_sum[1] + mcast_write_util_sum[2] +
+           mcast_write_util_sum[3];
+}
+float DemandReduction::maxDemand() const {
+    return std::fmax(std::fmax(max_demand[0], max_demand[1]), std::fmax(max_demand[2], max_demand[3]));
+}
+
+SimdLevel getSupportedSimdLevel() {
+    static const SimdLevel supported_simd_level = []() {
+#ifdef NPE_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::AVX512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::AVX2;
+        }
+#endif
+        return SimdLevel::SCALAR;
+    }();
+    return supported_simd_level;
+}
+
+namespace {
+
+constexpr size_t NUM_TYPES = DemandReduction::NUM_TYPES;
+
+// Each kernel accumulates into one lane per demand type. Sums are kept in
+// double precision like the scalar stats code. The SIMD kernels add values in
+// a different order than the scalar loop, so their sums can differ from it in
+// the last few bits.
+template <bool WITH_UTIL>
+DemandReduction reduceScalar(const float *demand, const float *mcast_demand, size_t n, float max_bw) {
+    DemandReduction r;
+    for (size_t i = 0; i < n; i += NUM_TYPES) {
+        for (size_t t = 0; t < NUM_TYPES; t++) {
+            float d = demand[i + t];
+            r.demand_sum[t] += d;
+            r.max_demand[t] = std::max(r.max_demand[t], d);
+            if constexpr (WITH_UTIL) {
+                r.util_sum[t] += std::min(d, max_bw);
+                r.mcast_write_util_sum[t] += std::min(mcast_demand[i + t], max_bw);
+            }
+        }
+    }
+    return r;
+}
+
+#ifdef NPE_X86_SIMD
+// widens float lanes to double and adds them to sum
+__attribute__((target("avx2"))) inline void accumulate(__m256d &sum, __m256 v) {
+    sum = _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+    sum = _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+}
+__attribute__((target("avx512f"))) inline void accumulate(__m512d &sum, __m512 v) {
+    sum = _mm512_add_pd(sum, _mm512_cvtps_pd(_mm512_castps512_ps256(v)));
+    sum = _mm512_add_pd(
+        sum, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1))));
+}
+
+// 4 double lanes hold one coordinate's worth of types; 8 float lanes hold two
+template <bool WITH_UTIL>
+__attribute__((target("avx2"))) DemandReduction reduceAVX2(
+    const float *demand, const float *mcast_demand, size_t n, float max_bw) {
+    __m256d demand_sum = _mm256_setzero_pd();
+    __m256d util_sum = _mm256_setzero_pd();
+    __m256d mcast_util_sum = _mm256_setzero_pd();
+    __m256 max_demand = _mm256_setzero_ps();
+    const __m256 bw = _mm256_set1_ps(max_bw);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 d = _mm256_loadu_ps(demand + i);
+        accumulate(demand_sum, d);
+        max_demand = _mm256_max_ps(max_demand, d);
+        if constexpr (WITH_UTIL) {
+            accumulate(util_sum, _mm256_min_ps(d, bw));
+            accumulate(mcast_util_sum, _mm256_min_ps(_mm256_loadu_ps(mcast_demand + i), bw));
+        }
+    }
+
+    alignas(32) double lanes[3][4];
+    alignas(32) float max_lanes[8];
+    _mm256_store_pd(lanes[0], demand_sum);
+    _mm256_store_pd(lanes[1], util_sum);
+    _mm256_store_pd(lanes[2], mcast_util_sum);
+    _mm256_store_ps(max_lanes, max_demand);
+    // the scalar tail zero-fills with rep stos, which is very slow while the
+    // upper vector state is dirty
+    _mm256_zeroupper();
+
+    DemandReduction r = reduceScalar<WITH_UTIL>(
+        demand + i, WITH_UTIL ? mcast_demand + i : nullptr, n - i, max_bw);
+    for (size_t t = 0; t < NUM_TYPES; t++) {
+        r.demand_sum[t] += lanes[0][t];
+        r.util_sum[t] += lanes[1][t];
+        r.mcast_write_util_sum[t] += lanes[2][t];
+        r.max_demand[t] =
+            std::fmax(r.max_demand[t], std::fmax(max_lanes[t], max_lanes[t + NUM_TYPES]));
+    }
+    return r;
+}
+
+// 8 double lanes hold two coordinates' worth of types; 16 float lanes hold four
+template <bool WITH_UTIL>
+__attribute__((target("avx512f"))) DemandReduction reduceAVX512(
+    const float *demand, const float *mcast_demand, size_t n, float max_bw) {
+    __m512d demand_sum = _mm512_setzero_pd();
+    __m512d util_sum = _mm512_setzero_pd();
+    __m512d mcast_util_sum = _mm512_setzero_pd();
+    __m512 max_demand = _mm512_setzero_ps();
+    const __m512 bw = _mm512_set1_ps(max_bw);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 d = _mm512_loadu_ps(demand + i);
+        accumulate(demand_sum, d);
+        max_demand = _mm512_max_ps(max_demand, d);
+        if constexpr (WITH_UTIL) {
+            accumulate(util_sum, _mm512_min_ps(d, bw));
+            accumulate(mcast_util_sum, _mm512_min_ps(_mm512_loadu_ps(mcast_demand + i), bw));
+        }
+    }
+
+    alignas(64) double lanes[3][8];
+    alignas(64) float max_lanes[16];
+    _mm512_store_pd(lanes[0], demand_sum);
+    _mm512_store_pd(lanes[1], util_sum);
+    _mm512_store_pd(lanes[2], mcast_util_sum);
+    _mm512_store_ps(max_lanes, max_demand);
+    _mm256_zeroupper();
+
+    DemandReduction r = reduceScalar<WITH_UTIL>(
+        demand + i, WITH_UTIL ? mcast_demand + i : nullptr, n - i, max_bw);
+    for (size_t t = 0; t < NUM_TYPES; t++) {
+        r.demand_sum[t] += lanes[0][t] + lanes[0][t + NUM_TYPES];
+        r.util_sum[t] += lanes[1][t] + lanes[1][t + NUM_TYPES];
+        r.mcast_write_util_sum[t] += lanes[2][t] + lanes[2][t + NUM_TYPES];
+        for (size_t lane = t; lane < 16; lane += NUM_TYPES) {
+            r.max_demand[t] = std::fmax(r.max_demand[t], max_lanes[lane]);
+        }
+    }
+    return r;
+}
+#endif
+
+template <bool WITH_UTIL>
+DemandReduction reduce(
+    const float *demand, const float *mcast_demand, size_t n, float max_bw, SimdLevel simd_level) {
+    TT_ASSERT(n % NUM_TYPES == 0, "Demand block size {} is not a multiple of {}", n, NUM_TYPES);
+#ifdef NPE_X86_SIMD
+    TT_ASSERT(simd_level <= getSupportedSimdLevel(), "Requested SIMD level is not supported");
+    switch (simd_level) {
+        case SimdLevel::AVX512: return reduceAVX512<WITH_UTIL>(demand, mcast_demand, n, max_bw);
+        case SimdLevel::AVX2: return reduceAVX2<WITH_UTIL>(demand, mcast_demand, n, max_bw);
+        case SimdLevel::SCALAR: break;
+    }
+#endif
+    return reduceScalar<WITH_UTIL>(demand, mcast_demand, n, max_bw);
+}
+
+}  // namespace
+
+DemandReduction reduceLinkDemand(
+    std::span<const float> link_demand,
+    std::span<const float> mcast_write_link_demand,
+    float max_link_bandwidth,
+    SimdLevel simd_level) {
+    TT_ASSERT(link_demand.size() == mcast_write_link_demand.size());
+    return reduce<true>(
+        link_demand.data(),
+        mcast_write_link_demand.data(),
+        link_demand.size(),
+        max_link_bandwidth,
+        simd_level);
+}
+
+DemandReduction reduceNIUDemand(std::span<const float> niu_demand, SimdLevel simd_level) {
+    return reduce<false>(niu_demand.data(), nullptr, niu_demand.size(), 0, simd_level);
+}
+
+}  // namespace tt_npe
@@ -3,6 +3,7 @@
 
 #include "npeEngine.hpp"
 
+#include <limits>
 #include <map>
 
 #include "ScopedTimer.hpp"
@@ -22,7 +23,8 @@ npeEngine::npeEngine(const std::string &device_name) {
     model = npeDeviceModelFactory::createDeviceModel(device_name);
 }
 
-std::vector<PETransferState> npeEngine::initTransferState(const npeWorkload &wl) const {
+std::vector<PETransferState> npeEngine::initTransferState(
+    const npeWorkload &wl, nocRouteArena &route_arena) const {
     // construct flat vector of all transfers from workload
     size_t num_transfers = 0;
     for (const auto &ph : wl.getPhases()) {
@@ -31,6 +33,7 @@ std::vector<PETransferState> npeEngine::initTransferState(const npeWorkload &wl)
 
     std::vector<PETransferState> transfer_state;
     transfer_state.resize(num_transfers);
+    std::vector<nocRouteArena::RouteRef> routes(num_transfers);
 
     for (const auto &ph : wl.getPhases()) {
         for (const auto &wl_transfer : ph.transfers) {
@@ -39,29 +42,20 @@ std::vector<PETransferState> npeEngine::initTransferState(const npeWorkload &wl)
                 wl_transfer,
                 // assume all phases start at cycle 0
                 wl_transfer.phase_cycle_offset,
-                model->route(wl_transfer.noc_type, wl_transfer.src, wl_transfer.dst));
+                nocRouteView{});
+            routes[wl_transfer.getID()] = route_arena.addRoute([&](nocRoute &route) {
+                model->appendRoute(wl_transfer.noc_type, wl_transfer.src, wl_transfer.dst, route);
+            });
+            resolveTransferNIUs(*model, transfer_state[wl_transfer.getID()]);
         }
     }
 
-    return transfer_state;
-}
-
-std::vector<npeEngine::TransferQueuePair> npeEngine::createTransferQueue(
-    const std::vector<PETransferState> &transfer_state) const {
-    std::vector<TransferQueuePair> transfer_queue;
-    for (auto &tr : transfer_state) {
-        transfer_queue.push_back({tr.params.phase_cycle_offset, tr.params.getID()});
+    // views into the arena are only stable once every route has been added
+    for (size_t id = 0; id < num_transfers; id++) {
+        transfer_state[id].route = route_arena.getRoute(routes[id]);
     }
-    // sort transfer_queue from greatest to least cycle count
-    // sim loop will pop transfers that are ready off the end
-    std::stable_sort(
-        transfer_queue.begin(),
-        transfer_queue.end(),
-        [](const TransferQueuePair &lhs, const TransferQueuePair &rhs) {
-            return std::make_pair(lhs.start_cycle, lhs.id) >
-                   std::make_pair(rhs.start_cycle, rhs.id);
-        });
-    return transfer_queue;
+
+    return transfer_state;
 }
 
 npeTransferDependencyTracker npeEngine::genDependencies(
@@ -79,11 +73,11 @@ npeTransferDependencyTracker npeEngine::genDependencies(
     for (auto &tr : transfer_state) {
         int link_type = (tr.route.size() > 0)
                             ? int(model->getLinkAttributes(tr.route[0]).type)
-                            : (tr.params.noc_type == nocType::NOC0 ? LOCAL_NOC0_TRANSFER_TYPE
+                            : (tr.params->noc_type == nocType::NOC0 ? LOCAL_NOC0_TRANSFER_TYPE
                                                                    : LOCAL_NOC1_TRANSFER_TYPE);
 
-        bucketed_transfers[{tr.params.noc_type, tr.params.src.row, tr.params.src.col, link_type}]
-            .push_back(tr.params.getID());
+        bucketed_transfers[{tr.params->noc_type, tr.params->src.row, tr.params->src.col, link_type}]
+            .push_back(tr.params->getID());
     }
 
     for (auto &[niu, transfers] : bucketed_transfers) {
@@ -117,33 +111,33 @@ npeTransferDependencyTracker npeEngine::genDependencies(
     boost::unordered_flat_map<std::pair<npeWorkloadTransferGroupID, npeWorkloadTransferGroupIndex>, 
         PETransferID> transfer_group_and_index_to_id;
     for (const auto &tr : transfer_state) {
-        if (tr.params.transfer_group_id != -1 && tr.params.transfer_group_index != -1) {
-            transfer_group_and_index_to_id[{tr.params.transfer_group_id, tr.params.transfer_group_index}] = tr.params.getID();
+        if (tr.params->transfer_group_id != -1 && tr.params->transfer_group_index != -1) {
+            transfer_group_and_index_to_id[{tr.params->transfer_group_id, tr.params->transfer_group_index}] = tr.params->getID();
         }
     }
 
     for (const auto &tr : transfer_state) {
-        if (tr.params.transfer_group_id != -1 && tr.params.transfer_group_parent != -1) {
-            auto id = tr.params.getID();
-            auto parent_id = transfer_group_and_index_to_id[{tr.params.transfer_group_id, tr.params.transfer_group_parent}];
+        if (tr.params->transfer_group_id != -1 && tr.params->transfer_group_parent != -1) {
+            auto id = tr.params->getID();
+            auto parent_id = transfer_group_and_index_to_id[{tr.params->transfer_group_id, tr.params->transfer_group_parent}];
             Cycle checkpoint_delay = 0;
 
             switch (model->getArch()) {
                 case DeviceArch::WormholeB0:
-                    checkpoint_delay += WormholeB0DeviceModel::get_write_latency(tr.params.src.col, tr.params.src.row, 
-                        std::get<Coord>(tr.params.dst).col, std::get<Coord>(tr.params.dst).row, tr.params.noc_type == nocType::NOC0 ? "NOC_0" : "NOC_1");
+                    checkpoint_delay += WormholeB0DeviceModel::get_write_latency(tr.params->src.col, tr.params->src.row, 
+                        std::get<Coord>(tr.params->dst).col, std::get<Coord>(tr.params->dst).row, tr.params->noc_type == nocType::NOC0 ? "NOC_0" : "NOC_1");
                     break;
                 case DeviceArch::Blackhole:
-                    checkpoint_delay += BlackholeDeviceModel::get_write_latency(tr.params.src.col, tr.params.src.row, 
-                        std::get<Coord>(tr.params.dst).col, std::get<Coord>(tr.params.dst).row, tr.params.noc_type == nocType::NOC0 ? "NOC_0" : "NOC_1");
+                    checkpoint_delay += BlackholeDeviceModel::get_write_latency(tr.params->src.col, tr.params->src.row, 
+                        std::get<Coord>(tr.params->dst).col, std::get<Coord>(tr.params->dst).row, tr.params->noc_type == nocType::NOC0 ? "NOC_0" : "NOC_1");
                 default:
                     log_error("Unsupported architecture: {}", static_cast<unsigned char>(model->getArch()));
                     throw npeException(npeErrorCode::DEPENDENCY_GEN_FAILED);
             }
 
             // Only add ethernet hop delay if this is not a fabric mux route (i.e. the route is on a different device to previous)
-            if (tr.params.src.device_id != transfer_state[parent_id].params.src.device_id) {
-                checkpoint_delay += ETH_HOP_CYCLE_DELAY_BASE + ETH_HOP_CYCLE_DELAY_PER_BYTE*tr.params.packet_size;
+            if (tr.params->src.device_id != transfer_state[parent_id].params->src.device_id) {
+                checkpoint_delay += ETH_HOP_CYCLE_DELAY_BASE + ETH_HOP_CYCLE_DELAY_PER_BYTE*tr.params->packet_size;
             }
             
             npeCheckpointID chkpt_id = dep_tracker.createCheckpoint(1, checkpoint_delay);
@@ -169,6 +163,49 @@ npeTransferDependencyTracker npeEngine::genDependencies(
     return dep_tracker;
 }
 
+Timestep npeEngine::getNumSteadyStateTimesteps(
+    const PETransferHotState &transfer_state,
+    const std::vector<PETransferID> &live_transfer_ids,
+    npeTransferDependencyTracker &dep_tracker,
+    std::optional<Cycle> next_activation_cycle,
+    Cycle curr_cycle,
+    Cycle cycles_per_timestep) const {
+    Cycle start_of_timestep = curr_cycle - cycles_per_timestep;
+
+    // steady state ends with the timestep in which the next transfer activates
+    Timestep num_timesteps = std::numeric_limits<Timestep>::max();
+    if (next_activation_cycle.has_value()) {
+        if (next_activation_cycle.value() <= curr_cycle + cycles_per_timestep) {
+            return 0;
+        }
+        num_timesteps =
+            (next_activation_cycle.value() - curr_cycle + cycles_per_timestep - 1) /
+                cycles_per_timestep -
+            1;
+    }
+
+    for (auto ltid : live_transfer_ids) {
+        npeCheckpointID depends_on = transfer_state.depends_on[ltid];
+
+        // transfers that were not active for the whole timestep (or whose
+        // dependency completed recently) progress differently next timestep
+        if (transfer_state.start_cycle[ltid] > start_of_timestep ||
+            (dep_tracker.defined(depends_on) &&
+             dep_tracker.end_cycle(depends_on) >= start_of_timestep)) {
+            return 0;
+        }
+
+        // steady state ends with the timestep in which the first transfer completes
+        size_t bytes_per_timestep = cycles_per_timestep * transfer_state.curr_bandwidth[ltid];
+        if (bytes_per_timestep > 0) {
+            size_t remaining_bytes =
+                transfer_state.total_bytes[ltid] - transfer_state.total_bytes_transferred[ltid];
+            num_timesteps = std::min<Timestep>(num_timesteps, (remaining_bytes - 1) / bytes_per_timestep);
+        }
+    }
+    return num_timesteps;
+}
+
 npeResult npeEngine::runPerfEstimation(const npeWorkload &wl, const npeConfig &cfg) const {
     if (cfg.estimate_cong_impact) {
         // first run with default cfg settings; return early if a failure occurs
@@ -201,22 +238,39 @@ npeResult npeEngine::runPerfEstimation(const npeWorkload &wl, const npeConfig &c
 
 npeResult npeEngine::runSinglePerfSim(const npeWorkload &wl, const npeConfig &cfg) const {
     ScopedTimer timer("",true);
-    npeStats stats(model.get());
+    npeStats stats(model.get(), &wl);
 
     // setup congestion tracking data structures
     bool enable_congestion_model = cfg.congestion_model_name != "none";
     // Initialize device state with appropriate dimensions for this device model
     auto device_state = model->initDeviceState();
 
-    // create flattened list of transfers from workload
-    auto transfer_state = initTransferState(wl);
-
-    // create sorted queue of transfers to dispatch in main sim loop
-    std::vector<TransferQueuePair> transfer_queue = createTransferQueue(transfer_state);
+    // create flattened list of transfers from workload; routes are interned
+    // into route_arena, which must outlive transfer_state
+    nocRouteArena route_arena;
+    auto transfer_state = initTransferState(wl, route_arena);
 
     // setup transfer dependencies within a single NIU
     npeTransferDependencyTracker dep_tracker = genDependencies(transfer_state);
 
+    // queue transfers for dispatch in main sim loop; dep_tracker releases each
+    // transfer once its start cycle has passed and its dependency is done
+    for (const auto &tr : transfer_state) {
+        dep_tracker.addDependent(tr.depends_on, tr.params->getID(), tr.params->phase_cycle_offset);
+    }
+    size_t num_queued_transfers = transfer_state.size();
+
+    // per-timestep state of every transfer is kept in SoA form during simulation
+    PETransferHotState hot_state(transfer_state);
+
+    // resolve device of every link and NIU once for per-device stats bucketing
+    SimulationStatsLookup stats_lookup(
+        *model,
+        stats,
+        device_state->getLinkDemandGrid().size(),
+        device_state->getNIUDemandGrid().size(),
+        cfg.emit_timeline_file);
+
     // main simulation loop
     std::vector<PETransferID> live_transfer_ids;
     live_transfer_ids.reserve(transfer_state.size());
@@ -231,34 +285,23 @@ npeResult npeEngine::runSinglePerfSim(const npeWorkload &wl, const npeConfig &cf
 
         stats.insertTimestep(start_of_timestep, curr_cycle, wl);
 
-        // transfer now-active transfers to live_transfers
-        int transfers_activated = 0;
-        size_t swap_pos = transfer_queue.size() - 1;
-        for (int i = swap_pos; i >= 0 && transfer_queue[i].start_cycle <= curr_cycle; i--) {
-            const auto &transfer = transfer_state[transfer_queue[i].id];
-            if (dep_tracker.done(transfer.depends_on, curr_cycle)) {
-                live_transfer_ids.push_back(transfer_queue[i].id);
-
-                // if dependency is defined, adjust transfer start_cycle to be after dependency was completed
-                if (dep_tracker.defined(transfer.depends_on)) {
-                    transfer_state[transfer_queue[i].id].start_cycle = std::max(
-                        transfer_state[transfer_queue[i].id].start_cycle,
-                        dep_tracker.end_cycle_plus_delay(transfer.depends_on));
-                }
-
-                // move inserted element to the end of the transfer_queue to be discarded afterwards
-                std::swap(transfer_queue[swap_pos--], transfer_queue[i]);
-                transfers_activated++;
-            }
+        // transfer now-active transfers to live_transfers, adjusting their
+        // start_cycle to be after their dependency was completed. Transfers
+        // go live in (release cycle, id) order; demand on shared links is
+        // summed in live order, so this order affects the last bits of the
+        // demand stats.
+        while (auto ready = dep_tracker.popReady(curr_cycle)) {
+            auto [id, release_cycle] = ready.value();
+            live_transfer_ids.push_back(id);
+            hot_state.start_cycle[id] = release_cycle;
+            transfer_state[id].live_start_cycle = start_of_timestep;
+            num_queued_transfers--;
         }
 
-        // discard now inactive transfers from the end of the queue
-        transfer_queue.resize(transfer_queue.size() - transfers_activated);
-
         model->computeCurrentTransferRate(
             start_of_timestep,
             curr_cycle,
-            transfer_state,
+            hot_state,
             live_transfer_ids,
             *device_state,
             enable_congestion_model);
@@ -266,71 +309,79 @@ npeResult npeEngine::runSinglePerfSim(const npeWorkload &wl, const npeConfig &cf
         // update stats
         updateSimulationStats(
             *model,
+            stats_lookup,
             device_state->getLinkDemandGrid(),
             device_state->getMulticastWriteLinkDemandGrid(),
-            device_state->getNIUDemandGrid(),
-            live_transfer_ids,
-            stats
+            device_state->getNIUDemandGrid()
         );
 
         // Update all live transfer state
         for (auto ltid : live_transfer_ids) {
-            auto &lt = transfer_state[ltid];
-            TT_ASSERT(dep_tracker.done(lt.depends_on, curr_cycle));
+            npeCheckpointID depends_on = hot_state.depends_on[ltid];
+            Cycle start_cycle = hot_state.start_cycle[ltid];
+            float curr_bandwidth = hot_state.curr_bandwidth[ltid];
+            size_t &total_bytes_transferred = hot_state.total_bytes_transferred[ltid];
+            TT_ASSERT(dep_tracker.done(depends_on, curr_cycle));
 
-            size_t remaining_bytes = lt.params.total_bytes - lt.total_bytes_transferred;
+            size_t remaining_bytes = hot_state.total_bytes[ltid] - total_bytes_transferred;
             Cycle cycles_active_in_curr_timestep =
-                std::min(cfg.cycles_per_timestep, curr_cycle - lt.start_cycle);
-            if (lt.depends_on != npeTransferDependencyTracker::UNDEFINED_CHECKPOINT) {
-                auto dep_end_cycle = dep_tracker.end_cycle(lt.depends_on);
-                if (lt.start_cycle < start_of_timestep && in_prev_timestep(dep_end_cycle)) {
-                    auto adjusted_start = std::max(lt.start_cycle, dep_end_cycle);
+                std::min(cfg.cycles_per_timestep, curr_cycle - start_cycle);
+            if (depends_on != npeTransferDependencyTracker::UNDEFINED_CHECKPOINT) {
+                auto dep_end_cycle = dep_tracker.end_cycle(depends_on);
+                if (start_cycle < start_of_timestep && in_prev_timestep(dep_end_cycle)) {
+                    auto adjusted_start = std::max(start_cycle, dep_end_cycle);
                     cycles_active_in_curr_timestep = curr_cycle - adjusted_start;
                     TT_ASSERT(cycles_active_in_curr_timestep >= cfg.cycles_per_timestep);
                     TT_ASSERT(cycles_active_in_curr_timestep <= 2 * cfg.cycles_per_timestep);
                 }
             }
-            size_t max_transferrable_bytes = cycles_active_in_curr_timestep * lt.curr_bandwidth;
+            size_t max_transferrable_bytes = cycles_active_in_curr_timestep * curr_bandwidth;
 
             // bytes actually transferred may be limited by remaining bytes in the
             // transfer
             size_t bytes_transferred = std::min(remaining_bytes, max_transferrable_bytes);
-            lt.total_bytes_transferred += bytes_transferred;
+            total_bytes_transferred += bytes_transferred;
 
             // compute cycle where transfer ended
-            if (lt.params.total_bytes == lt.total_bytes_transferred) {
-                float cycles_transferring = std::ceil(bytes_transferred / float(lt.curr_bandwidth));
+            if (hot_state.isComplete(ltid)) {
+                float cycles_transferring = std::ceil(bytes_transferred / float(curr_bandwidth));
                 // account for situations when transfer starts and ends within a
                 // single timestep!
                 Cycle start_cycle_of_transfer_within_timestep =
-                    std::max(lt.start_cycle, start_of_timestep);
+                    std::max(start_cycle, start_of_timestep);
                 Cycle transfer_end_cycle =
                     start_cycle_of_transfer_within_timestep + cycles_transferring;
-                lt.end_cycle = transfer_end_cycle;
+                hot_state.end_cycle[ltid] = transfer_end_cycle;
+
+                // completed transfers are only read from cold state from here on
+                auto &lt = transfer_state[ltid];
+                hot_state.writeBack(ltid, lt);
+                lt.live_end_cycle = curr_cycle;
 
                 for (auto chkpt_id : lt.required_by) {
                     dep_tracker.updateCheckpoint(chkpt_id, transfer_end_cycle);
                 }
 
                 // update worst case transfer end cycle for device and mesh device
-                stats.updateWorstCaseTransferEndCycle(lt.params.src.device_id, lt, wl.getGoldenResultCycles(lt.params.src.device_id));
+                stats.updateWorstCaseTransferEndCycle(lt.params->src.device_id, lt, wl.getGoldenResultCycles(lt.params->src.device_id));
                 stats.updateWorstCaseTransferEndCycle(MESH_DEVICE, lt, wl.getGoldenResultCycles(MESH_DEVICE));
             }
         }
 
         // compact live transfer list, removing completed transfers
-        auto transfer_complete = [&transfer_state](const PETransferID id) {
-            return transfer_state[id].total_bytes_transferred ==
-                   transfer_state[id].params.total_bytes;
+        auto transfer_complete = [&hot_state](const PETransferID id) {
+            return hot_state.isComplete(id);
         };
+        size_t num_live_transfers = live_transfer_ids.size();
         live_transfer_ids.erase(
             std::remove_if(live_transfer_ids.begin(), live_transfer_ids.end(), transfer_complete),
             live_transfer_ids.end());
+        bool live_transfers_unchanged = live_transfer_ids.size() == num_live_transfers;
 
         // TODO: if new phase is unlocked, add phase transfer's to tr_queue
 
         // end sim loop if all transfers have been completed
-        if (live_transfer_ids.size() == 0 and transfer_queue.size() == 0) {
+        if (live_transfer_ids.size() == 0 and num_queued_transfers == 0) {
             if (!dep_tracker.sanityCheck() || !dep_tracker.allComplete()) {
                 log_error("Some dependencies not satisfied!");
             }
@@ -347,7 +398,68 @@ npeResult npeEngine::runSinglePerfSim(const npeWorkload &wl, const npeConfig &cf
         }
 
         // Advance time step
-        curr_cycle += cfg.cycles_per_timestep;
+        Cycle next_cycle = curr_cycle + cfg.cycles_per_timestep;
+
+        if (cfg.fast_forward_idle_timesteps && live_transfer_ids.empty()) {
+            // if nothing is in flight, jump directly to the timestep where the
+            // next transfer can activate and record the gap as one idle span
+            auto next_activation_cycle = dep_tracker.nextReleaseCycle();
+            if (!next_activation_cycle.has_value()) {
+                return npeException(
+                    npeErrorCode::DEPENDENCY_DEADLOCK,
+                    fmt::format(
+                        "no live transfers, and none of the {} queued transfers can ever be activated",
+                        num_queued_transfers));
+            }
+
+            // round up to end of the timestep containing the activation cycle
+            Cycle activation_timestep_end_cycle =
+                ((next_activation_cycle.value() + cfg.cycles_per_timestep - 1) /
+                 cfg.cycles_per_timestep) *
+                cfg.cycles_per_timestep;
+            if (activation_timestep_end_cycle > next_cycle) {
+                if (activation_timestep_end_cycle - cfg.cycles_per_timestep > MAX_CYCLE_LIMIT) {
+                    return npeException(npeErrorCode::EXCEEDED_SIM_CYCLE_LIMIT);
+                }
+                stats.insertIdleSpan(
+                    curr_cycle,
+                    activation_timestep_end_cycle - cfg.cycles_per_timestep,
+                    cfg.cycles_per_timestep,
+                    wl);
+                timestep_idx += (activation_timestep_end_cycle - next_cycle) / cfg.cycles_per_timestep;
+                next_cycle = activation_timestep_end_cycle;
+            }
+        } else if (cfg.fast_forward_steady_state && live_transfers_unchanged) {
+            // if the live transfers and their bandwidths will not change, advance
+            // analytically to the timestep where the next transfer completes or
+            // activates, extending the current timestep's stats over the skipped span
+            auto next_activation_cycle = dep_tracker.nextReleaseCycle();
+            Timestep steady_state_timesteps = std::min(
+                getNumSteadyStateTimesteps(
+                    hot_state,
+                    live_transfer_ids,
+                    dep_tracker,
+                    next_activation_cycle,
+                    curr_cycle,
+                    cfg.cycles_per_timestep),
+                stats.maxTimestepRepeats(curr_cycle, cfg.cycles_per_timestep, wl));
+            if (steady_state_timesteps > 0) {
+                if (steady_state_timesteps > (MAX_CYCLE_LIMIT - curr_cycle) / cfg.cycles_per_timestep) {
+                    return npeException(npeErrorCode::EXCEEDED_SIM_CYCLE_LIMIT);
+                }
+                for (auto ltid : live_transfer_ids) {
+                    size_t bytes_per_timestep =
+                        cfg.cycles_per_timestep * hot_state.curr_bandwidth[ltid];
+                    hot_state.total_bytes_transferred[ltid] +=
+                        steady_state_timesteps * bytes_per_timestep;
+                }
+                stats.repeatLastTimestep(steady_state_timesteps, cfg.cycles_per_timestep);
+                timestep_idx += steady_state_timesteps;
+                next_cycle += steady_state_timesteps * cfg.cycles_per_timestep;
+            }
+        }
+
+        curr_cycle = next_cycle;
         timestep_idx++;
     }
 
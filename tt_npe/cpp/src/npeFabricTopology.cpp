@@ -0,0 +1,443 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#include "npeFabricTopology.hpp"
+
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "magic_enum.hpp"
+#include "npeUtil.hpp"
+
+namespace tt_npe {
+
+namespace {
+
+RoutingDirection getInverseDirection(RoutingDirection direction) {
+    switch (direction) {
+        case RoutingDirection::N: return RoutingDirection::S;
+        case RoutingDirection::S: return RoutingDirection::N;
+        case RoutingDirection::E: return RoutingDirection::W;
+        case RoutingDirection::W: return RoutingDirection::E;
+    }
+    return direction;
+}
+
+// modulo that is non-negative for negative lhs, as in Python
+int64_t wrapIndex(int64_t lhs, int64_t rhs) { return ((lhs % rhs) + rhs) % rhs; }
+
+// default noc for route segments between ethernet cores
+constexpr std::string_view FABRIC_NOC_TYPE = "NOC_1";
+
+[[noreturn]] void throwRoutingError(const std::string &msg) {
+    throw npeException(npeErrorCode::TRACE_INGEST_FAILED, msg);
+}
+
+}  // namespace
+
+int64_t npeFabricTopology::getEthChannel(
+    int64_t device, int64_t routing_plane_id, RoutingDirection direction) const {
+    auto it = routing_planes.find({device, routing_plane_id, direction});
+    if (it == routing_planes.end()) {
+        throwRoutingError(fmt::format(
+            "No ethernet channel on device {} in dir {} on routing plane {}",
+            device,
+            magic_enum::enum_name(direction),
+            routing_plane_id));
+    }
+    return it->second;
+}
+
+npeFabricTopology::Coord2D npeFabricTopology::getEthCoord(int64_t eth_chan) const {
+    auto it = eth_chan_to_coord.find(eth_chan);
+    if (it == eth_chan_to_coord.end()) {
+        throwRoutingError(fmt::format("No coordinates for ethernet channel {} in topology", eth_chan));
+    }
+    return it->second;
+}
+
+std::pair<int64_t, RoutingDirection> npeFabricTopology::getNextDeviceInDir(
+    int64_t device, RoutingDirection direction) const {
+    auto node_it = device_id_to_fabric_node_id.find(device);
+    if (node_it == device_id_to_fabric_node_id.end()) {
+        throwRoutingError(fmt::format("Device {} has no fabric node id in topology", device));
+    }
+    auto [mesh_id, chip_id] = node_it->second;
+    auto shape_it = mesh_shapes.find(mesh_id);
+    if (shape_it == mesh_shapes.end()) {
+        throwRoutingError(fmt::format("Mesh {} of device {} has no shape in topology", mesh_id, device));
+    }
+    auto [ns_dim, ew_dim] = shape_it->second;
+    if (chip_id < 0 || chip_id >= ns_dim * ew_dim) {
+        throwRoutingError(fmt::format(
+            "FABRIC NODE ID=({}, {}) is invalid, mesh shape is ({}, {})", mesh_id, chip_id, ns_dim, ew_dim));
+    }
+    int64_t x = chip_id % ew_dim;
+    int64_t y = chip_id / ew_dim;
+
+    // 1D fabric on a T3K wraps around the corners of the mesh; the direction
+    // is corrected to follow the ring
+    bool is_1d = fabric_config == FabricConfig::FABRIC_1D || fabric_config == FabricConfig::FABRIC_1D_RING;
+    if (is_1d && cluster_type == "T3K") {
+        bool left = x == 0, right = x == ew_dim - 1, top = y == 0, bottom = y == ns_dim - 1;
+        if (top && left) {
+            if (direction == RoutingDirection::W) direction = RoutingDirection::S;
+            if (direction == RoutingDirection::N) direction = RoutingDirection::E;
+        }
+        if (top && right) {
+            if (direction == RoutingDirection::E) direction = RoutingDirection::S;
+            if (direction == RoutingDirection::N) direction = RoutingDirection::W;
+        }
+        if (bottom && left) {
+            if (direction == RoutingDirection::W) direction = RoutingDirection::N;
+            if (direction == RoutingDirection::S) direction = RoutingDirection::E;
+        }
+        if (bottom && right) {
+            if (direction == RoutingDirection::E) direction = RoutingDirection::N;
+            if (direction == RoutingDirection::S) direction = RoutingDirection::W;
+        }
+    }
+
+    switch (direction) {
+        case RoutingDirection::N: y--; break;
+        case RoutingDirection::S: y++; break;
+        case RoutingDirection::E: x++; break;
+        case RoutingDirection::W: x--; break;
+    }
+    if (fabric_config == FabricConfig::FABRIC_1D_RING || fabric_config == FabricConfig::FABRIC_2D_TORUS) {
+        y = wrapIndex(y, ns_dim);
+        x = wrapIndex(x, ew_dim);
+    }
+    if (x < 0 || x >= ew_dim || y < 0 || y >= ns_dim) {
+        throwRoutingError(fmt::format(
+            "there is no device in direction {} of FABRIC NODE ID=({}, {})",
+            magic_enum::enum_name(direction),
+            mesh_id,
+            chip_id));
+    }
+
+    auto device_it = fabric_node_id_to_device_id.find({mesh_id, y * ew_dim + x});
+    if (device_it == fabric_node_id_to_device_id.end()) {
+        throwRoutingError(fmt::format("FABRIC NODE ID=({}, {}) has no device", mesh_id, y * ew_dim + x));
+    }
+    return {device_it->second, direction};
+}
+
+// Adds the segments from the source worker to the first ethernet router of
+// the send (via the fabric mux, if any), then moves the path to the device
+// the first router sends to
+npeFabricTopology::PathBuilder npeFabricTopology::startPath(NocTraceEvent &event, NocTraceEventBatch &batch) const {
+    const auto &routing = event.fabric_routing;
+    int64_t src_device = event.src_device_id;
+    if (!routing.eth_chan.has_value()) {
+        throwRoutingError(fmt::format("Fabric send on device {} is missing 'eth_chan'", src_device));
+    }
+    if (!event.has_dst) {
+        throwRoutingError(fmt::format("Fabric send on device {} is missing 'dst'", src_device));
+    }
+    int64_t eth_chan = *routing.eth_chan;
+    auto first_router_coord = getEthCoord(eth_chan);
+
+    event.fabric_routes_begin = batch.fabric_routes.size();
+    auto add_first_hop_segment = [&](std::string_view noc, Coord2D start, Coord2D forward, int64_t parent_id) {
+        auto &route = batch.fabric_routes.emplace_back();
+        route.noc = noc;
+        route.device = src_device;
+        route.segment_start_x = start.first;
+        route.segment_start_y = start.second;
+        route.forward_x = forward.first;
+        route.forward_y = forward.second;
+        route.parent_id = parent_id;
+    };
+    Coord2D src_coord{event.sx, event.sy};
+    if (routing.has_fabric_mux) {
+        if (routing.fabric_mux_x == -1 || routing.fabric_mux_y == -1 || routing.fabric_mux_noc.empty()) {
+            throwRoutingError(fmt::format("Fabric send on device {} has an incomplete 'fabric_mux'", src_device));
+        }
+        Coord2D mux_coord{routing.fabric_mux_x, routing.fabric_mux_y};
+        add_first_hop_segment(event.noc, src_coord, mux_coord, -1);
+        add_first_hop_segment(routing.fabric_mux_noc, mux_coord, first_router_coord, 0);
+    } else {
+        add_first_hop_segment(event.noc, src_coord, first_router_coord, -1);
+    }
+    event.fabric_routes_end = batch.fabric_routes.size();
+
+    auto plane_it = eth_chan_routing_planes.find({src_device, eth_chan});
+    if (plane_it == eth_chan_routing_planes.end()) {
+        throwRoutingError(fmt::format(
+            "Unable to find associated routing plane and direction for DEV{}, SEND_CHAN{}", src_device, eth_chan));
+    }
+    auto [routing_plane_id, send_direction] = plane_it->second;
+    auto [device, direction] = getNextDeviceInDir(src_device, send_direction);
+    auto receiver_coord = getEthCoord(getEthChannel(device, routing_plane_id, getInverseDirection(direction)));
+    return PathBuilder{event, batch, routing_plane_id, direction, device, receiver_coord};
+}
+
+// Adds a segment for each of the (start_distance + range_devices - 1) devices
+// the send passes through heading in direction, starting from path's device.
+// If terminate is set, the send ends on the last of them, and writes to its
+// destination cores on each of the last range_devices devices.
+void npeFabricTopology::addHops(
+    PathBuilder &path,
+    int64_t start_distance,
+    int64_t range_devices,
+    RoutingDirection direction,
+    bool terminate,
+    int64_t parent_id) const {
+    auto &event = path.event;
+    int64_t total_hops = start_distance + range_devices - 1;
+    for (int64_t hop = 1; hop <= total_hops; hop++) {
+        NocTraceFabricRoute route;
+        route.noc = FABRIC_NOC_TYPE;
+        route.device = path.device;
+        route.segment_start_x = path.receiver_coord.first;
+        route.segment_start_y = path.receiver_coord.second;
+        route.parent_id = parent_id;
+
+        // forward to the next device
+        if (hop < total_hops || !terminate) {
+            auto [next_device, next_direction] = getNextDeviceInDir(path.device, direction);
+            direction = next_direction;
+            auto forward_coord = getEthCoord(getEthChannel(path.device, path.routing_plane_id, direction));
+            route.forward_x = forward_coord.first;
+            route.forward_y = forward_coord.second;
+            path.receiver_coord =
+                getEthCoord(getEthChannel(next_device, path.routing_plane_id, getInverseDirection(direction)));
+            path.device = next_device;
+        }
+
+        if (hop >= start_distance && terminate) {
+            route.has_local_writes = true;
+            route.local_writes_begin = event.dst_begin;
+            route.local_writes_end = event.dst_end;
+        }
+
+        path.batch.fabric_routes.push_back(route);
+        event.fabric_routes_end = path.batch.fabric_routes.size();
+        parent_id++;
+    }
+}
+
+void npeFabricTopology::elaborateFabricPath1D(NocTraceEvent &event, NocTraceEventBatch &batch) const {
+    const auto &routing = event.fabric_routing;
+    if (!routing.start_distance.has_value() || !routing.range.has_value()) {
+        throwRoutingError(fmt::format(
+            "Fabric send on device {} is missing 'start_distance' or 'range' for 1D fabric routing",
+            event.src_device_id));
+    }
+    int64_t parent_id = routing.has_fabric_mux ? 1 : 0;
+    auto path = startPath(event, batch);
+    RoutingDirection initial_direction = path.initial_direction;
+    addHops(path, *routing.start_distance, *routing.range, initial_direction, true, parent_id);
+    event.dst_device_id = path.device;
+}
+
+void npeFabricTopology::elaborateFabricPath2D(NocTraceEvent &event, NocTraceEventBatch &batch) const {
+    const auto &routing = event.fabric_routing;
+    if (!routing.ns_hops.has_value() || !routing.e_hops.has_value() || !routing.w_hops.has_value() ||
+        !routing.is_mcast.has_value()) {
+        throwRoutingError(fmt::format(
+            "Fabric send on device {} is missing 'ns_hops', 'e_hops', 'w_hops' or 'is_mcast' for 2D fabric "
+            "routing",
+            event.src_device_id));
+    }
+    int64_t ns_hops = *routing.ns_hops;
+    int64_t e_hops = *routing.e_hops;
+    int64_t w_hops = *routing.w_hops;
+    if (ns_hops == 0 && e_hops == 0 && w_hops == 0) {
+        throwRoutingError("ns_hops, e_hops, and w_hops are all 0");
+    }
+
+    int64_t parent_id = routing.has_fabric_mux ? 1 : 0;
+    auto path = startPath(event, batch);
+    RoutingDirection initial_direction = path.initial_direction;
+
+    if (*routing.is_mcast) {
+        if (ns_hops != 0) {
+            // mcast trunk, then east/west branches
+            addHops(path, 1, ns_hops, initial_direction, true, parent_id);
+            for (int64_t i = 1; i <= ns_hops; i++) {
+                parent_id++;
+                if (e_hops != 0) {
+                    addHops(path, 1, e_hops, RoutingDirection::E, true, parent_id);
+                }
+                if (w_hops != 0) {
+                    addHops(path, 1, w_hops, RoutingDirection::W, true, parent_id);
+                }
+            }
+        } else {
+            // east/west line mcast
+            if (e_hops != 0 && w_hops != 0) {
+                throwRoutingError(fmt::format(
+                    "Both e_hops and w_hops can't be non-zero in E/W line mcast (e_hops={}, w_hops={})",
+                    e_hops,
+                    w_hops));
+            }
+            if (e_hops != 0) {
+                addHops(path, 1, e_hops, RoutingDirection::E, true, parent_id);
+            } else {
+                addHops(path, 1, w_hops, RoutingDirection::W, true, parent_id);
+            }
+        }
+    } else {
+        if (e_hops != 0 && w_hops != 0) {
+            throwRoutingError(fmt::format(
+                "Both e_hops and w_hops can't be non-zero in unicast (e_hops={}, w_hops={})", e_hops, w_hops));
+        }
+        // hop counts are read from the route buffer, where the device a
+        // unicast turns on counts as an east/west hop; dimension order
+        // routing below accounts for this
+        if (initial_direction == RoutingDirection::E || initial_direction == RoutingDirection::W) {
+            int64_t hops = initial_direction == RoutingDirection::E ? e_hops : w_hops;
+            addHops(path, hops, 1, initial_direction, true, parent_id);
+        } else {
+            // north/south hops first, then east/west hops
+            addHops(path, ns_hops, 1, initial_direction, e_hops == 0 && w_hops == 0, parent_id);
+            parent_id += ns_hops;
+            if (e_hops != 0) {
+                addHops(path, e_hops, 1, RoutingDirection::E, true, parent_id);
+            } else if (w_hops != 0) {
+                addHops(path, w_hops, 1, RoutingDirection::W, true, parent_id);
+            }
+        }
+    }
+    event.dst_device_id = path.device;
+}
+
+void npeFabricTopology::elaborateFabricPath(NocTraceEvent &event, NocTraceEventBatch &batch) const {
+    switch (fabric_config) {
+        case FabricConfig::FABRIC_1D:
+        case FabricConfig::FABRIC_1D_RING: elaborateFabricPath1D(event, batch); break;
+        case FabricConfig::FABRIC_2D:
+        case FabricConfig::FABRIC_2D_TORUS: elaborateFabricPath2D(event, batch); break;
+        case FabricConfig::DISABLED:
+            throwRoutingError("Cannot process fabric event for DISABLED fabric config");
+    }
+}
+
+std::optional<npeFabricTopology> npeFabricTopology::readFromFile(const std::string &filepath) {
+    std::ifstream ifs(filepath);
+    if (!ifs.is_open()) {
+        log_error("Failed to open topology file '{}'", filepath);
+        return std::nullopt;
+    }
+
+    auto get_pair = [](const nlohmann::json &value, std::pair<int64_t, int64_t> &pair) {
+        if (!value.is_array() || value.size() != 2 || !value[0].is_number_integer() ||
+            !value[1].is_number_integer()) {
+            return false;
+        }
+        pair = {value[0].get<int64_t>(), value[1].get<int64_t>()};
+        return true;
+    };
+    auto get_int_key = [](const std::string &key, int64_t &value) {
+        size_t pos = 0;
+        try {
+            value = std::stoll(key, &pos);
+        } catch (const std::exception &) {
+            return false;
+        }
+        return pos == key.size();
+    };
+
+    npeFabricTopology topology;
+    try {
+        auto json = nlohmann::json::parse(ifs, nullptr, true, /*ignore_comments=*/true);
+
+        for (const auto &mesh : json.value("mesh_shapes", nlohmann::json::array())) {
+            std::pair<int64_t, int64_t> shape;
+            if (!mesh.contains("mesh_id") || !mesh.contains("shape") || !get_pair(mesh["shape"], shape)) {
+                log_error("Mesh shape has invalid format in topology file '{}': {}", filepath, mesh.dump());
+                return std::nullopt;
+            }
+            topology.mesh_shapes[mesh["mesh_id"].get<int64_t>()] = shape;
+        }
+
+        auto fabric_config_name = json.value("fabric_config", std::string("UNKNOWN"));
+        auto fabric_config = magic_enum::enum_cast<FabricConfig>(fabric_config_name);
+        if (!fabric_config) {
+            log_error("Unsupported fabric config '{}' in topology file '{}'", fabric_config_name, filepath);
+            return std::nullopt;
+        }
+        topology.fabric_config = *fabric_config;
+
+        if (!json.contains("cluster_type") || !json["cluster_type"].is_string()) {
+            log_error("Missing cluster type in topology file '{}'", filepath);
+            return std::nullopt;
+        }
+        topology.cluster_type = json["cluster_type"].get<std::string>();
+
+        if (topology.mesh_shapes.size() > 1) {
+            log_error("Multiple meshes are not currently supported (topology file '{}')", filepath);
+            return std::nullopt;
+        }
+
+        for (const auto &device_routing_planes : json.value("routing_planes", nlohmann::json::array())) {
+            if (!device_routing_planes.contains("device_id")) {
+                log_error("Missing device_id in routing_planes entry of topology file '{}'", filepath);
+                return std::nullopt;
+            }
+            auto device_id = device_routing_planes["device_id"].get<int64_t>();
+            for (const auto &routing_plane :
+                 device_routing_planes.value("device_routing_planes", nlohmann::json::array())) {
+                if (!routing_plane.contains("routing_plane_id")) {
+                    log_error("Missing routing_plane_id in device_routing_planes entry of topology file '{}'", filepath);
+                    return std::nullopt;
+                }
+                auto routing_plane_id = routing_plane["routing_plane_id"].get<int64_t>();
+                const auto &eth_channels = routing_plane.at("ethernet_channels");
+                for (auto direction : {RoutingDirection::N, RoutingDirection::S, RoutingDirection::E, RoutingDirection::W}) {
+                    auto it = eth_channels.find(magic_enum::enum_name(direction));
+                    if (it != eth_channels.end() && !it->is_null()) {
+                        auto eth_chan = it->get<int64_t>();
+                        topology.routing_planes[{device_id, routing_plane_id, direction}] = eth_chan;
+                        // if a channel is listed more than once, its last listing is used
+                        topology.eth_chan_routing_planes[{device_id, eth_chan}] = {routing_plane_id, direction};
+                    }
+                }
+            }
+        }
+
+        auto device_id_to_fabric_node_id = json.value("device_id_to_fabric_node_id", nlohmann::json::object());
+        if (!device_id_to_fabric_node_id.is_object()) {
+            log_error("'device_id_to_fabric_node_id' is not an object in topology file '{}'", filepath);
+            return std::nullopt;
+        }
+        for (const auto &[key, value] : device_id_to_fabric_node_id.items()) {
+            int64_t device_id;
+            FabricNodeID fabric_node_id;
+            if (!get_int_key(key, device_id) || !get_pair(value, fabric_node_id)) {
+                log_error(
+                    "Invalid entry '{}': {} in 'device_id_to_fabric_node_id' of topology file '{}'",
+                    key,
+                    value.dump(),
+                    filepath);
+                return std::nullopt;
+            }
+            topology.device_id_to_fabric_node_id[device_id] = fabric_node_id;
+            topology.fabric_node_id_to_device_id[fabric_node_id] = device_id;
+        }
+
+        auto eth_chan_to_coord = json.value("eth_chan_to_coord", nlohmann::json::object());
+        if (!eth_chan_to_coord.is_object()) {
+            log_error("'eth_chan_to_coord' is not an object in topology file '{}'", filepath);
+            return std::nullopt;
+        }
+        for (const auto &[key, value] : eth_chan_to_coord.items()) {
+            int64_t eth_chan;
+            Coord2D coord;
+            if (!get_int_key(key, eth_chan) || !get_pair(value, coord)) {
+                log_error(
+                    "Invalid entry '{}': {} in 'eth_chan_to_coord' of topology file '{}'", key, value.dump(), filepath);
+                return std::nullopt;
+            }
+            topology.eth_chan_to_coord[eth_chan] = coord;
+        }
+    } catch (const nlohmann::json::exception &e) {
+        log_error("Failed to parse topology file '{}': {}", filepath, e.what());
+        return std::nullopt;
+    }
+    return topology;
+}
+
+}  // namespace tt_npe
@@ -0,0 +1,428 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#include "npeNocTraceReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "npeUtil.hpp"
+
+namespace tt_npe {
+
+namespace {
+
+// overwrites field only if value has the expected type
+template <typename T, typename Field>
+void decodeField(simdjson::simdjson_result<T> value, Field &field) {
+    T val;
+    if (std::move(value).get(val) == simdjson::SUCCESS) {
+        field = val;
+    }
+}
+
+bool isWhitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+// bytes of the UTF-8 byte order mark, which may precede the event array
+bool isByteOrderMark(char c) { return c == '\xEF' || c == '\xBB' || c == '\xBF'; }
+
+simdjson::error_code decodeLocalWrites(simdjson::ondemand::array local_writes, NocTraceEventBatch &batch) {
+    for (auto element : local_writes) {
+        simdjson::ondemand::value value;
+        if (auto error = element.get(value)) {
+            return error;
+        }
+        auto &local_write = batch.local_writes.emplace_back();
+        simdjson::ondemand::object object;
+        if (value.get_object().get(object) != simdjson::SUCCESS) {
+            continue;
+        }
+        for (auto field : object) {
+            std::string_view key;
+            if (auto error = field.unescaped_key().get(key)) {
+                return error;
+            }
+            auto field_value = field.value();
+            if (key == "dx") {
+                decodeField(field_value.get_int64(), local_write.dx);
+            } else if (key == "dy") {
+                decodeField(field_value.get_int64(), local_write.dy);
+            } else if (key == "num_bytes") {
+                decodeField(field_value.get_int64(), local_write.num_bytes);
+            }
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+simdjson::error_code decodeFabricPath(simdjson::ondemand::array path, NocTraceEventBatch &batch) {
+    for (auto element : path) {
+        simdjson::ondemand::value value;
+        if (auto error = element.get(value)) {
+            return error;
+        }
+        auto &route = batch.fabric_routes.emplace_back();
+        simdjson::ondemand::object object;
+        if (value.get_object().get(object) != simdjson::SUCCESS) {
+            continue;
+        }
+        for (auto field : object) {
+            std::string_view key;
+            if (auto error = field.unescaped_key().get(key)) {
+                return error;
+            }
+            auto field_value = field.value();
+            if (key == "noc") {
+                decodeField(field_value.get_string(), route.noc);
+            } else if (key == "device") {
+                decodeField(field_value.get_int64(), route.device);
+            } else if (key == "segment_start_x") {
+                decodeField(field_value.get_int64(), route.segment_start_x);
+            } else if (key == "segment_start_y") {
+                decodeField(field_value.get_int64(), route.segment_start_y);
+            } else if (key == "forward_x") {
+                decodeField(field_value.get_int64(), route.forward_x);
+            } else if (key == "forward_y") {
+                decodeField(field_value.get_int64(), route.forward_y);
+            } else if (key == "parent_id") {
+                decodeField(field_value.get_int64(), route.parent_id);
+            } else if (key == "local_writes") {
+                simdjson::ondemand::array local_writes;
+                if (!route.has_local_writes && field_value.get_array().get(local_writes) == simdjson::SUCCESS) {
+                    route.has_local_writes = true;
+                    route.local_writes_begin = batch.local_writes.size();
+                    if (auto error = decodeLocalWrites(local_writes, batch)) {
+                        return error;
+                    }
+                    route.local_writes_end = batch.local_writes.size();
+                }
+            }
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+simdjson::error_code decodeFabricMux(simdjson::ondemand::object fabric_mux, NocTraceFabricRouting &routing) {
+    for (auto field : fabric_mux) {
+        std::string_view key;
+        if (auto error = field.unescaped_key().get(key)) {
+            return error;
+        }
+        auto field_value = field.value();
+        if (key == "x") {
+            decodeField(field_value.get_int64(), routing.fabric_mux_x);
+        } else if (key == "y") {
+            decodeField(field_value.get_int64(), routing.fabric_mux_y);
+        } else if (key == "noc") {
+            decodeField(field_value.get_string(), routing.fabric_mux_noc);
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+simdjson::error_code decodeFabricSend(
+    simdjson::ondemand::object fabric_send, NocTraceEvent &event, NocTraceEventBatch &batch) {
+    auto &routing = event.fabric_routing;
+    for (auto field : fabric_send) {
+        std::string_view key;
+        if (auto error = field.unescaped_key().get(key)) {
+            return error;
+        }
+        auto field_value = field.value();
+        simdjson::ondemand::array path;
+        simdjson::ondemand::object fabric_mux;
+        if (key == "path" && event.fabric_routes_begin == event.fabric_routes_end &&
+            field_value.get_array().get(path) == simdjson::SUCCESS) {
+            event.fabric_routes_begin = batch.fabric_routes.size();
+            if (auto error = decodeFabricPath(path, batch)) {
+                return error;
+            }
+            event.fabric_routes_end = batch.fabric_routes.size();
+        } else if (key == "eth_chan") {
+            decodeField(field_value.get_int64(), routing.eth_chan);
+        } else if (key == "start_distance") {
+            decodeField(field_value.get_int64(), routing.start_distance);
+        } else if (key == "range") {
+            decodeField(field_value.get_int64(), routing.range);
+        } else if (key == "ns_hops") {
+            decodeField(field_value.get_int64(), routing.ns_hops);
+        } else if (key == "e_hops") {
+            decodeField(field_value.get_int64(), routing.e_hops);
+        } else if (key == "w_hops") {
+            decodeField(field_value.get_int64(), routing.w_hops);
+        } else if (key == "is_mcast") {
+            decodeField(field_value.get_bool(), routing.is_mcast);
+        } else if (
+            key == "fabric_mux" && !routing.has_fabric_mux &&
+            field_value.get_object().get(fabric_mux) == simdjson::SUCCESS) {
+            routing.has_fabric_mux = true;
+            if (auto error = decodeFabricMux(fabric_mux, routing)) {
+                return error;
+            }
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+// Decodes an event, visiting each of its fields once in document order.
+// Values that are not objects decode to an event with default fields.
+simdjson::error_code decodeEvent(simdjson::ondemand::value value, NocTraceEventBatch &batch) {
+    auto &event = batch.events.emplace_back();
+    simdjson::ondemand::object object;
+    if (value.get_object().get(object) != simdjson::SUCCESS) {
+        return simdjson::SUCCESS;
+    }
+    for (auto field : object) {
+        std::string_view key;
+        if (auto error = field.unescaped_key().get(key)) {
+            return error;
+        }
+        auto field_value = field.value();
+        if (key == "proc") {
+            decodeField(field_value.get_string(), event.proc);
+        } else if (key == "noc") {
+            decodeField(field_value.get_string(), event.noc);
+        } else if (key == "sx") {
+            decodeField(field_value.get_int64(), event.sx);
+        } else if (key == "sy") {
+            decodeField(field_value.get_int64(), event.sy);
+        } else if (key == "dx") {
+            decodeField(field_value.get_int64(), event.dx);
+        } else if (key == "dy") {
+            decodeField(field_value.get_int64(), event.dy);
+        } else if (key == "num_bytes") {
+            decodeField(field_value.get_int64(), event.num_bytes);
+        } else if (key == "type") {
+            decodeField(field_value.get_string(), event.type);
+        } else if (key == "timestamp") {
+            decodeField(field_value.get_uint64(), event.timestamp);
+        } else if (key == "src_device_id") {
+            decodeField(field_value.get_int64(), event.src_device_id);
+        } else if (key == "dst_device_id") {
+            decodeField(field_value.get_int64(), event.dst_device_id);
+        } else if (key == "zone") {
+            decodeField(field_value.get_string(), event.zone);
+        } else if (key == "zone_phase") {
+            decodeField(field_value.get_string(), event.zone_phase);
+        } else if (key == "mcast_start_x") {
+            decodeField(field_value.get_int64(), event.mcast_start_x);
+        } else if (key == "mcast_start_y") {
+            decodeField(field_value.get_int64(), event.mcast_start_y);
+        } else if (key == "mcast_end_x") {
+            decodeField(field_value.get_int64(), event.mcast_end_x);
+        } else if (key == "mcast_end_y") {
+            decodeField(field_value.get_int64(), event.mcast_end_y);
+        } else if (key == "dst") {
+            simdjson::ondemand::array dst;
+            if (!event.has_dst && field_value.get_array().get(dst) == simdjson::SUCCESS) {
+                event.has_dst = true;
+                event.dst_begin = batch.local_writes.size();
+                if (auto error = decodeLocalWrites(dst, batch)) {
+                    return error;
+                }
+                event.dst_end = batch.local_writes.size();
+            }
+        } else if (key == "fabric_send") {
+            simdjson::ondemand::object fabric_send;
+            if (!event.has_fabric_send && field_value.get_object().get(fabric_send) == simdjson::SUCCESS) {
+                event.has_fabric_send = true;
+                if (auto error = decodeFabricSend(fabric_send, event, batch)) {
+                    return error;
+                }
+            }
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+// Decodes the events of json, a JSON array of events, into batch
+simdjson::error_code decodeEvents(
+    simdjson::ondemand::parser &parser, const char *json, size_t len, size_t capacity, NocTraceEventBatch &batch) {
+    simdjson::ondemand::document doc;
+    simdjson::ondemand::array events;
+    auto error = parser.iterate(json, len, capacity).get(doc);
+    if (!error) {
+        error = doc.get_array().get(events);
+    }
+    if (!error) {
+        for (auto event : events) {
+            simdjson::ondemand::value value;
+            if ((error = event.get(value)) || (error = decodeEvent(value, batch))) {
+                break;
+            }
+        }
+    }
+    return error;
+}
+
+}  // namespace
+
+npeNocTraceReader::npeNocTraceReader(const std::string &filepath, size_t window_size) :
+    filepath(filepath), file(filepath, std::ios::binary), window_size(window_size) {
+    if (!file) {
+        fail("file could not be opened");
+        return;
+    }
+    // a trace smaller than the window is read whole (the extra byte reaches EOF)
+    std::error_code ec;
+    auto file_size = std::filesystem::file_size(filepath, ec);
+    if (!ec) {
+        this->window_size = std::min<size_t>(window_size, file_size + 1);
+    }
+    buffer.resize(this->window_size + simdjson::SIMDJSON_PADDING);
+}
+
+bool npeNocTraceReader::readBatch(NocTraceEventBatch &batch) {
+    batch.clear();
+    size_t begin, end;
+    if (!nextEvents(begin, end)) {
+        return false;
+    }
+    // parse in place, replacing the separators around the events by brackets
+    buffer[begin - 1] = '[';
+    buffer[end] = ']';
+    if (auto error = decodeEvents(parser, buffer.data() + begin - 1, end - begin + 2, buffer.size() - (begin - 1), batch)) {
+        fail(simdjson::error_message(error));
+        return false;
+    }
+    return true;
+}
+
+bool npeNocTraceReader::readChunk(NocTraceChunk &chunk) {
+    size_t begin, end;
+    if (!nextEvents(begin, end)) {
+        return false;
+    }
+    chunk.size = end - begin + 2;
+    chunk.json.resize(chunk.size + simdjson::SIMDJSON_PADDING);
+    chunk.json[0] = '[';
+    std::memcpy(chunk.json.data() + 1, buffer.data() + begin, end - begin);
+    chunk.json[chunk.size - 1] = ']';
+    return true;
+}
+
+bool npeNocTraceReader::decodeChunk(
+    const NocTraceChunk &chunk, simdjson::ondemand::parser &chunk_parser, NocTraceEventBatch &batch) const {
+    batch.clear();
+    if (auto error = decodeEvents(chunk_parser, chunk.json.data(), chunk.size, chunk.json.size(), batch)) {
+        logError(simdjson::error_message(error));
+        return false;
+    }
+    return true;
+}
+
+// Finds the next run of complete events, buffer[begin, end). The run is
+// preceded and followed by separators (or the brackets of the event array).
+bool npeNocTraceReader::nextEvents(size_t &begin, size_t &end) {
+    while (!failed) {
+        scan();
+        if (failed) {
+            return false;
+        }
+        if (last_separator != NO_SEPARATOR) {
+            begin = data_begin;
+            end = last_separator;
+            last_separator = NO_SEPARATOR;
+            data_begin = end + 1;
+            if (std::all_of(buffer.begin() + begin, buffer.begin() + end, isWhitespace)) {
+                // only an empty event array has no events between separators
+                if (seen_events || !array_closed) {
+                    fail("expected an event between ',' separators");
+                }
+                continue;
+            }
+            seen_events = true;
+            return true;
+        } else if (array_closed || !refill()) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Advances the scan over unscanned data, tracking strings and nesting depth to
+// find the separators between events at the top level of the event array
+void npeNocTraceReader::scan() {
+    for (; scan_pos < data_end && !array_closed; scan_pos++) {
+        char c = buffer[scan_pos];
+        if (in_string) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                in_string = false;
+            }
+        } else if (!array_opened) {
+            if (c == '[') {
+                array_opened = true;
+                depth = 1;
+                data_begin = scan_pos + 1;
+            } else if (!isWhitespace(c) && !isByteOrderMark(c)) {
+                fail("trace is not a JSON array of events");
+                return;
+            }
+        } else {
+            switch (c) {
+                case '"': in_string = true; break;
+                case '{':
+                case '[': depth++; break;
+                case '}':
+                case ']':
+                    if (--depth == 0) {
+                        array_closed = true;
+                        last_separator = scan_pos;
+                    }
+                    break;
+                case ',':
+                    if (depth == 1) {
+                        last_separator = scan_pos;
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+// Discards parsed data and reads more of the file into the window
+bool npeNocTraceReader::refill() {
+    if (at_eof) {
+        fail(array_opened ? "unexpected end of file" : "trace is not a JSON array of events");
+        return false;
+    }
+
+    // the separator preceding data_begin is kept; it is overwritten by the
+    // opening bracket of the next parse
+    size_t keep_begin = array_opened ? data_begin - 1 : scan_pos;
+    std::memmove(buffer.data(), buffer.data() + keep_begin, data_end - keep_begin);
+    data_begin -= std::min(data_begin, keep_begin);
+    scan_pos -= keep_begin;
+    data_end -= keep_begin;
+
+    // grow the window if a single event does not fit in it
+    if (data_end == window_size) {
+        window_size *= 2;
+        buffer.resize(window_size + simdjson::SIMDJSON_PADDING);
+    }
+
+    file.read(buffer.data() + data_end, window_size - data_end);
+    if (file.bad()) {
+        fail("file could not be read");
+        return false;
+    }
+    data_end += file.gcount();
+    at_eof = file.eof();
+    return true;
+}
+
+void npeNocTraceReader::logError(std::string_view error) const {
+    log_error("Encountered parsing error while reading noc trace file '{}': {}", filepath, error);
+}
+
+void npeNocTraceReader::fail(std::string_view error) {
+    logError(error);
+    failed = true;
+}
+
+}  // namespace tt_npe
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#include "npeSeekableTimeline.hpp"
+
+#include <fstream>
+#include <vector>
+
+#include "npeCompressionUtil.hpp"
+#include "npeUtil.hpp"
+#include "zstd.h"
+
+namespace tt_npe {
+
+// Region index payload layout (little-endian): u32 version, u32 number of
+// regions, then six u64 fields per region in npeTimelineRegionIndexEntry order
+
+namespace {
+
+constexpr uint32_t REGION_INDEX_VERSION = 1;
+constexpr size_t SKIPPABLE_FRAME_HEADER_SIZE = 8;
+constexpr size_t SEEK_TABLE_FOOTER_SIZE = 9;
+constexpr size_t SEEK_TABLE_ENTRY_SIZE = 8;
+
+template <typename T>
+void appendLE(std::string &bytes, T value) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+        bytes += char(uint64_t(value) >> (8 * i));
+    }
+}
+
+template <typename T>
+T readLE(const char *bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= uint64_t(uint8_t(bytes[i])) << (8 * i);
+    }
+    return T(value);
+}
+
+// reads size bytes at offset; returns std::nullopt if the file is too short
+std::optional<std::string> readAt(std::ifstream &ifs, uint64_t offset, uint64_t size) {
+    std::string bytes(size, '\0');
+    ifs.seekg(offset);
+    ifs.read(bytes.data(), size);
+    if (!ifs) {
+        return std::nullopt;
+    }
+    return bytes;
+}
+
+}  // namespace
+
+std::string encodeTimelineRegionIndex(const std::vector<npeTimelineRegionIndexEntry> &regions) {
+    std::string payload;
+    appendLE<uint32_t>(payload, REGION_INDEX_VERSION);
+    appendLE<uint32_t>(payload, regions.size());
+    for (const auto &region : regions) {
+        appendLE<uint64_t>(payload, region.start_timestep_idx);
+        appendLE<uint64_t>(payload, region.end_timestep_idx);
+        appendLE<uint64_t>(payload, region.start_cycle);
+        appendLE<uint64_t>(payload, region.end_cycle);
+        appendLE<uint64_t>(payload, region.offset);
+        appendLE<uint64_t>(payload, region.size);
+    }
+    return payload;
+}
+
+std::optional<npeSeekableTimelineReader> npeSeekableTimelineReader::open(const std::string &filepath) {
+    std::ifstream ifs(filepath, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        log_error("Was not able to open timeline file '{}'", filepath);
+        return std::nullopt;
+    }
+    uint64_t file_size = ifs.tellg();
+
+    // the seek table footer ends the file
+    auto footer = file_size >= SEEK_TABLE_FOOTER_SIZE
+                      ? readAt(ifs, file_size - SEEK_TABLE_FOOTER_SIZE, SEEK_TABLE_FOOTER_SIZE)
+                      : std::nullopt;
+    if (!footer.has_value() ||
+        readLE<uint32_t>(footer->data() + 5) != npeCompressedFileStream::SEEKABLE_MAGIC) {
+        log_error("Timeline file '{}' is not a seekable timeline", filepath);
+        return std::nullopt;
+    }
+    uint32_t num_frames = readLE<uint32_t>(footer->data());
+    bool has_checksums = uint8_t((*footer)[4]) & 0x80;
+    uint64_t entry_size = SEEK_TABLE_ENTRY_SIZE + (has_checksums ? 4 : 0);
+    uint64_t seek_table_size = SKIPPABLE_FRAME_HEADER_SIZE + num_frames * entry_size + SEEK_TABLE_FOOTER_SIZE;
+    if (seek_table_size > file_size) {
+        log_error("Timeline file '{}' has a malformed seek table", filepath);
+        return std::nullopt;
+    }
+    auto entries = readAt(
+        ifs, file_size - seek_table_size + SKIPPABLE_FRAME_HEADER_SIZE, num_frames * entry_size);
+    if (!entries.has_value()) {
+        log_error("Timeline file '{}' has a malformed seek table", filepath);
+        return std::nullopt;
+    }
+
+    // find the region index among the skippable frames (those that decompress to nothing)
+    uint64_t frame_offset = 0;
+    for (uint32_t i = 0; i < num_frames; i++) {
+        const char *entry = entries->data() + i * entry_size;
+        uint32_t compressed_size = readLE<uint32_t>(entry);
+        uint32_t decompressed_size = readLE<uint32_t>(entry + 4);
+        if (decompressed_size == 0 && compressed_size >= SKIPPABLE_FRAME_HEADER_SIZE) {
+            auto header = readAt(ifs, frame_offset, SKIPPABLE_FRAME_HEADER_SIZE);
+            if (header.has_value() &&
+                readLE<uint32_t>(header->data()) ==
+                    (npeCompressedFileStream::SKIPPABLE_FRAME_MAGIC | TIMELINE_REGION_INDEX_FRAME_VARIANT)) {
+                auto payload = readAt(
+                    ifs,
+                    frame_offset + SKIPPABLE_FRAME_HEADER_SIZE,
+                    compressed_size - SKIPPABLE_FRAME_HEADER_SIZE);
+                if (!payload.has_value() || payload->size() < 8 ||
+                    readLE<uint32_t>(payload->data()) != REGION_INDEX_VERSION) {
+                    break;
+                }
+                uint32_t num_regions = readLE<uint32_t>(payload->data() + 4);
+                if (payload->size() != 8 + num_regions * 6 * sizeof(uint64_t)) {
+                    break;
+                }
+                std::vector<npeTimelineRegionIndexEntry> regions(num_regions);
+                const char *field = payload->data() + 8;
+                for (auto &region : regions) {
+                    for (uint64_t *value :
+                         {&region.start_timestep_idx,
+                          &region.end_timestep_idx,
+                          &region.start_cycle,
+                          &region.end_cycle,
+                          &region.offset,
+                          &region.size}) {
+                        *value = readLE<uint64_t>(field);
+                        field += sizeof(uint64_t);
+                    }
+                }
+                return npeSeekableTimelineReader(filepath, std::move(regions));
+            }
+        }
+        frame_offset += compressed_size;
+    }
+    log_error("Timeline file '{}' does not contain a valid region index", filepath);
+    return std::nullopt;
+}
+
+std::optional<size_t> npeSeekableTimelineReader::findRegion(Cycle cycle) const {
+    for (size_t region_idx = 0; region_idx < regions.size(); region_idx++) {
+        if (cycle >= regions[region_idx].start_cycle && cycle <= regions[region_idx].end_cycle) {
+            return region_idx;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> npeSeekableTimelineReader::readRegion(size_t region_idx) const {
+    if (region_idx >= regions.size()) {
+        log_error("Timeline region {} does not exist; '{}' has {} regions", region_idx, filepath, regions.size());
+        return std::nullopt;
+    }
+    const auto &region = regions[region_idx];
+    std::ifstream ifs(filepath, std::ios::binary);
+    auto compressed = readAt(ifs, region.offset, region.size);
+    if (!compressed.has_value()) {
+        log_error("Failed to read timeline region {} from '{}'", region_idx, filepath);
+        return std::nullopt;
+    }
+
+    // the region's frames decompress to its timestep_data entries, each but
+    // the first region's starting with the separator following the entry before
+    ZSTD_DCtx *dctx = ZSTD_createDCtx();
+    std::vector<char> out_buffer(ZSTD_DStreamOutSize());
+    std::string timesteps;
+    ZSTD_inBuffer input = {compressed->data(), compressed->size(), 0};
+    size_t result = 0;
+    bool output_full = false;
+    while (input.pos < input.size || output_full) {
+        ZSTD_outBuffer output = {out_buffer.data(), out_buffer.size(), 0};
+        result = ZSTD_decompressStream(dctx, &output, &input);
+        if (ZSTD_isError(result)) {
+            break;
+        }
+        timesteps.append(out_buffer.data(), output.pos);
+        // a full output buffer may leave decompressed data pending in dctx
+        output_full = output.pos == output.size;
+    }
+    ZSTD_freeDCtx(dctx);
+    if (ZSTD_isError(result) || result != 0) {
+        log_error("Failed to decompress timeline region {} from '{}'", region_idx, filepath);
+        return std::nullopt;
+    }
+    if (timesteps.starts_with(',')) {
+        timesteps.erase(0, 1);
+    }
+    return "[" + timesteps + "]";
+}
+
+}  // namespace tt_npe
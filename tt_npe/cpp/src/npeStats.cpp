@@ -3,32 +3,71 @@
 
 #include "npeStats.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <fstream>
+#include <limits>
+#include <numeric>
 #include <optional>
 #include <boost/unordered/unordered_flat_set.hpp>
+#include <functional>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "fmt/base.h"
 #include "fmt/ostream.h"
 #include "nlohmann/json.hpp"
+#include "npeBinaryTimeline.hpp"
 #include "npeCommon.hpp"
 #include "npeConfig.hpp"
+#include "npeJSONStreamWriter.hpp"
+#include "npeLivenessIndex.hpp"
+#include "npeSeekableTimeline.hpp"
 #include "npeTransferState.hpp"
 #include "npeDeviceModelIface.hpp"
 #include "npeCompressionUtil.hpp"
 
 namespace tt_npe {
 
-npeStats::npeStats(const npeDeviceModel* device_model): device_model(device_model) {
+npeStats::npeStats(const npeDeviceModel* device_model, const npeWorkload* wl): device_model(device_model) {
+    // on a single chip whose golden cycles span the whole mesh, the device and
+    // mesh stats are the same; only track the mesh stats during simulation
+    if (wl && device_model->getNumChips() == 1) {
+        DeviceID device_id = *device_model->getDeviceIDs().begin();
+        auto golden_cycles = wl->getGoldenResultCycles();
+        if (golden_cycles.size() == 2 && golden_cycles.contains(device_id) &&
+            golden_cycles.at(device_id) == golden_cycles.at(MESH_DEVICE)) {
+            mirrored_device_id = device_id;
+        }
+    }
+
     // create per device and full mesh stats
     for (auto device_id: device_model->getDeviceIDs()) {
-        per_device_stats.emplace(device_id, deviceStats()); 
+        if (device_id != mirrored_device_id) {
+            per_device_stats.emplace(device_id, deviceStats());
+        }
     }
     per_device_stats.emplace(MESH_DEVICE, deviceStats());
 }
 
+void TimestepStats::recordTimelineData(
+    const LinkDemandGrid& link_demand_grid, const NIUDemandGrid& niu_demand_grid) {
+    auto record_sparse = [](const std::vector<float>& grid, std::vector<SparseDemand>& sparse) {
+        auto is_significant = [](float demand) { return demand > DEMAND_SIGNIFICANCE_THRESHOLD; };
+        sparse.clear();
+        sparse.reserve(std::count_if(grid.begin(), grid.end(), is_significant));
+        for (size_t id = 0; id < grid.size(); id++) {
+            if (is_significant(grid[id])) {
+                sparse.emplace_back(int16_t(id), grid[id]);
+            }
+        }
+    };
+    record_sparse(link_demand_grid, link_demand);
+    record_sparse(niu_demand_grid, niu_demand);
+}
+
 std::string npeStats::to_string(bool verbose) const {
     return per_device_stats.at(MESH_DEVICE).to_string(verbose);
 }
@@ -37,6 +76,23 @@ void npeStats::computeSummaryStats(const npeWorkload& wl) {
     for (auto& [device_id, deviceStats]: per_device_stats) {
         deviceStats.computeSummaryStats(wl, *device_model, device_id);
     }
+
+    if (mirrored_device_id) {
+        // per-device view of a single-chip run, minus the mesh-only timeline data
+        auto& device_stats = per_device_stats[*mirrored_device_id];
+        auto& mesh_stats = per_device_stats.at(MESH_DEVICE);
+        auto mesh_timesteps = std::move(mesh_stats.per_timestep_stats);
+        device_stats = mesh_stats;
+        device_stats.per_timestep_stats.reserve(mesh_timesteps.size());
+        for (auto& ts : mesh_timesteps) {
+            auto link_demand = std::move(ts.link_demand);
+            auto niu_demand = std::move(ts.niu_demand);
+            device_stats.per_timestep_stats.push_back(ts);
+            ts.link_demand = std::move(link_demand);
+            ts.niu_demand = std::move(niu_demand);
+        }
+        mesh_stats.per_timestep_stats = std::move(mesh_timesteps);
+    }
 }
 
 void npeStats::insertTimestep(Cycle start_cycle, Cycle end_cycle, const npeWorkload& wl) {
@@ -52,10 +108,59 @@ void npeStats::insertTimestep(Cycle start_cycle, Cycle end_cycle, const npeWorkl
     }
 }
 
+void npeStats::insertIdleSpan(Cycle start_cycle, Cycle end_cycle, Cycle cycles_per_timestep, const npeWorkload& wl) {
+    for (auto& [device_id, deviceStats]: per_device_stats) {
+        // skip timesteps within span that end before first transfer on device
+        auto [golden_start, golden_end] = wl.getGoldenResultCycles(device_id);
+        Cycle span_start = start_cycle;
+        if (span_start + cycles_per_timestep < golden_start) {
+            Timestep skipped_timesteps = (golden_start - span_start + cycles_per_timestep - 1) / cycles_per_timestep - 1;
+            span_start += skipped_timesteps * cycles_per_timestep;
+        }
+        if (span_start < end_cycle) {
+            deviceStats.per_timestep_stats.push_back({});
+            TimestepStats &timestep_stats = deviceStats.per_timestep_stats.back();
+            timestep_stats.start_cycle = span_start;
+            timestep_stats.end_cycle = end_cycle;
+            timestep_stats.num_timesteps = (end_cycle - span_start) / cycles_per_timestep;
+        }
+    }
+}
+
+Timestep npeStats::maxTimestepRepeats(Cycle end_cycle, Cycle cycles_per_timestep, const npeWorkload& wl) const {
+    Timestep max_repeats = std::numeric_limits<Timestep>::max();
+    for (const auto& [device_id, deviceStats]: per_device_stats) {
+        if (!deviceStats.per_timestep_stats.empty()) {
+            continue;
+        }
+        // first repeated timestep on device would end at or after golden_start
+        auto [golden_start, golden_end] = wl.getGoldenResultCycles(device_id);
+        if (golden_start > end_cycle) {
+            Timestep first_timestep_on_device = (golden_start - end_cycle + cycles_per_timestep - 1) / cycles_per_timestep;
+            max_repeats = std::min(max_repeats, first_timestep_on_device - 1);
+        }
+    }
+    return max_repeats;
+}
+
+void npeStats::repeatLastTimestep(Timestep num_repeats, Cycle cycles_per_timestep) {
+    for (auto& [device_id, deviceStats]: per_device_stats) {
+        if (deviceStats.per_timestep_stats.empty()) {
+            continue;
+        }
+        TimestepStats &timestep_stats = deviceStats.per_timestep_stats.back();
+        timestep_stats.num_timesteps += num_repeats;
+        timestep_stats.end_cycle += num_repeats * cycles_per_timestep;
+    }
+}
+
 void npeStats::updateWorstCaseTransferEndCycle(DeviceID device_id, PETransferState& tr, std::pair<Cycle, Cycle> golden_cycles) {
     // updated simulated end for device_id and MESH_DEVICE (last event on this device issued during it's golden region)
+    if (device_id == mirrored_device_id) {
+        return;
+    }
     auto [golden_start, golden_end] = golden_cycles;
-    if (golden_start <= tr.params.phase_cycle_offset && tr.params.phase_cycle_offset <= golden_end)
+    if (golden_start <= tr.params->phase_cycle_offset && tr.params->phase_cycle_offset <= golden_end)
         per_device_stats[device_id].worst_case_transfer_end_cycle = std::max(per_device_stats[device_id].worst_case_transfer_end_cycle, tr.end_cycle);
 }
 
@@ -80,7 +185,19 @@ void npeStats::finishSimulation(size_t getElapsedTimeMicroSeconds, Cycle cycles_
         // filter out timestep stats that are after the last transfer on the device
         auto start_idx = golden_start / cycles_per_timestep; // round down
         auto end_idx = (deviceStats.worst_case_transfer_end_cycle + cycles_per_timestep - 1) / cycles_per_timestep; // round up
-        deviceStats.per_timestep_stats.resize(end_idx - start_idx + 1);
+        Timestep timesteps_to_keep = end_idx - start_idx + 1;
+        auto& per_timestep_stats = deviceStats.per_timestep_stats;
+        size_t entries_to_keep = 0;
+        while (entries_to_keep < per_timestep_stats.size() && timesteps_to_keep > 0) {
+            auto& ts = per_timestep_stats[entries_to_keep++];
+            // trim compressed spans that straddle the cutoff
+            if (ts.num_timesteps > timesteps_to_keep) {
+                ts.num_timesteps = timesteps_to_keep;
+                ts.end_cycle = ts.start_cycle + timesteps_to_keep * cycles_per_timestep;
+            }
+            timesteps_to_keep -= ts.num_timesteps;
+        }
+        per_timestep_stats.resize(entries_to_keep + timesteps_to_keep);
     }
 }
 
@@ -120,28 +237,30 @@ std::string npeStats::deviceStats::to_string(bool verbose) const {
 }
 
 void npeStats::deviceStats::computeSummaryStats(const npeWorkload& wl, const npeDeviceModel& device_model, DeviceID device_id) {
+    Timestep num_timesteps = 0;
     for (const auto &ts : per_timestep_stats) {
-        overall_avg_niu_demand += ts.avg_niu_demand;
-        overall_max_niu_demand = std::max(overall_max_niu_demand, ts.avg_niu_demand);
+        num_timesteps += ts.num_timesteps;
 
-        overall_avg_link_demand += ts.avg_link_demand;
+        overall_max_niu_demand = std::max(overall_max_niu_demand, ts.avg_niu_demand);
         overall_max_link_demand = std::max(overall_max_link_demand, ts.avg_link_demand);
-
-        overall_avg_link_util += ts.avg_link_util;
         overall_max_link_util = std::max(overall_max_link_util, ts.avg_link_util);
-
-        overall_avg_noc0_link_demand += ts.avg_noc0_link_demand;
-        overall_avg_noc0_link_util += ts.avg_noc0_link_util;
         overall_max_noc0_link_demand = std::max(overall_max_noc0_link_demand, ts.avg_noc0_link_demand);
-
-        overall_avg_noc1_link_demand += ts.avg_noc1_link_demand;
-        overall_avg_noc1_link_util += ts.avg_noc1_link_util;
         overall_max_noc1_link_demand = std::max(overall_max_noc1_link_demand, ts.avg_noc1_link_demand);
 
-        overall_avg_mcast_write_link_util += ts.avg_mcast_write_link_util;
+        // spans are summed one timestep at a time, so the averages round
+        // exactly as if each timestep had been recorded separately
+        for (Timestep i = 0; i < ts.num_timesteps; i++) {
+            overall_avg_niu_demand += ts.avg_niu_demand;
+            overall_avg_link_demand += ts.avg_link_demand;
+            overall_avg_link_util += ts.avg_link_util;
+            overall_avg_noc0_link_demand += ts.avg_noc0_link_demand;
+            overall_avg_noc0_link_util += ts.avg_noc0_link_util;
+            overall_avg_noc1_link_demand += ts.avg_noc1_link_demand;
+            overall_avg_noc1_link_util += ts.avg_noc1_link_util;
+            overall_avg_mcast_write_link_util += ts.avg_mcast_write_link_util;
+        }
     }
 
-    Timestep num_timesteps = per_timestep_stats.size();
     overall_avg_link_demand /= num_timesteps;
     overall_avg_niu_demand /= num_timesteps;
     overall_avg_link_util /= num_timesteps;
@@ -209,16 +328,63 @@ void npeStats::deviceStats::computeSummaryStats(const npeWorkload& wl, const npe
     }
 }
 
-nlohmann::json v0TimelineSerialization(
+// A timestep of a timeline file, and the stats recorded for it
+struct TimelineTimestep {
+    const TimestepStats &stats;
+    Cycle start_cycle;
+    Cycle end_cycle;
+};
+
+// Timeline files hold one entry per timestep, each cycles_per_timestep long.
+// Presents per-timestep stats that way; a span compressed by fast-forwarding
+// (see TimestepStats::num_timesteps) stands for that many identical timesteps,
+// whose cycle ranges are computed as they are accessed rather than expanded up
+// front.
+class TimelineTimesteps {
+   public:
+    // NOTE: per_timestep_stats must outlive this object
+    TimelineTimesteps(const std::vector<TimestepStats> &per_timestep_stats, Cycle cycles_per_timestep) :
+        per_timestep_stats(per_timestep_stats), cycles_per_timestep(cycles_per_timestep) {
+        entry_end.reserve(per_timestep_stats.size());
+        Timestep num_timesteps = 0;
+        for (const auto &ts : per_timestep_stats) {
+            num_timesteps += ts.num_timesteps;
+            entry_end.push_back(num_timesteps);
+        }
+    }
+
+    Timestep size() const { return entry_end.empty() ? 0 : entry_end.back(); }
+
+    TimelineTimestep operator[](Timestep ts_idx) const {
+        size_t entry_idx = std::upper_bound(entry_end.begin(), entry_end.end(), ts_idx) - entry_end.begin();
+        const auto &ts = per_timestep_stats[entry_idx];
+        if (ts.num_timesteps == 1) {
+            return {ts, ts.start_cycle, ts.end_cycle};
+        }
+        Timestep offset = ts_idx - (entry_end[entry_idx] - ts.num_timesteps);
+        Cycle start_cycle = ts.start_cycle + offset * cycles_per_timestep;
+        return {ts, start_cycle, start_cycle + cycles_per_timestep};
+    }
+
+   private:
+    const std::vector<TimestepStats> &per_timestep_stats;
+    Cycle cycles_per_timestep;
+    // timeline timesteps covered by each entry and all entries before it
+    std::vector<Timestep> entry_end;
+};
+
+void v0TimelineSerialization(
+    JSONStreamWriter &writer,
     const npeStats::deviceStats &device_stats,
     const npeConfig &cfg,
     const npeDeviceModel &model,
     const npeWorkload &wl,
     const std::vector<PETransferState> &transfer_state) {
-    nlohmann::json j;
+    writer.beginObject();
 
     //---- emit common info ---------------------------------------------------
-    j["common_info"] = {
+    writer.key("common_info");
+    writer.value(nlohmann::json{
         {"device_name", cfg.device_name},
         {"cycles_per_timestep", cfg.cycles_per_timestep},
         {"congestion_model_name", cfg.congestion_model_name},
@@ -229,42 +395,43 @@ nlohmann::json v0TimelineSerialization(
         {"link_util", device_stats.overall_avg_link_util},
         {"mcast_write_link_util", device_stats.overall_avg_mcast_write_link_util},
         {"link_demand", device_stats.overall_avg_link_demand},
-        {"max_link_demand", device_stats.overall_max_link_demand}};
+        {"max_link_demand", device_stats.overall_max_link_demand}});
 
     //---- emit per transfer data ---------------------------------------------
-    j["noc_transfers"] = nlohmann::json::array();
+    writer.key("noc_transfers");
+    writer.beginArray();
     for (const auto &tr : transfer_state) {
         nlohmann::json transfer;
-        transfer["id"] = tr.params.getID();
-        transfer["src"] = {tr.params.src.row, tr.params.src.col};
+        transfer["id"] = tr.params->getID();
+        transfer["src"] = {tr.params->src.row, tr.params->src.col};
         transfer["dst"] = nlohmann::json::array();
-        if (std::holds_alternative<Coord>(tr.params.dst)) {
-            auto dst = std::get<Coord>(tr.params.dst);
+        if (std::holds_alternative<Coord>(tr.params->dst)) {
+            auto dst = std::get<Coord>(tr.params->dst);
             transfer["dst"].push_back({dst.row, dst.col});
         } else {
-            auto mcast_pair = std::get<MulticastCoordSet>(tr.params.dst);
+            auto mcast_pair = std::get<MulticastCoordSet>(tr.params->dst);
             for (const auto &c : mcast_pair) {
                 if (model.getCoreType(c) == CoreType::WORKER) {
                     transfer["dst"].push_back({c.row, c.col});
                 }
             }
         }
-        transfer["total_bytes"] = tr.params.total_bytes;
-        transfer["noc_type"] = magic_enum::enum_name(tr.params.noc_type);
-        transfer["injection_rate"] = tr.params.injection_rate;
+        transfer["total_bytes"] = tr.params->total_bytes;
+        transfer["noc_type"] = magic_enum::enum_name(tr.params->noc_type);
+        transfer["injection_rate"] = tr.params->injection_rate;
         transfer["start_cycle"] = tr.start_cycle;
         transfer["end_cycle"] = tr.end_cycle;
-        transfer["noc_event_type"] = tr.params.noc_event_type;
+        transfer["noc_event_type"] = std::string(nocEventTypeName(tr.params->noc_event_type));
 
         std::string route_src_entrypoint =
-            tr.params.noc_type == nocType::NOC0 ? "NOC0_IN" : "NOC1_IN";
+            tr.params->noc_type == nocType::NOC0 ? "NOC0_IN" : "NOC1_IN";
         std::string route_dst_exitpoint =
-            tr.params.noc_type == nocType::NOC0 ? "NOC0_OUT" : "NOC1_OUT";
+            tr.params->noc_type == nocType::NOC0 ? "NOC0_OUT" : "NOC1_OUT";
 
         transfer["route"] = nlohmann::json::array();
         auto &json_route = transfer["route"];
 
-        json_route.push_back({tr.params.src.row, tr.params.src.col, route_src_entrypoint});
+        json_route.push_back({tr.params->src.row, tr.params->src.col, route_src_entrypoint});
         for (const auto &link : tr.route) {
             auto link_attr = model.getLinkAttributes(link);
             json_route.push_back(
@@ -272,11 +439,11 @@ nlohmann::json v0TimelineSerialization(
         }
 
         // add destination exitpoint elements to route
-        if (std::holds_alternative<Coord>(tr.params.dst)) {
-            auto dst = std::get<Coord>(tr.params.dst);
+        if (std::holds_alternative<Coord>(tr.params->dst)) {
+            auto dst = std::get<Coord>(tr.params->dst);
             json_route.push_back({dst.row, dst.col, route_dst_exitpoint});
         } else {
-            auto mcast_pair = std::get<MulticastCoordSet>(tr.params.dst);
+            auto mcast_pair = std::get<MulticastCoordSet>(tr.params->dst);
             for (const auto &dst : mcast_pair) {
                 if (model.getCoreType(dst) == CoreType::WORKER) {
                     json_route.push_back({dst.row, dst.col, route_dst_exitpoint});
@@ -284,63 +451,58 @@ nlohmann::json v0TimelineSerialization(
             }
         }
 
-        j["noc_transfers"].push_back(transfer);
+        writer.value(transfer);
     }
+    writer.endArray();
 
     //---- emit per timestep data ---------------------------------------------
-    auto& per_timestep_stats = device_stats.per_timestep_stats;
-    j["timestep_data"] = nlohmann::json::array();
-    for (const auto &ts : per_timestep_stats) {
+    TimelineTimesteps timesteps(device_stats.per_timestep_stats, cfg.cycles_per_timestep);
+    TransferLivenessIndex liveness_index(transfer_state);
+    writer.key("timestep_data");
+    writer.beginArray();
+    for (Timestep ts_idx = 0; ts_idx < timesteps.size(); ts_idx++) {
+        const auto [ts, start_cycle, end_cycle] = timesteps[ts_idx];
         nlohmann::json timestep;
-        timestep["start_cycle"] = ts.start_cycle;
-        timestep["end_cycle"] = ts.end_cycle;
+        timestep["start_cycle"] = start_cycle;
+        timestep["end_cycle"] = end_cycle;
 
-        std::vector<int> active_transfers(ts.live_transfer_ids.begin(), ts.live_transfer_ids.end());
+        const auto &live_transfer_ids = liveness_index.liveDuring(start_cycle, end_cycle);
+        std::vector<int> active_transfers(live_transfer_ids.begin(), live_transfer_ids.end());
         std::sort(active_transfers.begin(), active_transfers.end());
         timestep["active_transfers"] = active_transfers;
 
         timestep["link_demand"] = nlohmann::json::array();
-        size_t kRows = model.getRows();
-        size_t kCols = model.getCols();
         auto &ts_link_demand = timestep["link_demand"];
 
-        constexpr float DEMAND_SIGNIFICANCE_THRESHOLD = 0.001;
-        for (const auto &[niu_id, demand] : enumerate(ts.niu_demand_grid)) {
-            if (demand > DEMAND_SIGNIFICANCE_THRESHOLD) {
-                nocNIUAttr attr = model.getNIUAttributes(niu_id);
-                std::string terminal_name;
-                switch (attr.type) {
-                    case nocNIUType::NOC0_SRC: terminal_name = "NOC0_IN"; break;
-                    case nocNIUType::NOC0_SINK: terminal_name = "NOC0_OUT"; break;
-                    case nocNIUType::NOC1_SRC: terminal_name = "NOC1_IN"; break;
-                    case nocNIUType::NOC1_SINK: terminal_name = "NOC1_OUT"; break;
-                    default: terminal_name = "UNKNOWN"; break;
-                }
-                ts_link_demand.push_back({attr.coord.row, attr.coord.col, terminal_name, demand});
+        for (const auto &niu_demand : ts.niu_demand) {
+            nocNIUAttr attr = model.getNIUAttributes(niu_demand.id);
+            std::string terminal_name;
+            switch (attr.type) {
+                case nocNIUType::NOC0_SRC: terminal_name = "NOC0_IN"; break;
+                case nocNIUType::NOC0_SINK: terminal_name = "NOC0_OUT"; break;
+                case nocNIUType::NOC1_SRC: terminal_name = "NOC1_IN"; break;
+                case nocNIUType::NOC1_SINK: terminal_name = "NOC1_OUT"; break;
+                default: terminal_name = "UNKNOWN"; break;
             }
+            ts_link_demand.push_back({attr.coord.row, attr.coord.col, terminal_name, niu_demand.demand()});
         }
-        for (const auto& [link_id, demand] : enumerate(ts.link_demand_grid)) {
-            if (demand > DEMAND_SIGNIFICANCE_THRESHOLD) {
-                nocLinkAttr link_attr = model.getLinkAttributes(link_id);
-                ts_link_demand.push_back(
-                    {link_attr.coord.row,
-                     link_attr.coord.col,
-                     magic_enum::enum_name<nocLinkType>(link_attr.type),
-                     demand});
-            }
+        for (const auto &link_demand : ts.link_demand) {
+            nocLinkAttr link_attr = model.getLinkAttributes(link_demand.id);
+            ts_link_demand.push_back(
+                {link_attr.coord.row,
+                 link_attr.coord.col,
+                 magic_enum::enum_name<nocLinkType>(link_attr.type),
+                 link_demand.demand()});
         }
         timestep["avg_link_demand"] = ts.avg_link_demand;
         timestep["avg_link_util"] = ts.avg_link_util;
         timestep["mcast_write_link_util"] = ts.avg_mcast_write_link_util;
 
-        j["timestep_data"].push_back(timestep);
+        writer.value(timestep);
     }
+    writer.endArray();
 
-    return j;
-}
-
-bool isFabricTransferType(const std::string& noc_event_type) {
-    return noc_event_type.starts_with("FABRIC_");
+    writer.endObject();
 }
 
 // Region struct for split file generation
@@ -349,6 +511,8 @@ struct TimelineRegion {
     Timestep end_timestep_idx;    // exclusive
     Cycle start_cycle;
     Cycle end_cycle;
+    size_t split_index;
+    size_t total_splits;
 
     bool partiallyContainedInRegion(
         Cycle start,
@@ -357,7 +521,7 @@ struct TimelineRegion {
         bool ends_in_region = (end > start_cycle && end <= end_cycle);
         return starts_in_region || ends_in_region;
     }
-    
+
     bool fullyContainedInRegion(
         Cycle start,
         Cycle end) const {
@@ -365,56 +529,21 @@ struct TimelineRegion {
     }
 };
 
-nlohmann::json v1TimelineSerialization(
-    const npeStats::deviceStats &device_stats,
-    const npeConfig &cfg,
-    const npeDeviceModel &model,
-    const npeWorkload &wl,
-    const std::vector<PETransferState> &transfer_state,
-    const std::optional<TimelineRegion>& region = std::nullopt) {
-    nlohmann::ordered_json j;
-
-    //---- emit common info ---------------------------------------------------
-    std::string arch_string =
-        model.getArch() == DeviceArch::WormholeB0 ? "wormhole_b0" : "blackhole";
-    j["common_info"] = {
-        {"version", npeStats::CURRENT_TIMELINE_SCHEMA_VERSION},
-        {"mesh_device", cfg.device_name},
-        {"arch", arch_string},
-        {"cycles_per_timestep", cfg.cycles_per_timestep},
-        {"congestion_model_name", cfg.congestion_model_name},
-        {"num_rows", model.getRows()},
-        {"num_cols", model.getCols()},
-        // emit overall stats from the simulation
-        {"dram_bw_util", device_stats.dram_bw_util},
-        {"link_util", device_stats.overall_avg_link_util},
-        {"mcast_write_link_util", device_stats.overall_avg_mcast_write_link_util},
-        {"link_demand", device_stats.overall_avg_link_demand},
-        {"max_link_demand", device_stats.overall_max_link_demand},
-
-        {"noc",
-         {{"NOC0",
-           {{"avg_link_demand", device_stats.overall_avg_noc0_link_demand},
-            {"avg_link_util", device_stats.overall_avg_noc0_link_util},
-            {"max_link_demand", device_stats.overall_max_noc0_link_demand}}},
-          {"NOC1",
-           {{"avg_link_demand", device_stats.overall_avg_noc1_link_demand},
-            {"avg_link_util", device_stats.overall_avg_noc1_link_util},
-            {"max_link_demand", device_stats.overall_max_noc1_link_demand}}}}}};
-
-    //---- emit topology info ---------------------------------------------------
-    j["chips"] = nlohmann::json::object(); // Initialize as an empty object
+// Returns the timeline "chips" entry mapping each chip to its position in the
+// cluster, or std::nullopt if the topology file can not be used.
+std::optional<nlohmann::json> getTimelineChipCoordinates(const npeConfig &cfg, const npeDeviceModel &model) {
+    nlohmann::json chips = nlohmann::json::object();
     bool multichip = model.getNumChips() > 1;
     if (multichip) {
         if (cfg.topology_json.empty()){
             log_error("Cluster coordinates JSON file is required for serializing timeline for multichip devices\n");
-            return nlohmann::json{};
+            return std::nullopt;
         }
 
         std::ifstream ifs(cfg.topology_json);
         if (!ifs.is_open()) {
             log_error("Failed to open cluster coordinates JSON file: {}\n", cfg.topology_json);
-            return nlohmann::json{};
+            return std::nullopt;
         }
 
         try {
@@ -422,7 +551,7 @@ nlohmann::json v1TimelineSerialization(
             if (root_json_data.is_object() &&
                 root_json_data.contains("device_id_to_fabric_node_id") &&
                 root_json_data["device_id_to_fabric_node_id"].is_object() &&
-                root_json_data.contains("mesh_shapes") && 
+                root_json_data.contains("mesh_shapes") &&
                 root_json_data["mesh_shapes"].is_array() &&
                 root_json_data["mesh_shapes"].size() == 1 &&
                 root_json_data["mesh_shapes"][0].contains("shape") &&
@@ -430,98 +559,550 @@ nlohmann::json v1TimelineSerialization(
                 root_json_data["mesh_shapes"][0]["shape"].size() == 2) {
                 const auto &coords_map = root_json_data["device_id_to_fabric_node_id"];
                 // assume single mesh (don't use mesh id)
-                const auto &mesh_shape = std::pair(root_json_data["mesh_shapes"][0]["shape"][0].get<int>(), 
+                const auto &mesh_shape = std::pair(root_json_data["mesh_shapes"][0]["shape"][0].get<int>(),
                     root_json_data["mesh_shapes"][0]["shape"][1].get<int>());
                 for (auto const &[chip_id_str, coord_item] : coords_map.items()) {
                     if (coord_item.is_array() && coord_item.size() == 2 &&
                         coord_item[0].is_number_integer() && coord_item[1].is_number_integer()) {
                         auto ew_dim = mesh_shape.second;
-                        j["chips"][chip_id_str] = nlohmann::json::array(
+                        chips[chip_id_str] = nlohmann::json::array(
                             {coord_item[1].get<int>() % ew_dim,
                              coord_item[1].get<int>() / ew_dim,
-                             0, 
+                             0,
                              0});
                     } else {
                         log_error("Invalid cluster_coordinates.json entry: {} in cluster_coordinates.json file\n", chip_id_str);
-                        return nlohmann::json{};
+                        return std::nullopt;
                     }
                 }
             }
         } catch (const nlohmann::json::parse_error &e) {
             log_error("Failed to parse cluster_coordinates.json file:\n{}\n", e.what());
-            return nlohmann::json{};
+            return std::nullopt;
         }
     } else {
         // single chip case; set all coordinates to 0
-        j["chips"] = nlohmann::json{{"0", {0, 0, 0, 0}}};
+        chips = nlohmann::json{{"0", {0, 0, 0, 0}}};
+    }
+    return chips;
+}
+
+// Finds the split regions that fully contain a cycle interval. Regions are
+// ordered by start cycle, and the running maximum of their end cycles bounds
+// the backwards scan, so a lookup only visits regions that may contain the
+// interval (for contiguous regions, typically just one).
+class TimelineRegionIndex {
+   public:
+    // NOTE: regions must outlive this object
+    explicit TimelineRegionIndex(const std::vector<TimelineRegion> &regions) : regions(regions) {
+        by_start_cycle.resize(regions.size());
+        std::iota(by_start_cycle.begin(), by_start_cycle.end(), 0);
+        std::stable_sort(by_start_cycle.begin(), by_start_cycle.end(), [&](auto lhs, auto rhs) {
+            return regions[lhs].start_cycle < regions[rhs].start_cycle;
+        });
+        max_end_cycle.reserve(regions.size());
+        for (auto region_idx : by_start_cycle) {
+            Cycle end_cycle = regions[region_idx].end_cycle;
+            max_end_cycle.push_back(max_end_cycle.empty() ? end_cycle : std::max(max_end_cycle.back(), end_cycle));
+        }
     }
 
-    //---- emit noc transfer info ---------------------------------------------------
-    j["noc_transfers"] = nlohmann::ordered_json::array();
+    // invokes fn with the index of every region fully containing [start, end]
+    template <typename Fn>
+    void forEachContainingRegion(Cycle start, Cycle end, Fn &&fn) const {
+        auto starts_after = std::upper_bound(
+            by_start_cycle.begin(), by_start_cycle.end(), start, [&](Cycle cycle, size_t region_idx) {
+                return cycle < regions[region_idx].start_cycle;
+            });
+        for (size_t i = starts_after - by_start_cycle.begin(); i-- > 0 && max_end_cycle[i] >= end;) {
+            if (regions[by_start_cycle[i]].fullyContainedInRegion(start, end)) {
+                fn(by_start_cycle[i]);
+            }
+        }
+    }
+
+   private:
+    const std::vector<TimelineRegion> &regions;
+    std::vector<size_t> by_start_cycle;
+    std::vector<Cycle> max_end_cycle;
+};
+
+// Transfer groups, timesteps and zone trees selected for output to a single
+// timeline file; indices refer to the contents of a V1TimelineSerializer
+struct TimelineSelection {
+    std::vector<size_t> transfer_groups;
+    std::vector<Timestep> timesteps;
+    // (zone tree index, root zone index) pairs, ordered by zone tree
+    std::vector<std::pair<size_t, size_t>> root_zones;
+};
+
+// Streams v1 timelines. Work shared between the full timeline and its split
+// files (grouping transfers and building zone trees) is done once on
+// construction; serialize() then builds a small json object for each selected
+// transfer group, zone tree and timestep and writes it out immediately, so
+// the full timeline is never materialized in memory. Top level and nested
+// object keys are emitted in sorted order, matching nlohmann::json.
+//
+// serialize() is const and may be called concurrently from multiple threads,
+// each with its own TransferLivenessIndex.
+class V1TimelineSerializer {
+   public:
+    // NOTE: all arguments must outlive this object
+    V1TimelineSerializer(
+        const nlohmann::json &chips,
+        const npeStats::deviceStats &device_stats,
+        const npeConfig &cfg,
+        const npeDeviceModel &model,
+        const npeWorkload &wl,
+        const std::vector<PETransferState> &transfer_state) :
+        chips(chips),
+        device_stats(device_stats),
+        cfg(cfg),
+        model(model),
+        wl(wl),
+        transfer_state(transfer_state),
+        timesteps(device_stats.per_timestep_stats, cfg.cycles_per_timestep),
+        liveness_index(transfer_state) {
+        groupTransfers();
+        buildZoneTrees();
+    }
+
+    const TimelineTimesteps &getTimesteps() const { return timesteps; }
+
+    // the liveness index serialize() expects; copy it for use by another thread
+    const TransferLivenessIndex &getLivenessIndex() const { return liveness_index; }
+
+    // selects every transfer group, timestep and zone, as in the full timeline
+    TimelineSelection selectAll() const {
+        TimelineSelection selection;
+        selection.transfer_groups.resize(transfer_groups.size());
+        std::iota(selection.transfer_groups.begin(), selection.transfer_groups.end(), 0);
+        selection.timesteps.resize(timesteps.size());
+        std::iota(selection.timesteps.begin(), selection.timesteps.end(), 0);
+        for (size_t tree_idx = 0; tree_idx < zone_trees.size(); tree_idx++) {
+            for (auto root_idx : zone_trees[tree_idx].roots) {
+                selection.root_zones.push_back({tree_idx, root_idx});
+            }
+        }
+        return selection;
+    }
+
+    // Selects the contents of each region in a single pass: every transfer
+    // group, timestep and top level zone is bucketed into the regions fully
+    // containing it. Zones nested in a selected zone are filtered by
+    // serialize() as they are written.
+    std::vector<TimelineSelection> selectRegions(const std::vector<TimelineRegion> &regions) const {
+        std::vector<TimelineSelection> selections(regions.size());
+        if (regions.empty()) {
+            return selections;
+        }
+        TimelineRegionIndex region_index(regions);
+
+        for (size_t group_idx = 0; group_idx < transfer_groups.size(); group_idx++) {
+            const auto &component_transfers = transfer_groups[group_idx].second;
+            Cycle group_start_cycle = transfer_state[component_transfers.front()].start_cycle;
+            Cycle group_end_cycle = transfer_state[component_transfers.back()].end_cycle;
+            region_index.forEachContainingRegion(group_start_cycle, group_end_cycle, [&](size_t region_idx) {
+                selections[region_idx].transfer_groups.push_back(group_idx);
+            });
+        }
+
+        for (Timestep ts_idx = 0; ts_idx < timesteps.size(); ts_idx++) {
+            const auto timestep = timesteps[ts_idx];
+            region_index.forEachContainingRegion(timestep.start_cycle, timestep.end_cycle, [&](size_t region_idx) {
+                selections[region_idx].timesteps.push_back(ts_idx);
+            });
+        }
+
+        for (size_t tree_idx = 0; tree_idx < zone_trees.size(); tree_idx++) {
+            const auto &tree = zone_trees[tree_idx];
+            for (auto root_idx : tree.roots) {
+                const auto &zone = tree.zones[root_idx];
+                if (!zone.end.has_value()) {
+                    // zones that never end are kept in every region
+                    for (auto &selection : selections) {
+                        selection.root_zones.push_back({tree_idx, root_idx});
+                    }
+                    continue;
+                }
+                region_index.forEachContainingRegion(
+                    Cycle(zone.start), Cycle(zone.end.value()), [&](size_t region_idx) {
+                        selections[region_idx].root_zones.push_back({tree_idx, root_idx});
+                    });
+            }
+        }
+
+        return selections;
+    }
+
+    // Streams a timeline containing the selected items to writer. If region
+    // is specified, split metadata is added and nested zones not fully
+    // contained in the region are dropped. If specified, before_timestep is
+    // invoked with the position of each selected timestep before it is
+    // written, and with the number of selected timesteps after the last one.
+    void serialize(
+        JSONStreamWriter &writer,
+        const TimelineSelection &selection,
+        TransferLivenessIndex &liveness_index,
+        const std::optional<TimelineRegion> &region = std::nullopt,
+        const std::function<void(size_t)> &before_timestep = {}) const {
+        writer.beginObject();
+
+        //---- emit topology info ---------------------------------------------------
+        writer.key("chips");
+        writer.value(chips);
+
+        //---- emit common info ---------------------------------------------------
+        std::string arch_string =
+            model.getArch() == DeviceArch::WormholeB0 ? "wormhole_b0" : "blackhole";
+        nlohmann::json common_info = {
+            {"version", npeStats::CURRENT_TIMELINE_SCHEMA_VERSION},
+            {"mesh_device", cfg.device_name},
+            {"arch", arch_string},
+            {"cycles_per_timestep", cfg.cycles_per_timestep},
+            {"congestion_model_name", cfg.congestion_model_name},
+            {"num_rows", model.getRows()},
+            {"num_cols", model.getCols()},
+            // emit overall stats from the simulation
+            {"dram_bw_util", device_stats.dram_bw_util},
+            {"link_util", device_stats.overall_avg_link_util},
+            {"mcast_write_link_util", device_stats.overall_avg_mcast_write_link_util},
+            {"link_demand", device_stats.overall_avg_link_demand},
+            {"max_link_demand", device_stats.overall_max_link_demand},
+
+            {"noc",
+             {{"NOC0",
+               {{"avg_link_demand", device_stats.overall_avg_noc0_link_demand},
+                {"avg_link_util", device_stats.overall_avg_noc0_link_util},
+                {"max_link_demand", device_stats.overall_max_noc0_link_demand}}},
+              {"NOC1",
+               {{"avg_link_demand", device_stats.overall_avg_noc1_link_demand},
+                {"avg_link_util", device_stats.overall_avg_noc1_link_util},
+                {"max_link_demand", device_stats.overall_max_noc1_link_demand}}}}}};
+        if (region.has_value()) {
+            // add split metadata to common_info
+            common_info["split_info"] = {
+                {"split_index", region->split_index},
+                {"total_splits", region->total_splits},
+                {"start_timestep_idx", region->start_timestep_idx},
+                {"end_timestep_idx", region->end_timestep_idx},
+                {"start_cycle", region->start_cycle},
+                {"end_cycle", region->end_cycle}};
+        }
+        writer.key("common_info");
+        writer.value(common_info);
+
+        //---- emit noc transfer info ---------------------------------------------------
+        // each transfer group in tt-npe is a logical transfer in the output timeline
+        boost::unordered_flat_set<npeWorkloadTransferGroupID> defined_groups;
+        writer.key("noc_transfers");
+        writer.beginArray();
+        for (auto group_idx : selection.transfer_groups) {
+            const auto &[transfer_group_id, component_transfers] = transfer_groups[group_idx];
+            writer.value(transferGroupToJson(transfer_group_id, component_transfers));
+            defined_groups.insert(transfer_group_id);
+        }
+        writer.endArray();
+
+        //---- emit per timestep data ---------------------------------------------
+        boost::unordered_flat_set<npeWorkloadTransferGroupID> active_groups;
+        writer.key("timestep_data");
+        writer.beginArray();
+        for (size_t ts_pos = 0; ts_pos < selection.timesteps.size(); ts_pos++) {
+            if (before_timestep) {
+                before_timestep(ts_pos);
+            }
+            const auto [ts, start_cycle, end_cycle] = timesteps[selection.timesteps[ts_pos]];
+            nlohmann::json timestep;
+            timestep["start_cycle"] = start_cycle;
+            timestep["end_cycle"] = end_cycle;
+
+            auto active_transfer_groups = getActiveTransferGroups(liveness_index, start_cycle, end_cycle);
+            active_groups.insert(active_transfer_groups.begin(), active_transfer_groups.end());
+            timestep["active_transfers"] = active_transfer_groups;
+
+            timestep["link_demand"] = nlohmann::json::array();
+            auto &ts_link_demand = timestep["link_demand"];
+
+            for (const auto &niu_demand : ts.niu_demand) {
+                nocNIUAttr attr = model.getNIUAttributes(niu_demand.id);
+                ts_link_demand.push_back(
+                    {attr.coord.device_id, attr.coord.row, attr.coord.col, getNIUTerminalName(attr.type), niu_demand.demand()});
+            }
+
+            for (const auto &link_demand : ts.link_demand) {
+                nocLinkAttr link_attr = model.getLinkAttributes(link_demand.id);
+                ts_link_demand.push_back(
+                    {link_attr.coord.device_id,
+                     link_attr.coord.row,
+                     link_attr.coord.col,
+                     magic_enum::enum_name<nocLinkType>(link_attr.type),
+                     link_demand.demand()});
+            }
+            timestep["avg_link_demand"] = ts.avg_link_demand;
+            timestep["avg_link_util"] = ts.avg_link_util;
+            timestep["mcast_write_link_util"] = ts.avg_mcast_write_link_util;
+            timestep["noc"] = {
+                {"NOC0",
+                 {{"avg_link_demand", ts.avg_noc0_link_demand},
+                  {"avg_link_util", ts.avg_noc0_link_util},
+                  {"max_link_demand", ts.max_noc0_link_demand}}},
+                {"NOC1",
+                 {{"avg_link_demand", ts.avg_noc1_link_demand},
+                  {"avg_link_util", ts.avg_noc1_link_util},
+                  {"max_link_demand", ts.max_noc1_link_demand}}}};
+
+            writer.value(timestep);
+        }
+        if (before_timestep) {
+            before_timestep(selection.timesteps.size());
+        }
+        writer.endArray();
+
+        //---- emit zones ---------------------------------------------
+        writer.key("zones");
+        writer.beginArray();
+        auto root_zone = selection.root_zones.begin();
+        for (size_t tree_idx = 0; tree_idx < zone_trees.size(); tree_idx++) {
+            const auto &tree = zone_trees[tree_idx];
+            // this is the root json object for this core and proc, containing its nested structure of zones
+            auto root_zone_json = nlohmann::json::object();
+            root_zone_json["core"] = {tree.core.device_id, tree.core.row, tree.core.col};
+            root_zone_json["proc"] = magic_enum::enum_name(tree.proc);
+            if (!tree.roots.empty()) {
+                root_zone_json["zones"] = nlohmann::json::array();
+            }
+            for (; root_zone != selection.root_zones.end() && root_zone->first == tree_idx; ++root_zone) {
+                root_zone_json["zones"].push_back(zoneToJson(tree, root_zone->second, region));
+            }
+            writer.value(root_zone_json);
+        }
+        writer.endArray();
+
+        writer.endObject();
+
+        // --- Consistency Checks ---
+        for (const auto &defined_group : defined_groups) {
+            if (active_groups.find(defined_group) == active_groups.end()) {
+                log_error(
+                    "Timeline Consistency Check Failed: Transfer group ID {} is defined in noc_transfers "
+                    "but never appears in active_transfers of any timestep.",
+                    defined_group);
+            }
+        }
+    }
+
+    // Builds the binary columnar form of the full timeline's timestep data.
+    // Links and NIUs are added to the endpoint dictionary in order of first use.
+    npeBinaryTimeline buildBinaryTimeline() const {
+        npeBinaryTimeline timeline;
+        timeline.device_name = cfg.device_name;
+        timeline.arch = model.getArch() == DeviceArch::WormholeB0 ? "wormhole_b0" : "blackhole";
+        timeline.cycles_per_timestep = cfg.cycles_per_timestep;
+
+        // NIU and link ids share the endpoint dictionary; link keys are offset to keep them distinct
+        constexpr int32_t LINK_KEY_OFFSET = 1 << 16;
+        boost::unordered_flat_map<int32_t, uint32_t> endpoint_indices;
+        auto intern_endpoint = [&](int32_t key, const Coord &coord, std::string_view type) {
+            auto [it, inserted] = endpoint_indices.try_emplace(key, timeline.endpoints.size());
+            if (inserted) {
+                timeline.endpoints.push_back({coord.device_id, coord.row, coord.col, std::string(type)});
+            }
+            return it->second;
+        };
+
+        TransferLivenessIndex ts_liveness_index = liveness_index;
+        for (Timestep ts_idx = 0; ts_idx < timesteps.size(); ts_idx++) {
+            const auto [ts, start_cycle, end_cycle] = timesteps[ts_idx];
+            timeline.start_cycle.push_back(start_cycle);
+            timeline.end_cycle.push_back(end_cycle);
+            timeline.avg_link_demand.push_back(ts.avg_link_demand);
+            timeline.avg_link_util.push_back(ts.avg_link_util);
+            timeline.mcast_write_link_util.push_back(ts.avg_mcast_write_link_util);
+            timeline.avg_noc0_link_demand.push_back(ts.avg_noc0_link_demand);
+            timeline.avg_noc0_link_util.push_back(ts.avg_noc0_link_util);
+            timeline.max_noc0_link_demand.push_back(ts.max_noc0_link_demand);
+            timeline.avg_noc1_link_demand.push_back(ts.avg_noc1_link_demand);
+            timeline.avg_noc1_link_util.push_back(ts.avg_noc1_link_util);
+            timeline.max_noc1_link_demand.push_back(ts.max_noc1_link_demand);
+
+            auto active_transfer_groups = getActiveTransferGroups(ts_liveness_index, start_cycle, end_cycle);
+            timeline.active_transfers.insert(
+                timeline.active_transfers.end(), active_transfer_groups.begin(), active_transfer_groups.end());
+            timeline.active_transfer_offsets.push_back(timeline.active_transfers.size());
+
+            // NIU demand precedes link demand, as in the .npeviz link_demand lists
+            for (const auto &niu_demand : ts.niu_demand) {
+                nocNIUAttr attr = model.getNIUAttributes(niu_demand.id);
+                timeline.demand_endpoint.push_back(
+                    intern_endpoint(niu_demand.id, attr.coord, getNIUTerminalName(attr.type)));
+                timeline.demand.push_back(niu_demand.demand());
+            }
+            for (const auto &link_demand : ts.link_demand) {
+                nocLinkAttr link_attr = model.getLinkAttributes(link_demand.id);
+                timeline.demand_endpoint.push_back(intern_endpoint(
+                    LINK_KEY_OFFSET + link_demand.id,
+                    link_attr.coord,
+                    magic_enum::enum_name<nocLinkType>(link_attr.type)));
+                timeline.demand.push_back(link_demand.demand());
+            }
+            timeline.demand_offsets.push_back(timeline.demand.size());
+        }
+        return timeline;
+    }
+
+   private:
+    // a zone and the indices of the zones nested directly within it
+    struct TimelineZone {
+        double start;
+        std::optional<double> end;
+        std::string id;
+        std::vector<size_t> children;
+    };
+
+    // the zones recorded for a single core and proc
+    struct TimelineZoneTree {
+        Coord core;
+        RiscType proc;
+        std::vector<TimelineZone> zones;
+        std::vector<size_t> roots;
+    };
 
     // Construct mapping of transfer group IDs <-> transfer IDs. Timeline output
     // groups transfers that share the same transfer group ID into a single
     // logical transfer
-    boost::unordered_flat_map<npeWorkloadTransferGroupID, std::vector<PETransferID>> transfer_groups;
-    boost::unordered_flat_map<PETransferID, npeWorkloadTransferGroupID> transfer_id_to_transfer_group;
-    int dummy_transfer_group_id = wl.getNumTransferGroups();
-    for (const auto &tr : transfer_state) {
-        if (tr.params.transfer_group_id != -1 && tr.params.transfer_group_index != -1) {
-            transfer_groups[tr.params.transfer_group_id].push_back(tr.params.getID());
-            transfer_id_to_transfer_group[tr.params.getID()] = tr.params.transfer_group_id;
-        } else {
-            // treat transfers without transfer group as being in their own dummy transfer group;
-            // this simplifies the following transfer serialization code
-            transfer_groups[dummy_transfer_group_id].push_back(tr.params.getID());
-            transfer_id_to_transfer_group[tr.params.getID()] = dummy_transfer_group_id;
-            dummy_transfer_group_id++;
+    void groupTransfers() {
+        boost::unordered_flat_map<npeWorkloadTransferGroupID, std::vector<PETransferID>> transfer_group_map;
+        int dummy_transfer_group_id = wl.getNumTransferGroups();
+        for (const auto &tr : transfer_state) {
+            if (tr.params->transfer_group_id != -1 && tr.params->transfer_group_index != -1) {
+                transfer_group_map[tr.params->transfer_group_id].push_back(tr.params->getID());
+                transfer_id_to_transfer_group[tr.params->getID()] = tr.params->transfer_group_id;
+            } else {
+                // treat transfers without transfer group as being in their own dummy transfer group;
+                // this simplifies the following transfer serialization code
+                transfer_group_map[dummy_transfer_group_id].push_back(tr.params->getID());
+                transfer_id_to_transfer_group[tr.params->getID()] = dummy_transfer_group_id;
+                dummy_transfer_group_id++;
+            }
         }
-    }
 
-    // Consistency checks for transfer group maps 
-    boost::unordered_flat_set<PETransferID> all_transfers;
-    for (const auto &[group_id, transfers] : transfer_groups) {
+        // Consistency checks for transfer group maps
+        boost::unordered_flat_set<PETransferID> all_transfers;
+        for (const auto &[group_id, transfers] : transfer_group_map) {
+
+            // check that transfer group itself contains no duplicate transfer IDs
+            boost::unordered_flat_set<PETransferID> internal_group_consistency_check;
+            for (const auto &transfer_id : transfers) {
+                TT_ASSERT(
+                    internal_group_consistency_check.insert(transfer_id).second,
+                    "Transfer ID {} exists in multiple transfer groups!",
+                    transfer_id);
+            }
+
+            // check that transfer exists in transfer_id_to_transfer_group and that it maps to the correct group
+            for (const auto &transfer_id : transfers) {
+                TT_ASSERT(transfer_id_to_transfer_group.contains(transfer_id));
+                TT_ASSERT(transfer_id_to_transfer_group[transfer_id] == group_id);
+
+                // Check for overlap between transfer groups
+                TT_ASSERT(
+                    all_transfers.insert(transfer_id).second,
+                    "Transfer ID {} exists in multiple transfer groups!",
+                    transfer_id);
+            }
+
+            // Check if dummy transfer groups contain only one transfer
+            if (group_id >= wl.getNumTransferGroups()) {
+                TT_ASSERT(
+                    transfers.size() == 1, "Dummy transfer group contains more than one transfer!");
+            }
+        }
 
-        // check that transfer group itself contains no duplicate transfer IDs
-        boost::unordered_flat_set<PETransferID> internal_group_consistency_check;
-        for (const auto &transfer_id : transfers) {
+        // Check if all entries in transfer_id_to_transfer_group exist in transfer_groups
+        for (const auto& [transfer_id, group_id] : transfer_id_to_transfer_group) {
+            TT_ASSERT(transfer_group_map.contains(group_id));
             TT_ASSERT(
-                internal_group_consistency_check.insert(transfer_id).second,
-                "Transfer ID {} exists in multiple transfer groups!",
-                transfer_id);
+                std::find(
+                    transfer_group_map[group_id].begin(), transfer_group_map[group_id].end(), transfer_id) !=
+                transfer_group_map[group_id].end());
         }
 
-        // check that transfer exists in transfer_id_to_transfer_group and that it maps to the correct group
-        for (const auto &transfer_id : transfers) {
-            TT_ASSERT(transfer_id_to_transfer_group.contains(transfer_id));
-            TT_ASSERT(transfer_id_to_transfer_group[transfer_id] == group_id);
+        // order component transfers by their position within the group
+        transfer_groups.reserve(transfer_group_map.size());
+        for (auto &[transfer_group_id, component_transfers] : transfer_group_map) {
+            TT_ASSERT(component_transfers.size() >= 1);
+            std::stable_sort(
+                component_transfers.begin(),
+                component_transfers.end(),
+                [this](const auto &lhs, const auto &rhs) {
+                    return transfer_state[lhs].params->transfer_group_index <
+                           transfer_state[rhs].params->transfer_group_index;
+                });
+            transfer_groups.emplace_back(transfer_group_id, std::move(component_transfers));
+        }
+    }
 
-            // Check for overlap between transfer groups
-            TT_ASSERT(
-                all_transfers.insert(transfer_id).second,
-                "Transfer ID {} exists in multiple transfer groups!",
-                transfer_id);
+    // Builds the nested zone structure of each core and proc from its list of
+    // zone start and end events
+    void buildZoneTrees() {
+        for (const auto &[core_proc, zones] : wl.getZones()) {
+            auto &tree = zone_trees.emplace_back(TimelineZoneTree{core_proc.first, core_proc.second});
+            ZoneIterator zone_iterator(zones);
+            std::vector<size_t> open_zones;
+            while (!zone_iterator.isEnd()) {
+                auto &next_zone = zone_iterator.getNextZone();
+
+                // if start zone, add next_zone as a child to current parent zone
+                if (next_zone.zone_phase == ZonePhase::ZONE_START) {
+                    size_t zone_idx = tree.zones.size();
+                    tree.zones.push_back({next_zone.timestamp});
+                    if (open_zones.empty()) {
+                        tree.roots.push_back(zone_idx);
+                    } else {
+                        tree.zones[open_zones.back()].children.push_back(zone_idx);
+                    }
+                    open_zones.push_back(zone_idx);
+                } else {  // if end zone, set id and end ts of corresponding zone
+                    TT_ASSERT(!open_zones.empty());
+                    auto &[corresponding_start_zone, zone_count] = zone_iterator.getLastEnclosingZone();
+                    auto &zone = tree.zones[open_zones.back()];
+                    zone.id = corresponding_start_zone.zone + "[" + std::to_string(zone_count) + "]";
+                    zone.end = next_zone.timestamp;
+                    open_zones.pop_back();
+                }
+
+                ++zone_iterator;
+            }
         }
+    }
 
-        // Check if dummy transfer groups contain only one transfer
-        if (group_id >= wl.getNumTransferGroups()) {
-            TT_ASSERT(
-                transfers.size() == 1, "Dummy transfer group contains more than one transfer!");
+    // returns the sorted ids of the transfer groups active during [start_cycle, end_cycle)
+    std::vector<npeWorkloadTransferGroupID> getActiveTransferGroups(
+        TransferLivenessIndex &liveness_index, Cycle start_cycle, Cycle end_cycle) const {
+        const auto &live_transfer_ids = liveness_index.liveDuring(start_cycle, end_cycle);
+        std::vector<npeWorkloadTransferGroupID> active_transfer_groups;
+        active_transfer_groups.reserve(live_transfer_ids.size());
+        for (const auto &live_transfer_id : live_transfer_ids) {
+            active_transfer_groups.push_back(transfer_id_to_transfer_group.at(live_transfer_id));
         }
+        uniquify(active_transfer_groups);
+        return active_transfer_groups;
     }
 
-    // Check if all entries in transfer_id_to_transfer_group exist in transfer_groups
-    for (const auto& [transfer_id, group_id] : transfer_id_to_transfer_group) {
-        TT_ASSERT(transfer_groups.contains(group_id));
-        TT_ASSERT(
-            std::find(
-                transfer_groups[group_id].begin(), transfer_groups[group_id].end(), transfer_id) !=
-            transfer_groups[group_id].end());
+    static std::string getNIUTerminalName(nocNIUType type) {
+        switch (type) {
+            case nocNIUType::NOC0_SRC: return "NOC0_IN";
+            case nocNIUType::NOC0_SINK: return "NOC0_OUT";
+            case nocNIUType::NOC1_SRC: return "NOC1_IN";
+            case nocNIUType::NOC1_SINK: return "NOC1_OUT";
+            default: return "UNKNOWN";
+        }
     }
 
-    // helper function to flatten noc destination into a list of coordinates
-    auto get_destination_list = [&model](const NocDestination& destination){ 
-        auto destination_list = nlohmann::ordered_json::array();
+    // flattens noc destination into a list of coordinates
+    nlohmann::json getDestinationList(const NocDestination &destination) const {
+        auto destination_list = nlohmann::json::array();
         if (std::holds_alternative<Coord>(destination)) {
             auto dst = std::get<Coord>(destination);
             destination_list.push_back({dst.device_id, dst.row, dst.col});
@@ -534,73 +1115,55 @@ nlohmann::json v1TimelineSerialization(
             }
         }
         return destination_list;
-    };
-
-    // iterate over all transfer groups - each transfer group in tt-npe is a
-    // logical transfer in the output timeline
-    for (auto& [transfer_group_id, component_transfers] : transfer_groups) {
-        TT_ASSERT(component_transfers.size() >= 1);
-        std::stable_sort(
-            component_transfers.begin(),
-            component_transfers.end(),
-            [&transfer_state](const auto &lhs, const auto &rhs) {
-                return transfer_state[lhs].params.transfer_group_index <
-                       transfer_state[rhs].params.transfer_group_index;
-            });
+    }
 
+    nlohmann::json transferGroupToJson(
+        npeWorkloadTransferGroupID transfer_group_id, const std::vector<PETransferID> &component_transfers) const {
         // start point of transfer group is found in first route
         const auto& first_transfer = component_transfers.front();
         // end point of transfer group is found in last route
         const auto& last_transfer = component_transfers.back();
 
-        // If region is specified, filter transfer groups: include if starts or ends within region
-        if (region.has_value()) {
-            Cycle group_start_cycle = transfer_state[first_transfer].start_cycle;
-            Cycle group_end_cycle = transfer_state[last_transfer].end_cycle;
-            if (!region.value().fullyContainedInRegion(group_start_cycle, group_end_cycle)) {
-                continue;
-            }
-        }
-
-        nlohmann::ordered_json transfer;
+        nlohmann::json transfer;
         transfer["id"] = transfer_group_id;
 
-        auto src_coord = transfer_state[first_transfer].params.src;
+        auto src_coord = transfer_state[first_transfer].params->src;
         transfer["src"] = {src_coord.device_id, src_coord.row, src_coord.col};
-        transfer["total_bytes"] = transfer_state[first_transfer].params.total_bytes;
+        transfer["total_bytes"] = transfer_state[first_transfer].params->total_bytes;
         transfer["start_cycle"] = transfer_state[first_transfer].start_cycle;
-        transfer["noc_event_type"] = transfer_state[first_transfer].params.noc_event_type;
-        transfer["fabric_event_type"] = isFabricTransferType(transfer_state[first_transfer].params.noc_event_type);
-        transfer["zones"] = transfer_state[first_transfer].params.enclosing_zone_path;
+        const auto &first_transfer_params = *transfer_state[first_transfer].params;
+        transfer["noc_event_type"] = std::string(nocEventTypeName(first_transfer_params.noc_event_type));
+        transfer["fabric_event_type"] = isFabricEventType(first_transfer_params.noc_event_type);
+        transfer["zones"] = wl.getZonePath(first_transfer_params.enclosing_zone_path_id);
 
-        auto destination = transfer_state[last_transfer].params.dst;
+        auto destination = transfer_state[last_transfer].params->dst;
         transfer["end_cycle"] = transfer_state[last_transfer].end_cycle;
-        transfer["dst"] = get_destination_list(destination);
+        transfer["dst"] = getDestinationList(destination);
 
-        auto routes_in_transfer = nlohmann::ordered_json::array();
+        auto routes_in_transfer = nlohmann::json::array();
         for (const auto& component_id : component_transfers) {
-            nlohmann::ordered_json route_segment;
+            nlohmann::json route_segment;
             const auto& tr = transfer_state[component_id];
-            route_segment["device_id"] = tr.params.src.device_id;
-            route_segment["src"] = {tr.params.src.device_id, tr.params.src.row, tr.params.src.col};
-            route_segment["dst"] = get_destination_list(tr.params.dst);
-            route_segment["noc_type"] = magic_enum::enum_name(tr.params.noc_type);
-            route_segment["injection_rate"] = tr.params.injection_rate;
+            route_segment["device_id"] = tr.params->src.device_id;
+            route_segment["src"] = {tr.params->src.device_id, tr.params->src.row, tr.params->src.col};
+            route_segment["dst"] = getDestinationList(tr.params->dst);
+            route_segment["noc_type"] = magic_enum::enum_name(tr.params->noc_type);
+            route_segment["injection_rate"] = tr.params->injection_rate;
             route_segment["start_cycle"] = tr.start_cycle;
             route_segment["end_cycle"] = tr.end_cycle;
 
             std::string route_src_entrypoint =
-                tr.params.noc_type == nocType::NOC0 ? "NOC0_IN" : "NOC1_IN";
+                tr.params->noc_type == nocType::NOC0 ? "NOC0_IN" : "NOC1_IN";
             std::string route_dst_exitpoint =
-                tr.params.noc_type == nocType::NOC0 ? "NOC0_OUT" : "NOC1_OUT";
+                tr.params->noc_type == nocType::NOC0 ? "NOC0_OUT" : "NOC1_OUT";
 
-            auto route_segment_links = nlohmann::ordered_json::array();
-            route_segment_links.push_back({tr.params.src.device_id, tr.params.src.row, tr.params.src.col, route_src_entrypoint});
+            auto route_segment_links = nlohmann::json::array();
+            route_segment_links.push_back({tr.params->src.device_id, tr.params->src.row, tr.params->src.col, route_src_entrypoint});
             for (const auto& link : tr.route) {
                 const auto& link_attr = model.getLinkAttributes(link);
                 route_segment_links.push_back({link_attr.coord.device_id, link_attr.coord.row, link_attr.coord.col, magic_enum::enum_name(nocLinkType(link_attr.type))});
             }
-            for (const auto& dst : get_destination_list(tr.params.dst)) {
+            for (const auto& dst : getDestinationList(tr.params->dst)) {
                 route_segment_links.push_back({dst[0], dst[1], dst[2], route_dst_exitpoint});
             }
             route_segment["links"] = route_segment_links;
@@ -608,197 +1171,165 @@ nlohmann::json v1TimelineSerialization(
             routes_in_transfer.push_back(route_segment);
         }
         transfer["route"] = routes_in_transfer;
-
-        j["noc_transfers"].push_back(transfer);
-    }
-
-    //---- emit zones ---------------------------------------------
-    j["zones"] = nlohmann::ordered_json::array();
-    for (auto& [core_proc, zones]: wl.getZones()) {
-        // this is the root json object for this core and proc, containing its nested structure of zones
-        auto root_zone_json = nlohmann::ordered_json::object();
-        root_zone_json["core"] = {core_proc.first.device_id, core_proc.first.row, core_proc.first.col};
-        root_zone_json["proc"] = magic_enum::enum_name(core_proc.second);
-        ZoneIterator zone_iterator(zones);
-        std::unordered_map<npeZone, nlohmann::ordered_json*> zone_jsons;  
-        while (!zone_iterator.isEnd()) {
-            auto& next_zone = zone_iterator.getNextZone();
-
-            // if start zone, add next_zone zone as a child to current parent zone
-            if (next_zone.zone_phase == ZonePhase::ZONE_START) {
-                // create child zone json
-                auto& child_zone = next_zone;
-                nlohmann::ordered_json child_zone_json = {
-                    {"start", child_zone.timestamp},
-                    {"zones", nlohmann::ordered_json::array()}
-                };
-
-                // add as child
-                if (zone_iterator.getEnclosingZones().empty()) {
-                    root_zone_json["zones"].push_back(child_zone_json);
-                    zone_jsons[child_zone] = &(root_zone_json["zones"].back());
-                }
-                else {
-                    auto& parent_zone = zone_iterator.getLastEnclosingZone().first;
-                    auto& parent_zone_json = *zone_jsons[parent_zone];
-                    parent_zone_json["zones"].push_back(child_zone_json);
-                    zone_jsons[child_zone] = &(parent_zone_json["zones"].back());
-                }
-            }
-            else { // if end zone, add id and end ts to corresponding json
-                auto& corresponding_start_zone = zone_iterator.getLastEnclosingZone().first;
-                auto& zone_count = zone_iterator.getLastEnclosingZone().second;
-                auto& zone_json = *zone_jsons[corresponding_start_zone];
-                zone_json["id"] = corresponding_start_zone.zone + "[" + std::to_string(zone_count) + "]";
-                zone_json["end"] = next_zone.timestamp;
-
-                // If region filtering is enabled, check if zone is fully contained
-                // If not contained, remove from parent's zones array
-                if (region.has_value() && !region.value().fullyContainedInRegion(zone_json["start"], zone_json["end"])) {
-                    // Find parent's zone and remove this zone from it
-                    nlohmann::ordered_json* parent_zone_json;
-                    if (zone_iterator.getEnclosingZones().size() == 1) {
-                        parent_zone_json = &root_zone_json;
-                    } else {
-                        // Get the second-to-last enclosing zone (the parent)
-                        auto& parent_zone = zone_iterator.getEnclosingZones()[zone_iterator.getEnclosingZones().size() - 2].first;
-                        parent_zone_json = zone_jsons[parent_zone];
-                    }
-                    // Remove this zone (last element)
-                    auto& zones_array = (*parent_zone_json)["zones"];
-                    zones_array.erase(zones_array.size() - 1);
-                }
-            }
-
-            ++zone_iterator;
-        }
-
-        j["zones"].push_back(root_zone_json);
+        return transfer;
     }
 
-    //---- emit per timestep data ---------------------------------------------
-    auto& per_timestep_stats = device_stats.per_timestep_stats;
-    j["timestep_data"] = nlohmann::ordered_json::array();
-    for (const auto &ts : per_timestep_stats) {
-        // If region is specified, filter timesteps: include only if fully contained in region
-        if (region.has_value()) {
-            if (!region.value().fullyContainedInRegion(ts.start_cycle, ts.end_cycle)) {
+    // builds the json for a zone and the zones nested within it; if region
+    // is specified, nested zones not fully contained in it are dropped
+    nlohmann::json zoneToJson(
+        const TimelineZoneTree &tree, size_t zone_idx, const std::optional<TimelineRegion> &region) const {
+        const auto &zone = tree.zones[zone_idx];
+        nlohmann::json zone_json = {{"start", zone.start}, {"zones", nlohmann::json::array()}};
+        for (auto child_idx : zone.children) {
+            const auto &child = tree.zones[child_idx];
+            if (region.has_value() && child.end.has_value() &&
+                !region->fullyContainedInRegion(Cycle(child.start), Cycle(child.end.value()))) {
                 continue;
             }
+            zone_json["zones"].push_back(zoneToJson(tree, child_idx, region));
         }
-        
-        nlohmann::ordered_json timestep;
-        timestep["start_cycle"] = ts.start_cycle;
-        timestep["end_cycle"] = ts.end_cycle;
-
-        std::vector<npeWorkloadTransferGroupID> active_transfer_groups;
-        active_transfer_groups.reserve(ts.live_transfer_ids.size());
-        for (const auto& live_transfer_id : ts.live_transfer_ids) {
-            active_transfer_groups.push_back(transfer_id_to_transfer_group[live_transfer_id]);
+        if (zone.end.has_value()) {
+            zone_json["id"] = zone.id;
+            zone_json["end"] = zone.end.value();
         }
-        uniquify(active_transfer_groups);
-        timestep["active_transfers"] = active_transfer_groups;
+        return zone_json;
+    }
 
-        timestep["link_demand"] = nlohmann::ordered_json::array();
-        size_t kRows = model.getRows();
-        size_t kCols = model.getCols();
-        auto &ts_link_demand = timestep["link_demand"];
+    const nlohmann::json &chips;
+    const npeStats::deviceStats &device_stats;
+    const npeConfig &cfg;
+    const npeDeviceModel &model;
+    const npeWorkload &wl;
+    const std::vector<PETransferState> &transfer_state;
+    TimelineTimesteps timesteps;
 
-        constexpr float DEMAND_SIGNIFICANCE_THRESHOLD = 0.001;
-        for (const auto &[niu_id, demand] : enumerate(ts.niu_demand_grid)) {
-            if (demand > DEMAND_SIGNIFICANCE_THRESHOLD) {
-                nocNIUAttr attr = model.getNIUAttributes(niu_id);
-                std::string terminal_name;
-                switch (attr.type) {
-                    case nocNIUType::NOC0_SRC: terminal_name = "NOC0_IN"; break;
-                    case nocNIUType::NOC0_SINK: terminal_name = "NOC0_OUT"; break;
-                    case nocNIUType::NOC1_SRC: terminal_name = "NOC1_IN"; break;
-                    case nocNIUType::NOC1_SINK: terminal_name = "NOC1_OUT"; break;
-                    default: terminal_name = "UNKNOWN"; break;
-                }
-                ts_link_demand.push_back({attr.coord.device_id, attr.coord.row, attr.coord.col, terminal_name, demand});
-            }
-        }
+    std::vector<std::pair<npeWorkloadTransferGroupID, std::vector<PETransferID>>> transfer_groups;
+    boost::unordered_flat_map<PETransferID, npeWorkloadTransferGroupID> transfer_id_to_transfer_group;
+    std::vector<TimelineZoneTree> zone_trees;
+    TransferLivenessIndex liveness_index;
+};
 
-        for (const auto &[link_id, demand] : enumerate(ts.link_demand_grid)) {
-            if (demand > DEMAND_SIGNIFICANCE_THRESHOLD) {
-                nocLinkAttr link_attr = model.getLinkAttributes(link_id);
-                ts_link_demand.push_back(
-                    {link_attr.coord.device_id,
-                     link_attr.coord.row,
-                     link_attr.coord.col,
-                     magic_enum::enum_name<nocLinkType>(link_attr.type),
-                     demand});
+// Helper to stream a timeline to file (with optional compression); serialize
+// is invoked with a JSONStreamWriter targeting the output
+template <typename SerializeFn>
+void writeTimelineToFile(const std::string& filepath, const npeConfig& cfg, SerializeFn&& serialize) {
+    try {
+        std::string output_filepath = filepath;
+        if (cfg.compress_timeline_output_file) {
+            output_filepath += ".zst";
+            npeCompressedFileStream os(
+                output_filepath, cfg.timeline_compression_level, cfg.timeline_compression_num_workers);
+            if (!os) {
+                log_error("Was not able to open stats file '{}'", output_filepath);
+                return;
+            }
+            {
+                JSONStreamWriter writer(os);
+                serialize(writer);
+            }
+            if (!os.close()) {
+                log_error("Error writing compressed stats file '{}'", output_filepath);
+            }
+        } else {
+            std::ofstream os(output_filepath);
+            if (!os) {
+                log_error("Was not able to open stats file '{}'", output_filepath);
+                return;
             }
+            JSONStreamWriter writer(os, 2);
+            serialize(writer);
         }
-        timestep["avg_link_demand"] = ts.avg_link_demand;
-        timestep["avg_link_util"] = ts.avg_link_util;
-        timestep["mcast_write_link_util"] = ts.avg_mcast_write_link_util;
-        timestep["noc"] = {
-            {"NOC0",
-             {{"avg_link_demand", ts.avg_noc0_link_demand},
-              {"avg_link_util", ts.avg_noc0_link_util},
-              {"max_link_demand", ts.max_noc0_link_demand}}},
-            {"NOC1",
-             {{"avg_link_demand", ts.avg_noc1_link_demand},
-              {"avg_link_util", ts.avg_noc1_link_util},
-              {"max_link_demand", ts.max_noc1_link_demand}}}};
+    } catch (const std::exception &e) {
+        log_error("Error writing stats file '{}': {}", filepath, e.what());
+    }
+}
 
-        j["timestep_data"].push_back(timestep);
+// Calls fn(split_idx, liveness_index) for each split on a pool of worker
+// threads. Each worker claims splits in increasing order, so the sweep of its
+// liveness index only moves forward in time.
+template <typename Fn>
+void forEachSplitConcurrently(size_t num_splits, const V1TimelineSerializer &serializer, Fn &&fn) {
+    std::atomic<size_t> next_split_idx = 0;
+    auto run_worker = [&]() {
+        TransferLivenessIndex liveness_index = serializer.getLivenessIndex();
+        for (size_t split_idx = next_split_idx++; split_idx < num_splits; split_idx = next_split_idx++) {
+            fn(split_idx, liveness_index);
+        }
+    };
+    size_t num_threads = std::min<size_t>(num_splits, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < num_threads; i++) {
+        workers.emplace_back(run_worker);
     }
+    run_worker();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
 
-    // --- Consistency Checks ---
-    if (j.contains("noc_transfers") && j.contains("timestep_data")) {
-        boost::unordered_flat_set<npeWorkloadTransferGroupID> defined_groups;
-        if (j["noc_transfers"].is_array()) {
-            for (const auto &transfer : j["noc_transfers"]) {
-                if (transfer.contains("id")) {
-                    defined_groups.insert(transfer["id"].get<npeWorkloadTransferGroupID>());
-                }
-            }
+// uncompressed size of each independently compressed frame of a seekable timeline
+constexpr size_t SEEKABLE_TIMELINE_FRAME_SIZE = 4 << 20;
+
+// Streams the full timeline into a seekable compressed file, followed by the
+// region index (see npeSeekableTimeline.hpp). Frames are ended on region
+// boundaries, so the timesteps of each region are compressed independently of
+// the rest of the file. regions must be contiguous and cover every timestep.
+void writeSeekableTimelineToFile(
+    const std::string &filepath,
+    const npeConfig &cfg,
+    const V1TimelineSerializer &serializer,
+    const std::vector<TimelineRegion> &regions) {
+    try {
+        npeCompressedFileStream os(
+            filepath,
+            cfg.timeline_compression_level,
+            cfg.timeline_compression_num_workers,
+            SEEKABLE_TIMELINE_FRAME_SIZE);
+        if (!os) {
+            log_error("Was not able to open stats file '{}'", filepath);
+            return;
         }
 
-        boost::unordered_flat_set<npeWorkloadTransferGroupID> active_groups;
-        if (j["timestep_data"].is_array()) {
-            for (const auto &timestep : j["timestep_data"]) {
-                if (timestep.contains("active_transfers") &&
-                    timestep["active_transfers"].is_array()) {
-                    for (const auto &group_id : timestep["active_transfers"]) {
-                        active_groups.insert(group_id.get<npeWorkloadTransferGroupID>());
+        // timesteps at which each region starts, followed by the end of the
+        // last region; a frame is ended before each one is written
+        std::vector<Timestep> boundaries;
+        for (const auto &region : regions) {
+            boundaries.push_back(region.start_timestep_idx);
+        }
+        if (!regions.empty()) {
+            boundaries.push_back(regions.back().end_timestep_idx);
+        }
+        std::vector<size_t> boundary_offsets;
+        {
+            JSONStreamWriter writer(os);
+            TransferLivenessIndex liveness_index = serializer.getLivenessIndex();
+            serializer.serialize(
+                writer, serializer.selectAll(), liveness_index, std::nullopt, [&](size_t ts_idx) {
+                    if (boundary_offsets.size() < boundaries.size() && ts_idx == boundaries[boundary_offsets.size()]) {
+                        writer.flush();
+                        boundary_offsets.push_back(os.endFrame().value_or(0));
                     }
-                }
-            }
+                });
         }
-
-        for (const auto &defined_group : defined_groups) {
-            if (active_groups.find(defined_group) == active_groups.end()) {
-                log_error(
-                    "Timeline Consistency Check Failed: Transfer group ID {} is defined in noc_transfers "
-                    "but never appears in active_transfers of any timestep.",
-                    defined_group);
-            }
+        if (!os || boundary_offsets.size() != boundaries.size()) {
+            log_error("Error writing timeline regions to '{}'", filepath);
+            return;
         }
-    }
 
-    return j;
-}
-// Helper to write timeline JSON to file (with optional compression)
-void writeTimelineToFile(
-    const nlohmann::json& timeline_json_data,
-    const std::string& filepath,
-    bool compress) {
-    try {
-        std::string output_filepath = filepath;
-        if (compress) {
-            output_filepath += ".zst";
-            npeCompressionUtil::compressToFile(timeline_json_data.dump(-1), output_filepath);
-        } else {
-            std::ofstream os(output_filepath);
-            if (!os) {
-                log_error("Was not able to open stats file '{}'", output_filepath);
-                return;
-            }
-            os << timeline_json_data.dump(2);
+        std::vector<npeTimelineRegionIndexEntry> region_index;
+        for (size_t region_idx = 0; region_idx < regions.size(); region_idx++) {
+            const auto &region = regions[region_idx];
+            region_index.push_back(
+                {region.start_timestep_idx,
+                 region.end_timestep_idx,
+                 region.start_cycle,
+                 region.end_cycle,
+                 boundary_offsets[region_idx],
+                 boundary_offsets[region_idx + 1] - boundary_offsets[region_idx]});
+        }
+        os.writeSkippableFrame(TIMELINE_REGION_INDEX_FRAME_VARIANT, encodeTimelineRegionIndex(region_index));
+        if (!os.close()) {
+            log_error("Error writing compressed stats file '{}'", filepath);
         }
     } catch (const std::exception &e) {
         log_error("Error writing stats file '{}': {}", filepath, e.what());
@@ -811,8 +1342,7 @@ void npeStats::emitSimTimelineToFile(
     const npeConfig &cfg) const {
 
     const auto& device_stats = per_device_stats.at(MESH_DEVICE);
-    const auto& per_timestep_stats = device_stats.per_timestep_stats;
-    
+
     // Determine base filepath
     std::string base_filepath = cfg.timeline_filepath;
     if (base_filepath.empty()) {
@@ -825,63 +1355,91 @@ void npeStats::emitSimTimelineToFile(
     }
 
     // Always emit full timeline file
-    nlohmann::json full_timeline_json_data;
     if (cfg.use_legacy_timeline_format) {
-        full_timeline_json_data = v0TimelineSerialization(device_stats, cfg, *device_model, wl, transfer_state);
-    } else {
-        full_timeline_json_data = v1TimelineSerialization(device_stats, cfg, *device_model, wl, transfer_state);
+        writeTimelineToFile(base_filepath, cfg, [&](JSONStreamWriter &writer) {
+            v0TimelineSerialization(writer, device_stats, cfg, *device_model, wl, transfer_state);
+        });
+        return;
+    }
+
+    auto chips = getTimelineChipCoordinates(cfg, *device_model);
+    if (!chips.has_value()) {
+        return;
+    }
+    V1TimelineSerializer serializer(*chips, device_stats, cfg, *device_model, wl, transfer_state);
+    bool seekable = cfg.compress_timeline_output_file && cfg.seekable_timeline_output_file;
+    if (!seekable) {
+        writeTimelineToFile(base_filepath, cfg, [&](JSONStreamWriter &writer) {
+            TransferLivenessIndex liveness_index = serializer.getLivenessIndex();
+            serializer.serialize(writer, serializer.selectAll(), liveness_index);
+        });
+    }
+
+    // Remove extension from base filepath for binary and split files
+    std::string base_without_ext = base_filepath;
+    auto ext_pos = base_without_ext.find(".npeviz");
+    if (ext_pos != std::string::npos) {
+        base_without_ext = base_without_ext.substr(0, ext_pos);
+    }
+
+    if (cfg.emit_binary_timeline_file) {
+        serializer.buildBinaryTimeline().writeToFile(base_without_ext + ".npetl");
     }
-    writeTimelineToFile(full_timeline_json_data, base_filepath, cfg.compress_timeline_output_file);
 
-    // Check if we need to emit split files (only for v1 format)
-    Timestep num_timesteps = per_timestep_stats.size();
+    // Check if we need to emit split regions (only for v1 format)
+    const auto &timesteps = serializer.getTimesteps();
+    Timestep num_timesteps = timesteps.size();
     Timestep split_threshold = cfg.timeline_split_threshold_timesteps;
-    if (!cfg.use_legacy_timeline_format && num_timesteps > split_threshold) {
-        // Calculate number of split files needed
+    std::vector<TimelineRegion> regions;
+    if (num_timesteps > split_threshold) {
+        // Calculate number of split regions needed
         size_t num_splits = (num_timesteps + split_threshold - 1) / split_threshold;
-        
-        log("Timeline has {} timesteps, exceeding threshold of {}. Emitting {} split files.",
-                 num_timesteps, split_threshold, num_splits);
-        
-        // Remove extension from base filepath for split files
-        std::string base_without_ext = base_filepath;
-        auto ext_pos = base_without_ext.find(".npeviz");
-        if (ext_pos != std::string::npos) {
-            base_without_ext = base_without_ext.substr(0, ext_pos);
+
+        if (seekable) {
+            log("Timeline has {} timesteps, exceeding threshold of {}. Indexing {} seekable regions.",
+                     num_timesteps, split_threshold, num_splits);
+        } else {
+            log("Timeline has {} timesteps, exceeding threshold of {}. Emitting {} split files.",
+                     num_timesteps, split_threshold, num_splits);
         }
-        
+
+        regions.reserve(num_splits);
         for (Timestep split_idx = 0; split_idx < num_splits; ++split_idx) {
             Timestep start_timestep_idx = split_idx * split_threshold;
             Timestep end_timestep_idx = std::min((split_idx + 1) * split_threshold, num_timesteps);
-            
+
             // Get cycle ranges from timestep stats
-            Cycle start_cycle = per_timestep_stats[start_timestep_idx].start_cycle;
-            Cycle end_cycle = per_timestep_stats[end_timestep_idx - 1].end_cycle;
-            
-            TimelineRegion region{
+            Cycle start_cycle = timesteps[start_timestep_idx].start_cycle;
+            Cycle end_cycle = timesteps[end_timestep_idx - 1].end_cycle;
+
+            regions.push_back(TimelineRegion{
                 start_timestep_idx,
                 end_timestep_idx,
                 start_cycle,
-                end_cycle
-            };
-            
-            nlohmann::json split_timeline_json = v1TimelineSerialization(
-                device_stats, cfg, *device_model, wl, transfer_state, region);
-            
-            // Add split metadata to common_info
-            split_timeline_json["common_info"]["split_info"] = {
-                {"split_index", split_idx},
-                {"total_splits", num_splits},
-                {"start_timestep_idx", start_timestep_idx},
-                {"end_timestep_idx", end_timestep_idx},
-                {"start_cycle", start_cycle},
-                {"end_cycle", end_cycle}
-            };
-            
-            std::string split_filepath = fmt::format("{}_split_{}.npeviz", base_without_ext, split_idx);
-            writeTimelineToFile(split_timeline_json, split_filepath, cfg.compress_timeline_output_file);
+                end_cycle,
+                split_idx,
+                num_splits
+            });
         }
+    } else if (seekable && num_timesteps > 0) {
+        // seekable timelines are always indexed, even if they fit in a single region
+        regions.push_back(TimelineRegion{
+            0, num_timesteps, timesteps[0].start_cycle, timesteps[num_timesteps - 1].end_cycle, 0, 1});
     }
+
+    if (seekable) {
+        writeSeekableTimelineToFile(base_filepath + ".zst", cfg, serializer, regions);
+        return;
+    }
+
+    auto selections = serializer.selectRegions(regions);
+    forEachSplitConcurrently(regions.size(), serializer, [&](size_t split_idx, TransferLivenessIndex &liveness_index) {
+        std::string split_filepath = fmt::format("{}_split_{}.npeviz", base_without_ext, split_idx);
+        writeTimelineToFile(split_filepath, cfg, [&](JSONStreamWriter &writer) {
+            serializer.serialize(writer, selections[split_idx], liveness_index, regions[split_idx]);
+        });
+        selections[split_idx] = {};
+    });
 }
 
 double npeStats::deviceStats::getCongestionImpact() const {
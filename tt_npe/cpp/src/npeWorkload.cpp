@@ -86,6 +86,17 @@ npeWorkloadPhaseID npeWorkload::addPhase(npeWorkloadPhase phase) {
     return new_phase_id;
 }
 
+npeZonePathID npeWorkload::internZonePath(std::string_view zone_path) {
+    auto it = zone_path_ids.find(zone_path);
+    if (it != zone_path_ids.end()) {
+        return it->second;
+    }
+    npeZonePathID zone_path_id = zone_paths.size();
+    zone_paths.emplace_back(zone_path);
+    zone_path_ids.emplace(zone_paths.back(), zone_path_id);
+    return zone_path_id;
+}
+
 bool npeWorkload::validate(const npeDeviceModel &npe_device_model, bool verbose) const {
     // bitmaps for detecting id aliasing
     std::vector<bool> phase_id_bitmap(phases.size(), false);
@@ -118,6 +129,14 @@ bool npeWorkload::validate(const npeDeviceModel &npe_device_model, bool verbose)
                 transfer_id_bitmap[tr.id] = true;
             }
 
+            if (tr.enclosing_zone_path_id < 0 || tr.enclosing_zone_path_id >= zone_paths.size()) {
+                log_error(
+                    "WorkloadValidation | Transfer {} has invalid zone path ID {}!",
+                    tr.id,
+                    tr.enclosing_zone_path_id);
+                errors++;
+            }
+
             if (not tr.validate(
                     npe_device_model,
                     getSourceFilePath(),
@@ -161,6 +180,8 @@ npeWorkload npeWorkload::removeLocalUnicastTransfers() const {
 
     npeWorkload wl;
     wl.setGoldenResultCycles(getGoldenResultCycles());
+    wl.zone_paths = zone_paths;
+    wl.zone_path_ids = zone_path_ids;
     for (auto &ph : phases) {
         auto &transfers = ph.transfers;
         npeWorkloadPhase new_ph;
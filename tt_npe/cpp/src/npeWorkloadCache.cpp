@@ -0,0 +1,458 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
+
+#include "npeWorkloadCache.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include "npeByteCodec.hpp"
+#include "npeUtil.hpp"
+
+namespace tt_npe {
+
+// Entry layout (all integers little-endian):
+//
+//   magic "NPEWLBIN", u32 format version
+//   num_transfer_groups (varint)
+//   golden cycles: count, then (device_id zigzag, start varint, end varint)
+//   zone paths: count, then strings (excluding the empty path, ID 0)
+//   zone names: count, then strings
+//   zones: count of (core, risc) entries, then for each
+//     device_id, row, col (zigzag varints), risc (u8), count, then per zone
+//     timestamp (f64), zone name index (varint), zone phase (u8)
+//   phases: count, then for each a count of transfers and per transfer
+//     packet_size, num_packets (varints)
+//     src device_id, row, col (zigzag varints)
+//     dst: u8 tag; 0 is a unicast coord, 1 is a multicast with a count of
+//          grids, each a start and end coord
+//     injection_rate (f32)
+//     phase_cycle_offset zigzag varint delta from previous transfer of phase
+//     noc_type, noc_event_type (u8)
+//     enclosing_zone_path_id (varint)
+//     transfer_group_id, transfer_group_index, transfer_group_parent (zigzag)
+//
+// Strings are stored as a varint length followed by their bytes.
+
+namespace {
+
+constexpr std::string_view MAGIC = "NPEWLBIN";
+constexpr std::string_view ENTRY_EXTENSION = ".npewl";
+
+constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+template <typename T>
+T readLE(const char *ptr) {
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    return value;
+}
+
+uint64_t xxhRound(uint64_t acc, uint64_t input) {
+    acc += input * XXH_PRIME64_2;
+    acc = std::rotl(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+uint64_t xxhMergeRound(uint64_t acc, uint64_t val) {
+    acc ^= xxhRound(0, val);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+// Maps filepath into memory and calls fn with its contents; returns false if
+// it can not be opened or mapped.
+template <typename Fn>
+bool withMappedFile(const std::filesystem::path &filepath, Fn &&fn) {
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = st.st_size;
+    if (size == 0) {
+        ::close(fd);
+        fn(std::string_view{});
+        return true;
+    }
+    void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+
+    struct Unmap {
+        void *addr;
+        size_t size;
+        ~Unmap() { ::munmap(addr, size); }
+    } unmap{addr, size};
+    fn(std::string_view(static_cast<const char *>(addr), size));
+    return true;
+}
+
+void putCoord(ByteWriter &out, const Coord &coord) {
+    out.putZigzag(coord.device_id);
+    out.putZigzag(coord.row);
+    out.putZigzag(coord.col);
+}
+
+Coord getCoord(ByteReader &in) {
+    DeviceID device_id = in.getZigzag();
+    int row = in.getZigzag();
+    int col = in.getZigzag();
+    return Coord{device_id, row, col};
+}
+
+// reads a u8 enum value, checking that it is at most last
+template <typename Enum>
+Enum getEnum(ByteReader &in, Enum last) {
+    auto value = in.getRaw<uint8_t>();
+    if (value > uint8_t(last)) {
+        throw std::runtime_error(fmt::format("invalid enum value {}", value));
+    }
+    return Enum(value);
+}
+
+}  // namespace
+
+uint64_t hashBytes(std::string_view bytes, uint64_t seed) {
+    const char *ptr = bytes.data();
+    const char *end = ptr + bytes.size();
+    uint64_t hash;
+
+    if (bytes.size() >= 32) {
+        uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        uint64_t v2 = seed + XXH_PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_PRIME64_1;
+        for (; end - ptr >= 32; ptr += 32) {
+            v1 = xxhRound(v1, readLE<uint64_t>(ptr));
+            v2 = xxhRound(v2, readLE<uint64_t>(ptr + 8));
+            v3 = xxhRound(v3, readLE<uint64_t>(ptr + 16));
+            v4 = xxhRound(v4, readLE<uint64_t>(ptr + 24));
+        }
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = xxhMergeRound(hash, v1);
+        hash = xxhMergeRound(hash, v2);
+        hash = xxhMergeRound(hash, v3);
+        hash = xxhMergeRound(hash, v4);
+    } else {
+        hash = seed + XXH_PRIME64_5;
+    }
+    hash += bytes.size();
+
+    for (; end - ptr >= 8; ptr += 8) {
+        hash ^= xxhRound(0, readLE<uint64_t>(ptr));
+        hash = std::rotl(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+    if (end - ptr >= 4) {
+        hash ^= uint64_t(readLE<uint32_t>(ptr)) * XXH_PRIME64_1;
+        hash = std::rotl(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        ptr += 4;
+    }
+    for (; ptr < end; ptr++) {
+        hash ^= uint64_t(uint8_t(*ptr)) * XXH_PRIME64_5;
+        hash = std::rotl(hash, 11) * XXH_PRIME64_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::optional<std::string> npeWorkloadCache::computeKey(
+    const std::vector<std::string> &input_files, std::string_view converter_options) const {
+    ByteWriter key_data;
+    key_data.putVarint(FORMAT_VERSION);
+    key_data.putString(converter_options);
+    key_data.putVarint(input_files.size());
+    for (const auto &filepath : input_files) {
+        bool mapped = withMappedFile(filepath, [&](std::string_view contents) {
+            key_data.putVarint(contents.size());
+            key_data.putRaw<uint64_t>(hashBytes(contents));
+        });
+        if (!mapped) {
+            return std::nullopt;
+        }
+    }
+    return fmt::format("{:016x}", hashBytes(key_data.bytes));
+}
+
+std::filesystem::path npeWorkloadCache::getEntryPath(const std::string &key) const {
+    return cache_dir / (key + std::string(ENTRY_EXTENSION));
+}
+
+std::optional<npeWorkload> npeWorkloadCache::load(const std::string &key) const {
+    auto entry_path = getEntryPath(key);
+    std::optional<npeWorkload> wl;
+    try {
+        withMappedFile(entry_path, [&](std::string_view bytes) { wl = deserialize(bytes); });
+    } catch (const std::exception &e) {
+        log_warn("Ignoring unreadable workload cache entry '{}': {}", entry_path.string(), e.what());
+        return std::nullopt;
+    }
+    return wl;
+}
+
+bool npeWorkloadCache::store(const std::string &key, const npeWorkload &wl) const {
+    auto entry_path = getEntryPath(key);
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir, ec);
+    if (ec) {
+        log_warn("Was not able to create workload cache directory '{}': {}", cache_dir.string(), ec.message());
+        return false;
+    }
+
+    // write to a file unique to this thread, then rename it into place
+    auto tmp_path = entry_path;
+    tmp_path += fmt::format(".tmp.{}.{}", ::getpid(), std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary);
+        if (ofs) {
+            ofs << serialize(wl);
+        }
+        if (!ofs) {
+            log_warn("Error writing workload cache entry '{}'", tmp_path.string());
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp_path, entry_path, ec);
+    if (ec) {
+        log_warn("Was not able to write workload cache entry '{}': {}", entry_path.string(), ec.message());
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+std::string npeWorkloadCache::serialize(const npeWorkload &wl) {
+    ByteWriter out;
+    out.bytes += MAGIC;
+    out.putRaw<uint32_t>(FORMAT_VERSION);
+    out.putVarint(wl.getNumTransferGroups());
+
+    auto golden_cycles = wl.getGoldenResultCycles();
+    out.putVarint(golden_cycles.size());
+    for (const auto &[device_id, cycles] : golden_cycles) {
+        out.putZigzag(device_id);
+        out.putVarint(cycles.first);
+        out.putVarint(cycles.second);
+    }
+
+    out.putVarint(wl.getNumZonePaths() - 1);
+    for (size_t i = 1; i < wl.getNumZonePaths(); i++) {
+        out.putString(wl.getZonePath(i));
+    }
+
+    // zone names repeat across cores, so are dictionary-encoded
+    std::vector<std::string_view> zone_names;
+    boost::unordered_flat_map<std::string_view, size_t> zone_name_idxs;
+    ByteWriter zones;
+    zones.putVarint(wl.getZones().size());
+    for (const auto &[core, core_zones] : wl.getZones()) {
+        const auto &[coord, risc] = core;
+        putCoord(zones, coord);
+        zones.putRaw<uint8_t>(uint8_t(risc));
+        zones.putVarint(core_zones.size());
+        for (const auto &zone : core_zones) {
+            auto [it, inserted] = zone_name_idxs.try_emplace(zone.zone, zone_names.size());
+            if (inserted) {
+                zone_names.push_back(zone.zone);
+            }
+            zones.putRaw<double>(zone.timestamp);
+            zones.putVarint(it->second);
+            zones.putRaw<uint8_t>(uint8_t(zone.zone_phase));
+        }
+    }
+    out.putVarint(zone_names.size());
+    for (auto name : zone_names) {
+        out.putString(name);
+    }
+    out.bytes += zones.bytes;
+
+    out.putVarint(wl.getPhases().size());
+    for (const auto &phase : wl.getPhases()) {
+        out.putVarint(phase.transfers.size());
+        Cycle prev_offset = 0;
+        for (const auto &tr : phase.transfers) {
+            out.putVarint(tr.packet_size);
+            out.putVarint(tr.num_packets);
+            putCoord(out, tr.src);
+            std::visit(
+                overloaded{
+                    [&](const Coord &dst) {
+                        out.putRaw<uint8_t>(0);
+                        putCoord(out, dst);
+                    },
+                    [&](const MulticastCoordSet &dst) {
+                        out.putRaw<uint8_t>(1);
+                        out.putVarint(dst.coord_grids.size());
+                        for (const auto &grid : dst.coord_grids) {
+                            putCoord(out, grid.start_coord);
+                            putCoord(out, grid.end_coord);
+                        }
+                    }},
+                tr.dst);
+            out.putRaw<float>(tr.injection_rate);
+            out.putZigzag(int64_t(tr.phase_cycle_offset - prev_offset));
+            prev_offset = tr.phase_cycle_offset;
+            out.putRaw<uint8_t>(uint8_t(tr.noc_type));
+            out.putRaw<uint8_t>(uint8_t(tr.noc_event_type));
+            out.putVarint(tr.enclosing_zone_path_id);
+            out.putZigzag(tr.transfer_group_id);
+            out.putZigzag(tr.transfer_group_index);
+            out.putZigzag(tr.transfer_group_parent);
+        }
+    }
+    return std::move(out.bytes);
+}
+
+npeWorkload npeWorkloadCache::deserialize(std::string_view bytes) {
+    ByteReader in(bytes);
+    // counts of entries to allocate for; each entry takes at least one byte
+    auto getCount = [&]() {
+        uint64_t count = in.getVarint();
+        if (count > bytes.size()) {
+            throw std::runtime_error("malformed count");
+        }
+        return count;
+    };
+    for (char c : MAGIC) {
+        if (in.getRaw<char>() != c) {
+            throw std::runtime_error("not a workload cache entry");
+        }
+    }
+    auto version = in.getRaw<uint32_t>();
+    if (version != FORMAT_VERSION) {
+        throw std::runtime_error(fmt::format("unsupported format version {}", version));
+    }
+
+    npeWorkload wl;
+    for (uint64_t num_groups = in.getVarint(); num_groups > 0; num_groups--) {
+        wl.registerTransferGroupID();
+    }
+
+    // the mesh-wide golden cycles are stored with those of each device, and
+    // are recomputed identically by setGoldenResultCycles
+    boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
+    for (uint64_t count = in.getVarint(); count > 0; count--) {
+        DeviceID device_id = in.getZigzag();
+        Cycle start = in.getVarint();
+        Cycle end = in.getVarint();
+        golden_cycles[device_id] = {start, end};
+    }
+    if (!golden_cycles.empty()) {
+        wl.setGoldenResultCycles(golden_cycles);
+    }
+
+    uint64_t num_zone_paths = in.getVarint();
+    for (uint64_t i = 1; i <= num_zone_paths; i++) {
+        if (wl.internZonePath(in.getString()) != npeZonePathID(i)) {
+            throw std::runtime_error("duplicate zone path");
+        }
+    }
+
+    std::vector<std::string_view> zone_names(getCount());
+    for (auto &name : zone_names) {
+        name = in.getString();
+    }
+    boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>> zones;
+    for (uint64_t num_cores = in.getVarint(); num_cores > 0; num_cores--) {
+        Coord coord = getCoord(in);
+        RiscType risc = getEnum(in, RiscType::CORE_AGG);
+        auto &core_zones = zones[{coord, risc}];
+        core_zones.resize(getCount());
+        for (auto &zone : core_zones) {
+            zone.timestamp = in.getRaw<double>();
+            uint64_t name_idx = in.getVarint();
+            if (name_idx >= zone_names.size()) {
+                throw std::runtime_error("zone refers to unknown zone name");
+            }
+            zone.zone = zone_names[name_idx];
+            zone.zone_phase = getEnum(in, ZonePhase::ZONE_END);
+        }
+    }
+    wl.setZones(std::move(zones));
+
+    for (uint64_t num_phases = in.getVarint(); num_phases > 0; num_phases--) {
+        npeWorkloadPhase phase;
+        uint64_t num_transfers = getCount();
+        phase.transfers.reserve(num_transfers);
+        Cycle prev_offset = 0;
+        for (uint64_t i = 0; i < num_transfers; i++) {
+            uint32_t packet_size = in.getVarint();
+            uint32_t num_packets = in.getVarint();
+            Coord src = getCoord(in);
+            NocDestination dst;
+            auto dst_tag = in.getRaw<uint8_t>();
+            if (dst_tag == 0) {
+                dst = getCoord(in);
+            } else if (dst_tag == 1) {
+                MulticastCoordSet mcast;
+                for (uint64_t num_grids = in.getVarint(); num_grids > 0; num_grids--) {
+                    Coord start = getCoord(in);
+                    Coord end = getCoord(in);
+                    mcast.coord_grids.push_back({start, end});
+                }
+                dst = mcast;
+            } else {
+                throw std::runtime_error(fmt::format("invalid destination tag {}", dst_tag));
+            }
+            float injection_rate = in.getRaw<float>();
+            Cycle phase_cycle_offset = prev_offset + in.getZigzag();
+            prev_offset = phase_cycle_offset;
+            nocType noc_type = getEnum(in, nocType::NOC1);
+            nocEventType noc_event_type = getEnum(in, nocEventType::FABRIC_UNICAST_SCATTER_WRITE);
+            uint64_t zone_path_id = in.getVarint();
+            if (zone_path_id >= wl.getNumZonePaths()) {
+                throw std::runtime_error("transfer refers to unknown zone path");
+            }
+            npeWorkloadTransferGroupID group_id = in.getZigzag();
+            npeWorkloadTransferGroupIndex group_index = in.getZigzag();
+            npeWorkloadTransferGroupParent group_parent = in.getZigzag();
+            phase.transfers.emplace_back(
+                packet_size,
+                num_packets,
+                src,
+                dst,
+                injection_rate,
+                phase_cycle_offset,
+                noc_type,
+                noc_event_type,
+                npeZonePathID(zone_path_id),
+                group_id,
+                group_index,
+                group_parent);
+        }
+        wl.addPhase(std::move(phase));
+    }
+
+    if (!in.atEnd()) {
+        throw std::runtime_error("unexpected data after last phase");
+    }
+    return wl;
+}
+
+}  // namespace tt_npe
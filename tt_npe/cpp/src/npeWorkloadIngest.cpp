@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
 
+#include <atomic>
 #include <boost/unordered/unordered_flat_set.hpp>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <memory>
+#include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -12,20 +16,83 @@
 #include "magic_enum.hpp"
 #include "npeCommon.hpp"
 #include "npeDeviceModelFactory.hpp"
+#include "npeFabricTopology.hpp"
 #include "ingestWorkload.hpp"
+#include "npeNocTraceReader.hpp"
 #include "npeUtil.hpp"
 #include "npeWorkload.hpp"
+#include "npeWorkloadCache.hpp"
 #include "simdjson.h"
 
 namespace tt_npe {
 
+// Fields of a transfer in the tt-npe workload format; missing (or mistyped)
+// fields are std::nullopt
+struct WorkloadTransferFields {
+    std::optional<int64_t> packet_size;
+    std::optional<int64_t> num_packets;
+    std::optional<int64_t> src_x;
+    std::optional<int64_t> src_y;
+    std::optional<int64_t> device_id;
+    std::optional<int64_t> dst_x;
+    std::optional<int64_t> dst_y;
+    std::optional<int64_t> mcast_start_x;
+    std::optional<int64_t> mcast_start_y;
+    std::optional<int64_t> mcast_end_x;
+    std::optional<int64_t> mcast_end_y;
+    std::optional<double> injection_rate;
+    std::optional<int64_t> phase_cycle_offset;
+    std::optional<std::string_view> noc_type;
+    std::optional<std::string_view> noc_event_type;
+};
+
 template <typename T>
-T get_with_default(simdjson::simdjson_result<T> element, T default_value) {
+void decodeOptionalField(simdjson::simdjson_result<T> value, std::optional<T> &field) {
     T val;
-    if (std::move(element).get(val) != simdjson::SUCCESS) {
-        return default_value;
+    if (std::move(value).get(val) == simdjson::SUCCESS) {
+        field = val;
+    }
+}
+
+// decodes a transfer, visiting each of its fields once in document order
+WorkloadTransferFields decodeWorkloadTransfer(simdjson::ondemand::object transfer) {
+    WorkloadTransferFields fields;
+    for (auto field : transfer) {
+        std::string_view key = field.unescaped_key();
+        auto value = field.value();
+        if (key == "packet_size") {
+            decodeOptionalField(value.get_int64(), fields.packet_size);
+        } else if (key == "num_packets") {
+            decodeOptionalField(value.get_int64(), fields.num_packets);
+        } else if (key == "src_x") {
+            decodeOptionalField(value.get_int64(), fields.src_x);
+        } else if (key == "src_y") {
+            decodeOptionalField(value.get_int64(), fields.src_y);
+        } else if (key == "device_id") {
+            decodeOptionalField(value.get_int64(), fields.device_id);
+        } else if (key == "dst_x") {
+            decodeOptionalField(value.get_int64(), fields.dst_x);
+        } else if (key == "dst_y") {
+            decodeOptionalField(value.get_int64(), fields.dst_y);
+        } else if (key == "mcast_start_x") {
+            decodeOptionalField(value.get_int64(), fields.mcast_start_x);
+        } else if (key == "mcast_start_y") {
+            decodeOptionalField(value.get_int64(), fields.mcast_start_y);
+        } else if (key == "mcast_end_x") {
+            decodeOptionalField(value.get_int64(), fields.mcast_end_x);
+        } else if (key == "mcast_end_y") {
+            decodeOptionalField(value.get_int64(), fields.mcast_end_y);
+        } else if (key == "injection_rate") {
+            decodeOptionalField(value.get_double(), fields.injection_rate);
+        } else if (key == "phase_cycle_offset") {
+            decodeOptionalField(value.get_int64(), fields.phase_cycle_offset);
+        } else if (key == "noc_type") {
+            decodeOptionalField(value.get_string(), fields.noc_type);
+        } else if (key == "noc_event_type") {
+            decodeOptionalField(value.get_string(), fields.noc_event_type);
+        }
     }
-    return val;
+    return fields;
 }
 
 std::optional<npeWorkload> loadJSONWorkloadFormat(const std::string &wl_filename, bool verbose) {
@@ -44,20 +111,18 @@ std::optional<npeWorkload> loadJSONWorkloadFormat(const std::string &wl_filename
 
     try {
         // load config file
-        simdjson::dom::parser parser;
-        simdjson::dom::element json_data;
-        try {
-            // use simdjson library to parse JSON file
-            json_data = parser.load(wl_filename);
-        } catch (const simdjson::simdjson_error &exp) {
+        simdjson::padded_string json;
+        if (auto error = simdjson::padded_string::load(wl_filename).get(json)) {
             log_error(
                 "Encountered parsing error while reading JSON workload file '{}': {}",
                 wl_filename,
-                exp.what());
+                simdjson::error_message(error));
             return {};
         }
+        simdjson::ondemand::parser parser;
+        simdjson::ondemand::document json_data = parser.iterate(json);
 
-        if (json_data.type() != simdjson::dom::element_type::OBJECT) {
+        if (json_data.type() != simdjson::ondemand::json_type::object) {
             log_error(
                 "JSON workload file '{}' is not structured as an object (map) at the top level!",
                 wl_filename);
@@ -67,141 +132,129 @@ std::optional<npeWorkload> loadJSONWorkloadFormat(const std::string &wl_filename
             return {};
         }
 
-        boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
-        if (json_data["golden_result"].error() == simdjson::SUCCESS &&
-            json_data["golden_result"]["cycles"].error() == simdjson::SUCCESS) {
-            // retrieve golden cycles if it exists
-            golden_cycles[0] = {0, json_data["golden_result"]["cycles"].get_uint64().value()};
-            wl.setGoldenResultCycles(golden_cycles);
-        }
-
-        simdjson::dom::array phases;
-        if (json_data["phases"].get_array().error() != simdjson::SUCCESS) {
-            log_error("No workload phases declared within workload file '{}'!", wl_filename);
-            return {};
-        }
-        phases = json_data["phases"].get_array();
-
-        DeviceID device_id = 0;
-        for (const auto &phase : phases) {
-            npeWorkloadPhase ph;
-            simdjson::dom::array transfers = phase["transfers"].get_array();
-            simdjson::error_code err;
-            for (const auto &transfer : transfers) {
-                int64_t packet_size, num_packets, src_x, src_y, src_device_id;
-                if (transfer["packet_size"].get_int64().get(packet_size) != simdjson::SUCCESS) {
-                    log_error(
-                        "Transfer event missing 'packet_size' in workload file '{}'", wl_filename);
-                    continue;
-                }
-                if (transfer["num_packets"].get_int64().get(num_packets) != simdjson::SUCCESS) {
-                    log_error(
-                        "Transfer event missing 'num_packets' in workload file '{}'", wl_filename);
-                    continue;
-                }
-                if (transfer["src_x"].get_int64().get(src_x) != simdjson::SUCCESS) {
-                    log_error("Transfer event missing 'src_x' in workload file '{}'", wl_filename);
-                    continue;
-                }
-                if (transfer["src_y"].get_int64().get(src_y) != simdjson::SUCCESS) {
-                    log_error("Transfer event missing 'src_y' in workload file '{}'", wl_filename);
-                    continue;
-                }
-                if (transfer["device_id"].get_int64().get(src_device_id) != simdjson::SUCCESS) {
-                    src_device_id = 0;
+        bool has_phases = false;
+        for (auto field : json_data.get_object()) {
+            std::string_view key = field.unescaped_key();
+            if (key == "golden_result") {
+                simdjson::ondemand::object golden_result;
+                simdjson::ondemand::value cycles;
+                if (field.value().get_object().get(golden_result) == simdjson::SUCCESS &&
+                    golden_result["cycles"].get(cycles) == simdjson::SUCCESS) {
+                    // retrieve golden cycles if it exists
+                    boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
+                    golden_cycles[0] = {0, cycles.get_uint64().value()};
+                    wl.setGoldenResultCycles(golden_cycles);
                 }
+                continue;
+            }
 
-                // determine if multicast or unicast based on presence of dst_x and dst_y
-                NocDestination noc_dest;
-                int64_t dst_x, dst_y, dst_device_id;
-                if (transfer["dst_x"].get_int64().get(dst_x) != simdjson::SUCCESS) {
-                    dst_x = -1;
-                }
-                if (transfer["dst_y"].get_int64().get(dst_y) != simdjson::SUCCESS) {
-                    dst_y = -1;
-                }
-                if (transfer["device_id"].get_int64().get(dst_device_id) != simdjson::SUCCESS) {
-                    dst_device_id = 0;
-                }
-                if (dst_x == -1 && dst_y == -1) {
-                    int64_t mcast_start_x, mcast_start_y, mcast_end_x, mcast_end_y;
-                    if (transfer["mcast_start_x"].get_int64().get(mcast_start_x) !=
-                        simdjson::SUCCESS) {
+            simdjson::ondemand::array phases;
+            if (key != "phases" || has_phases || field.value().get_array().get(phases) != simdjson::SUCCESS) {
+                continue;
+            }
+            has_phases = true;
+            for (auto phase : phases) {
+                npeWorkloadPhase ph;
+                simdjson::ondemand::array transfers = phase["transfers"].get_array();
+                for (auto transfer_value : transfers) {
+                    auto transfer = decodeWorkloadTransfer(transfer_value.get_object());
+                    if (!transfer.packet_size.has_value()) {
                         log_error(
-                            "Multicast Transfer event missing 'mcast_start_x' in workload file "
-                            "'{}'; skipping ... ",
-                            wl_filename);
+                            "Transfer event missing 'packet_size' in workload file '{}'", wl_filename);
                         continue;
                     }
-                    if (transfer["mcast_start_y"].get_int64().get(mcast_start_y) !=
-                        simdjson::SUCCESS) {
+                    if (!transfer.num_packets.has_value()) {
                         log_error(
-                            "Multicast Transfer event missing 'mcast_start_y' in workload file "
-                            "'{}'; skipping ... ",
-                            wl_filename);
+                            "Transfer event missing 'num_packets' in workload file '{}'", wl_filename);
                         continue;
                     }
-                    if (transfer["mcast_end_x"].get_int64().get(mcast_end_x) != simdjson::SUCCESS) {
-                        log_error(
-                            "Multicast Transfer event missing 'mcast_end_x' in workload file '{}'; "
-                            "skipping ... ",
-                            wl_filename);
+                    if (!transfer.src_x.has_value()) {
+                        log_error("Transfer event missing 'src_x' in workload file '{}'", wl_filename);
                         continue;
                     }
-                    if (transfer["mcast_end_y"].get_int64().get(mcast_end_y) != simdjson::SUCCESS) {
-                        log_error(
-                            "Multicast Transfer event missing 'mcast_end_y' in workload file '{}'; "
-                            "skipping ... ",
-                            wl_filename);
+                    if (!transfer.src_y.has_value()) {
+                        log_error("Transfer event missing 'src_y' in workload file '{}'", wl_filename);
                         continue;
                     }
+                    int64_t src_device_id = transfer.device_id.value_or(0);
 
-                    noc_dest = MulticastCoordSet(
-                        Coord{src_device_id, mcast_start_y, mcast_start_x},
-                        Coord{dst_device_id, mcast_end_y, mcast_end_x});
-                } else {
-                    noc_dest = Coord{dst_device_id, dst_y, dst_x};
-                }
+                    // determine if multicast or unicast based on presence of dst_x and dst_y
+                    NocDestination noc_dest;
+                    int64_t dst_x = transfer.dst_x.value_or(-1);
+                    int64_t dst_y = transfer.dst_y.value_or(-1);
+                    int64_t dst_device_id = transfer.device_id.value_or(0);
+                    if (dst_x == -1 && dst_y == -1) {
+                        if (!transfer.mcast_start_x.has_value()) {
+                            log_error(
+                                "Multicast Transfer event missing 'mcast_start_x' in workload file "
+                                "'{}'; skipping ... ",
+                                wl_filename);
+                            continue;
+                        }
+                        if (!transfer.mcast_start_y.has_value()) {
+                            log_error(
+                                "Multicast Transfer event missing 'mcast_start_y' in workload file "
+                                "'{}'; skipping ... ",
+                                wl_filename);
+                            continue;
+                        }
+                        if (!transfer.mcast_end_x.has_value()) {
+                            log_error(
+                                "Multicast Transfer event missing 'mcast_end_x' in workload file '{}'; "
+                                "skipping ... ",
+                                wl_filename);
+                            continue;
+                        }
+                        if (!transfer.mcast_end_y.has_value()) {
+                            log_error(
+                                "Multicast Transfer event missing 'mcast_end_y' in workload file '{}'; "
+                                "skipping ... ",
+                                wl_filename);
+                            continue;
+                        }
 
-                double injection_rate = 0.0;
-                if (transfer["injection_rate"].get_double().get(injection_rate) !=
-                    simdjson::SUCCESS) {
-                    injection_rate = 0.0;
-                }
-                int64_t phase_cycle_offset = 0;
-                if (transfer["phase_cycle_offset"].get_int64().get(phase_cycle_offset) !=
-                    simdjson::SUCCESS) {
-                    log_warn(
-                        "Transfer event missing 'phase_cycle_offset' in workload file '{}'",
-                        wl_filename);
-                    phase_cycle_offset = 0;
-                }
-                std::string_view noc_type;
-                if (transfer["noc_type"].get_string().get(noc_type) != simdjson::SUCCESS) {
-                    log_error(
-                        "Transfer event missing 'noc_type' in workload file '{}'", wl_filename);
-                    continue;
-                }
-                std::string_view noc_event_type;
-                if (transfer["noc_event_type"].get_string().get(noc_event_type) !=
-                    simdjson::SUCCESS) {
-                    log_warn(
-                        "Transfer event missing 'noc_event_type' in workload file '{}'",
-                        wl_filename);
-                }
+                        noc_dest = MulticastCoordSet(
+                            Coord{src_device_id, *transfer.mcast_start_y, *transfer.mcast_start_x},
+                            Coord{dst_device_id, *transfer.mcast_end_y, *transfer.mcast_end_x});
+                    } else {
+                        noc_dest = Coord{dst_device_id, dst_y, dst_x};
+                    }
 
-                ph.transfers.emplace_back(
-                    packet_size,
-                    num_packets,
-                    // note: row is y position, col is x position!
-                    Coord{src_device_id, src_y, src_x},
-                    noc_dest,
-                    injection_rate,
-                    phase_cycle_offset,
-                    (noc_type == "NOC_0") ? nocType::NOC0 : nocType::NOC1,
-                    noc_event_type);
+                    double injection_rate = transfer.injection_rate.value_or(0.0);
+                    if (!transfer.phase_cycle_offset.has_value()) {
+                        log_warn(
+                            "Transfer event missing 'phase_cycle_offset' in workload file '{}'",
+                            wl_filename);
+                    }
+                    int64_t phase_cycle_offset = transfer.phase_cycle_offset.value_or(0);
+                    if (!transfer.noc_type.has_value()) {
+                        log_error(
+                            "Transfer event missing 'noc_type' in workload file '{}'", wl_filename);
+                        continue;
+                    }
+                    if (!transfer.noc_event_type.has_value()) {
+                        log_warn(
+                            "Transfer event missing 'noc_event_type' in workload file '{}'",
+                            wl_filename);
+                    }
+
+                    ph.transfers.emplace_back(
+                        *transfer.packet_size,
+                        *transfer.num_packets,
+                        // note: row is y position, col is x position!
+                        Coord{src_device_id, *transfer.src_y, *transfer.src_x},
+                        noc_dest,
+                        injection_rate,
+                        phase_cycle_offset,
+                        (*transfer.noc_type == "NOC_0") ? nocType::NOC0 : nocType::NOC1,
+                        parseNocEventType(transfer.noc_event_type.value_or(std::string_view{})));
+                }
+                wl.addPhase(ph);
             }
-            wl.addPhase(ph);
+        }
+        if (!has_phases) {
+            log_error("No workload phases declared within workload file '{}'!", wl_filename);
+            return {};
         }
     } catch (const simdjson::simdjson_error &exp) {
         log_error("{}", exp.what());
@@ -218,34 +271,12 @@ std::optional<npeWorkload> loadJSONWorkloadFormat(const std::string &wl_filename
     return wl;
 }
 
-auto computeGoldenCyclesAndT0(const simdjson::dom::element& event_data_json, std::unique_ptr<npeDeviceModel>& device_model) {
-    Cycle t0_timestamp = std::numeric_limits<Cycle>::max();
-    boost::unordered_flat_map<
-        std::tuple<std::string_view, int64_t, int64_t, int64_t>,
-        std::pair<Cycle, Cycle>>
-        per_core_ts;
-
-    for (const auto &event : event_data_json.get_array()) {
-        Cycle ts = get_with_default(event["timestamp"].get_uint64(), Cycle(0));
-        t0_timestamp = std::min(t0_timestamp, ts);
-
-        std::string_view proc = get_with_default(event["proc"].get_string(), std::string_view{});
-        int64_t sx = get_with_default(event["sx"].get_int64(), int64_t(-1));
-        int64_t sy = get_with_default(event["sy"].get_int64(), int64_t(-1));
-        int64_t device_id = get_with_default(event["src_device_id"].get_int64(), int64_t(0));
-        if (proc != "" && sx != -1 && sy != -1) {
-            auto key = std::make_tuple(proc, sx, sy, device_id);
-            auto it = per_core_ts.find(key);
-            if (it == per_core_ts.end()) {
-                per_core_ts[key] = {ts, ts};
-            } else {
-                auto &minmax_ts = it->second;
-                minmax_ts.first = std::min(minmax_ts.first, ts);
-                minmax_ts.second = std::max(minmax_ts.second, ts);
-            }
-        }
-    }
+// first and last timestamp of the events of each (proc, sx, sy, device) core
+using PerCoreTimestamps =
+    boost::unordered_flat_map<std::tuple<std::string, int64_t, int64_t, int64_t>, std::pair<Cycle, Cycle>>;
 
+boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> computeGoldenCycles(
+    const PerCoreTimestamps &per_core_ts, Cycle t0_timestamp, std::unique_ptr<npeDeviceModel> &device_model) {
     boost::unordered_flat_set<DeviceID> device_ids_for_stats = device_model->getDeviceIDs();
     boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
     for (auto device_id: device_ids_for_stats) {
@@ -265,27 +296,7 @@ auto computeGoldenCyclesAndT0(const simdjson::dom::element& event_data_json, std
         golden_cycles[device_id] = {min_kernel_cycles, max_kernel_cycles - 20};
     }
     
-    return std::pair(golden_cycles, t0_timestamp);
-}
-
-boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>> extractZones(const simdjson::dom::element& event_data_json, double t0_timestamp) {
-    boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>> zones;
-    for (const auto &event : event_data_json.get_array()) {
-        Cycle ts = get_with_default(event["timestamp"].get_uint64(), Cycle(0));
-        int64_t device_id = get_with_default(event["src_device_id"].get_int64(), int64_t(0));
-        std::string_view proc = get_with_default(event["proc"].get_string(), std::string_view{});
-        int64_t sx = get_with_default(event["sx"].get_int64(), int64_t(-1));
-        int64_t sy = get_with_default(event["sy"].get_int64(), int64_t(-1));
-        std::string_view zone = get_with_default(event["zone"].get_string(), std::string_view{});
-        std::string_view zone_phase = get_with_default(event["zone_phase"].get_string(), std::string_view{});
-        if (proc != "" && sx != -1 && sy != -1 && zone != "" && zone_phase != "") {
-            zones[std::pair{Coord(device_id, sy, sx), *magic_enum::enum_cast<RiscType>(proc)}].push_back(
-                npeZone(ts - t0_timestamp, std::string(zone), *magic_enum::enum_cast<ZonePhase>(zone_phase))
-            );
-        }
-    }
-
-    return zones;
+    return golden_cycles;
 }
 
 std::string flattenEnclosingZones(const std::vector<std::pair<npeZone, int>>& enclosing_zones) {
@@ -300,147 +311,145 @@ std::string flattenEnclosingZones(const std::vector<std::pair<npeZone, int>>& en
     return enclosing_zone_path;
 }
 
-std::optional<npeWorkload> convertNocTracesToNpeWorkload(
-    const std::string &input_filepath, const std::string &device_name, bool verbose) {
-    ScopedTimer st("", true);
-    npeWorkload wl;
-
-    auto device_model =
-        npeDeviceModelFactory::createDeviceModel(device_name);
+struct NoCEventSavedState {
+    int64_t sx = 0;
+    int64_t sy = 0;
+    int64_t dx = 0;
+    int64_t dy = 0;
+    int64_t num_bytes = 0;
+};
 
-    bool is_wormhole_arch = device_model->getArch() == DeviceArch::WormholeB0;
-    bool is_blackhole_arch = device_model->getArch() == DeviceArch::Blackhole;
-
-    const boost::unordered_flat_set<std::string_view> SUPPORTED_NOC_EVENTS = {
-        "READ",
-        "READ_SET_STATE",
-        "READ_WITH_STATE",
-        "READ_WITH_STATE_AND_TRID",
-        "READ_DRAM_SHARDED_SET_STATE",
-        "READ_DRAM_SHARDED_WITH_STATE",
-        "WRITE_",
-        "WRITE_MULTICAST",
-        "WRITE_SET_STATE",
-        "WRITE_WITH_STATE",
-        "FABRIC_UNICAST_WRITE",
-        "FABRIC_UNICAST_INLINE_WRITE",
-        "FABRIC_UNICAST_ATOMIC_INC",
-        "FABRIC_FUSED_UNICAST_ATOMIC_INC",
-        "FABRIC_UNICAST_SCATTER_WRITE"
-    };
+// Record of an ingested event. t0 and the zones of each core are only known
+// once every event has been seen, so transfers are built with cycle offsets
+// relative to timestamp 0 and without zone paths. The zone iterator is then
+// replayed over these records to rebase offsets and assign zone paths.
+struct ZoneReplayEvent {
+    Coord core;
+    std::optional<RiscType> risc_type;
+    Cycle timestamp;
+    // set if the event reached transfer construction, which interns the
+    // enclosing zone path
+    bool interns_zone_path;
+    // index of the event's first transfer in the transfer list
+    uint32_t transfers_begin;
+};
 
-    if (not std::filesystem::exists(input_filepath)) {
-        log_error("Provided input file '{}' is not a valid file!", input_filepath);
-        return {};
-    }
+// A WITH_STATE event that preceded the SET_STATE of its chunk, and so used
+// placeholders for the state saved by earlier chunks. It is ingested again
+// when the chunk is stitched; its transfers are the same apart from the
+// values taken from the saved state. The views of batch refer to the owned
+// strings below, and are restored before it is ingested again.
+struct DeferredWithStateEvent {
+    // holds just the event, with its fabric routes and local writes
+    NocTraceEventBatch batch;
+    std::string proc;
+    std::string type;
+    std::string noc;
+    std::vector<std::string> route_nocs;
+    // index of the event's first transfer in the chunk's transfers
+    size_t transfers_begin;
+    npeWorkloadTransferGroupID transfer_group_id;
+};
 
-    simdjson::dom::parser parser;
-    simdjson::dom::element event_data_json;
-    try {
-        event_data_json = parser.load(input_filepath);
-    } catch (const simdjson::simdjson_error &exp) {
-        log_error(
-            "Encountered parsing error while reading JSON input file '{}': {}",
-            input_filepath,
-            exp.what());
-        return {};
-    }
+// Results of ingesting a chunk of the events of a trace. Chunks are ingested
+// independently, then stitched together in trace order.
+struct TraceIngestChunk {
+    std::vector<npeWorkloadTransfer> transfers;
+    std::vector<ZoneReplayEvent> zone_replay_events;
+    Cycle t0_timestamp = std::numeric_limits<Cycle>::max();
+    PerCoreTimestamps per_core_ts;
+    boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>> zones;
+    // keys of zones, in the order they were first seen
+    std::vector<std::pair<Coord, RiscType>> zone_cores;
+    // transfer group IDs are numbered from 0 within the chunk
+    npeWorkloadTransferGroupID num_transfer_groups = 0;
+    // last state saved by a READ/WRITE SET_STATE event; std::nullopt if it
+    // was saved before the chunk
+    std::optional<NoCEventSavedState> saved_state_read;
+    std::optional<NoCEventSavedState> saved_state_write;
+    std::vector<DeferredWithStateEvent> deferred_events;
+};
 
-    auto [golden_cycles, t0_timestamp] = computeGoldenCyclesAndT0(event_data_json, device_model);
-    wl.setGoldenResultCycles(golden_cycles);
+struct EventIngestResult {
+    // set if the event reached transfer construction
+    bool interns_zone_path = false;
+    // set if the event used state saved before its chunk
+    bool uses_unknown_saved_state = false;
+};
 
-    boost::unordered_flat_map<std::pair<Coord, RiscType>, std::vector<npeZone>> zones = extractZones(event_data_json, t0_timestamp);
-    wl.setZones(std::move(zones));
+// Appends the transfers of a trace event to chunk.transfers. Skipped fabric
+// route segments are only logged if log_skipped_routes is set.
+EventIngestResult ingestEvent(
+    const NocTraceEvent &event,
+    const NocTraceEventBatch &batch,
+    DeviceArch arch,
+    const std::string &device_name,
+    TraceIngestChunk &chunk,
+    bool log_skipped_routes) {
+    EventIngestResult result;
+    bool is_wormhole_arch = arch == DeviceArch::WormholeB0;
+    bool is_blackhole_arch = arch == DeviceArch::Blackhole;
 
-    struct NoCEventSavedState {
-        int64_t sx = 0;
-        int64_t sy = 0;
-        int64_t dx = 0;
-        int64_t dy = 0;
-        int64_t num_bytes = 0;
-    };
+    std::string_view proc = event.proc;
+    std::string_view noc_event_type = event.type;
+    int64_t num_bytes = event.num_bytes;
+    int64_t sx = event.sx;
+    int64_t sy = event.sy;
+    int64_t dx = event.dx;
+    int64_t dy = event.dy;
 
-    std::vector<npeWorkloadPhase> phases;
-    npeWorkloadPhase phase;
-    NoCEventSavedState curr_saved_state_read;
-    NoCEventSavedState curr_saved_state_write;
-    std::pair<Coord, RiscType> prev_core_proc; 
-    std::unique_ptr<ZoneIterator> zone_iterator;
-    for (const auto &event : event_data_json.get_array()) {
-        std::string_view proc = get_with_default(event["proc"].get_string(), std::string_view{});
-        std::string_view noc_event_type =
-            get_with_default(event["type"].get_string(), std::string_view{});
-        int64_t num_bytes = get_with_default(event["num_bytes"].get_int64(), int64_t(0));
-        int64_t sx = get_with_default(event["sx"].get_int64(), int64_t(-1));
-        int64_t sy = get_with_default(event["sy"].get_int64(), int64_t(-1));
-        int64_t dx = get_with_default(event["dx"].get_int64(), int64_t(-1));
-        int64_t dy = get_with_default(event["dy"].get_int64(), int64_t(-1));
-
-        int64_t src_device_id = get_with_default(event["src_device_id"].get_int64(), int64_t(0));
-        // ensure that dst_device_id is the same as src_device_id if not specified 
-        int64_t dst_device_id = get_with_default(event["dst_device_id"].get_int64(), int64_t(src_device_id));
-        Cycle ts = get_with_default(event["timestamp"].get_uint64(), Cycle(0));
-        
-        // initialize (or re-initialize) zone_iterator for current core and 
-        // increment until we reach the last zone that is <= (ts - t0_timestamp)
-        std::pair<Coord, RiscType> core_proc = {Coord(src_device_id, sy, sx), *magic_enum::enum_cast<RiscType>(proc)};
-        try {
-            if (wl.getZones().contains(core_proc)) {
-                if (core_proc != prev_core_proc) {
-                    zone_iterator = make_unique<ZoneIterator>(wl.getZones()[core_proc]);
-                    prev_core_proc = core_proc;
-                }
-                while (!zone_iterator->isEnd() && zone_iterator->getNextZone().timestamp <= ts - t0_timestamp) ++(*zone_iterator);
-            }
-        } catch (const tt_npe::npeException &exp) {
-            throw npeException(npeErrorCode::TRACE_INGEST_FAILED, "Zones are not correctly structured");
-        }
-        
-        // flatten enclosing_zones and store in transfer
-        std::string enclosing_zone_path = flattenEnclosingZones(zone_iterator->getEnclosingZones());
+    int64_t src_device_id = event.src_device_id;
+    // ensure that dst_device_id is the same as src_device_id if not specified 
+    int64_t dst_device_id = event.dst_device_id.value_or(src_device_id);
+    Cycle ts = event.timestamp;
 
         // Filter out unsupported or invalid events
-        if (not SUPPORTED_NOC_EVENTS.contains(noc_event_type)) {
-            continue;
+        nocEventType event_type = parseNocEventType(noc_event_type);
+        if (event_type == nocEventType::UNKNOWN) {
+            return result;
         }
 
         if (proc.empty()) {
             log_warn("No processor defined for event; skipping ...");
-            continue;
+            return result;
         }
 
-        if ((noc_event_type == "WRITE_" && num_bytes == 0) ||
-            (noc_event_type == "READ" && num_bytes == 0)) {
+        if ((event_type == nocEventType::WRITE_ && num_bytes == 0) ||
+            (event_type == nocEventType::READ && num_bytes == 0)) {
             log_warn("No num_bytes defined for READ/WRITE event; skipping ...");
-            continue;
+            return result;
         }
 
         // Handle events with SET_STATE
         if (noc_event_type.ends_with("SET_STATE")) {
             if (noc_event_type.starts_with("READ")) {
-                curr_saved_state_read = {sx, sy, dx, dy, num_bytes};
+                chunk.saved_state_read = NoCEventSavedState{sx, sy, dx, dy, num_bytes};
             } else if (noc_event_type.starts_with("WRITE")) {
-                curr_saved_state_write = {sx, sy, dx, dy, num_bytes};
+                chunk.saved_state_write = NoCEventSavedState{sx, sy, dx, dy, num_bytes};
             }
-            continue;
+            return result;
         }
 
         if (noc_event_type.find("WITH_STATE") != std::string::npos) {
+            const std::optional<NoCEventSavedState> *saved_state = nullptr;
             if (noc_event_type.find("READ") != std::string::npos) {
-                sx = curr_saved_state_read.sx;
-                sy = curr_saved_state_read.sy;
-                dx = curr_saved_state_read.dx;
-                dy = curr_saved_state_read.dy;
-                if (curr_saved_state_read.num_bytes > 0) {
-                    num_bytes = curr_saved_state_read.num_bytes;
-                }
+                saved_state = &chunk.saved_state_read;
             } else if (noc_event_type.find("WRITE") != std::string::npos) {
-                sx = curr_saved_state_write.sx;
-                sy = curr_saved_state_write.sy;
-                dx = curr_saved_state_write.dx;
-                dy = curr_saved_state_write.dy;
-                if (curr_saved_state_write.num_bytes > 0) {
-                    num_bytes = curr_saved_state_write.num_bytes;
+                saved_state = &chunk.saved_state_write;
+            }
+            if (saved_state) {
+                // the state may have been saved before the chunk; placeholder
+                // values are used until it is known
+                if (!saved_state->has_value()) {
+                    result.uses_unknown_saved_state = true;
+                }
+                NoCEventSavedState state = saved_state->value_or(NoCEventSavedState{});
+                sx = state.sx;
+                sy = state.sy;
+                dx = state.dx;
+                dy = state.dy;
+                if (state.num_bytes > 0) {
+                    num_bytes = state.num_bytes;
                 }
             }
         }
@@ -452,14 +461,14 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
         }
 
         // Get noc type
-        std::string_view noc_type =
-            get_with_default(event["noc"].get_string(), std::string_view{""});
+        std::string_view noc_type = event.noc;
         if (noc_type.empty()) {
             log_error("No NoC type specified for event; skipping ...");
-            continue;
+            return result;
         }
 
-        int64_t phase_cycle_offset = ts - t0_timestamp;
+        // rebased to t0 once the trace has been read
+        int64_t phase_cycle_offset = ts;
 
         // Add latency to phase_cycle_offset (latency for fabric events added later)
         if (noc_event_type.starts_with("READ")) {
@@ -484,21 +493,21 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
             }
         }
 
+        result.interns_zone_path = true;
+
         // Compute dest coords if multicast
         NocDestination noc_dest;
-        if (noc_event_type == "WRITE_MULTICAST") {
-            int64_t mcast_start_x =
-                get_with_default(event["mcast_start_x"].get_int64(), int64_t(-1));
-            int64_t mcast_start_y =
-                get_with_default(event["mcast_start_y"].get_int64(), int64_t(-1));
-            int64_t mcast_end_x = get_with_default(event["mcast_end_x"].get_int64(), int64_t(-1));
-            int64_t mcast_end_y = get_with_default(event["mcast_end_y"].get_int64(), int64_t(-1));
+        if (event_type == nocEventType::WRITE_MULTICAST) {
+            int64_t mcast_start_x = event.mcast_start_x;
+            int64_t mcast_start_y = event.mcast_start_y;
+            int64_t mcast_end_x = event.mcast_end_x;
+            int64_t mcast_end_y = event.mcast_end_y;
             if (mcast_start_x == -1 || mcast_start_y == -1 || mcast_end_x == -1 ||
                 mcast_end_y == -1) {
                 log_error(
                     "Multicast Transfer event missing 'mcast_start_x/y' or 'mcast_end_x/y'; "
                     "skipping ... ");
-                continue;
+                return result;
             }
             if (noc_type == "NOC_0") {
                 noc_dest = MulticastCoordSet(
@@ -517,13 +526,12 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
         Coord noc_src_coord{src_device_id, sy, sx};
 
         // if multichip route override exists, add it to the transfer
-        simdjson::dom::object fabric_send_metadata;
-        if (event["fabric_send"].get(fabric_send_metadata) == simdjson::SUCCESS) {
-            npeWorkloadTransferGroupID transfer_group_id = wl.registerTransferGroupID();
+        if (event.has_fabric_send) {
+            npeWorkloadTransferGroupID transfer_group_id = chunk.num_transfer_groups++;
             npeWorkloadTransferGroupIndex transfer_group_index = 0;
 
-            simdjson::dom::array fabric_path;
-            if (fabric_send_metadata["path"].get(fabric_path) == simdjson::SUCCESS) {
+            auto fabric_path = batch.getFabricRoutes(event);
+            if (!fabric_path.empty()) {
                 // log("Fabric Path src_device={},{},{} dst_device={},{},{} ({} hops)",
                 //     src_device_id,
                 //     sx,
@@ -534,28 +542,20 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
                 //     hops);
 
                 for (const auto &route : fabric_path) {
-                    std::string_view noc_type_str =
-                        get_with_default(route["noc"].get_string(), std::string_view{""});
+                    std::string_view noc_type_str = route.noc;
                     nocType noc_type = noc_type_str == "NOC_0" ? nocType::NOC0 : nocType::NOC1;
-                    DeviceID route_segment_device_id =
-                        get_with_default(route["device"].get_int64(), int64_t(-1));
-                    int64_t segment_start_x =
-                        get_with_default(route["segment_start_x"].get_int64(), int64_t(-1));
-                    int64_t segment_start_y =
-                        get_with_default(route["segment_start_y"].get_int64(), int64_t(-1));
-                    int64_t forward_x =
-                        get_with_default(route["forward_x"].get_int64(), int64_t(-1));
-                    int64_t forward_y =
-                        get_with_default(route["forward_y"].get_int64(), int64_t(-1));
-                    int64_t parent_id =
-                        get_with_default(route["parent_id"].get_int64(), int64_t(-1));
-                    simdjson::dom::array local_writes;
-                    simdjson::error_code contains_local_writes = route["local_writes"].get(local_writes);
+                    DeviceID route_segment_device_id = route.device;
+                    int64_t segment_start_x = route.segment_start_x;
+                    int64_t segment_start_y = route.segment_start_y;
+                    int64_t forward_x = route.forward_x;
+                    int64_t forward_y = route.forward_y;
+                    int64_t parent_id = route.parent_id;
+                    bool contains_local_writes = route.has_local_writes;
 
                     // add latency for first route (latencies for remaining routes are added in npeEngine::genDependencies)
                     // NOTE: all fabric events are writes!
                     if (transfer_group_index == 0) {
-                        switch (device_model->getArch()) {
+                        switch (arch) {
                             case DeviceArch::WormholeB0:
                                 phase_cycle_offset += WormholeB0DeviceModel::get_write_latency(segment_start_x, segment_start_y, 
                                     forward_x, forward_y, noc_type_str);
@@ -568,16 +568,18 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
                                 throw npeException(npeErrorCode::TRACE_INGEST_FAILED);
                         }
                     }
-                    
+                
                     if (route_segment_device_id == -1 || segment_start_x == -1 || segment_start_y == -1 || 
-                        (contains_local_writes != simdjson::SUCCESS && (forward_x == -1 || forward_y == -1))) {
-                        log_error(
-                            "Transfer at timestamp {} (origin device={} x={} y={}) has one or more "
-                            "missing fields in fabric send path; skipping ... ",
-                            ts,
-                            src_device_id,
-                            sx,
-                            sy);
+                        (!contains_local_writes && (forward_x == -1 || forward_y == -1))) {
+                        if (log_skipped_routes) {
+                            log_error(
+                                "Transfer at timestamp {} (origin device={} x={} y={}) has one or more "
+                                "missing fields in fabric send path; skipping ... ",
+                                ts,
+                                src_device_id,
+                                sx,
+                                sy);
+                        }
                         continue;
                     }
 
@@ -591,17 +593,14 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
 
                     // Both writes to local worker cores and forward to downstream ethernet core depend on 
                     // the previous forward hence the same transfer_group_parent
-                    if (contains_local_writes == simdjson::SUCCESS) {
-                        for (auto local_write: local_writes) {
-                            int64_t local_write_x =
-                                get_with_default(local_write["dx"].get_int64(), int64_t(-1));
-                            int64_t local_write_y =
-                                get_with_default(local_write["dy"].get_int64(), int64_t(-1));
-                            int64_t local_write_bytes =
-                                get_with_default(local_write["num_bytes"].get_int64(), int64_t(-1));
+                    if (contains_local_writes) {
+                        for (const auto &local_write : batch.getLocalWrites(route)) {
+                            int64_t local_write_x = local_write.dx;
+                            int64_t local_write_y = local_write.dy;
+                            int64_t local_write_bytes = local_write.num_bytes;
 
                             if (local_write_x != -1 && local_write_y != -1 && local_write_bytes != -1) {
-                                phase.transfers.emplace_back(
+                                chunk.transfers.emplace_back(
                                     local_write_bytes,
                                     1,
                                     Coord{route_segment_device_id, segment_start_y, segment_start_x},
@@ -609,8 +608,8 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
                                     0.0,
                                     phase_cycle_offset,
                                     noc_type,
-                                    noc_event_type,
-                                    enclosing_zone_path,
+                                    event_type,
+                                    EMPTY_ZONE_PATH,
                                     transfer_group_id,
                                     transfer_group_index,
                                     parent_id);
@@ -620,7 +619,7 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
                     }
 
                     if (forward_x != -1 && forward_y != -1) {
-                        phase.transfers.emplace_back(
+                        chunk.transfers.emplace_back(
                             num_bytes,
                             1,
                             Coord{route_segment_device_id, segment_start_y, segment_start_x},
@@ -628,8 +627,8 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
                             0.0,
                             phase_cycle_offset,
                             noc_type,
-                            noc_event_type,
-                            enclosing_zone_path,
+                            event_type,
+                            EMPTY_ZONE_PATH,
                             transfer_group_id,
                             transfer_group_index,
                             parent_id);
@@ -638,7 +637,7 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
                 }
             }
         } else {
-            phase.transfers.emplace_back(
+            chunk.transfers.emplace_back(
                 num_bytes,
                 1,
                 noc_src_coord,
@@ -646,11 +645,316 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
                 0.0,
                 phase_cycle_offset,
                 (noc_type == "NOC_0") ? nocType::NOC0 : nocType::NOC1,
-                noc_event_type,
-                enclosing_zone_path);
+                event_type);
+        }
+    return result;
+}
+
+// Saves a copy of event that does not refer to the chunk's data
+DeferredWithStateEvent deferWithStateEvent(
+    const NocTraceEvent &event, const NocTraceEventBatch &batch, size_t transfers_begin, npeWorkloadTransferGroupID transfer_group_id) {
+    DeferredWithStateEvent deferred;
+    deferred.proc = event.proc;
+    deferred.type = event.type;
+    deferred.noc = event.noc;
+    deferred.transfers_begin = transfers_begin;
+    deferred.transfer_group_id = transfer_group_id;
+
+    auto &deferred_event = deferred.batch.events.emplace_back(event);
+    deferred_event.zone = {};
+    deferred_event.zone_phase = {};
+    deferred_event.fabric_routes_begin = 0;
+    deferred_event.fabric_routes_end = 0;
+    deferred_event.fabric_routing = {};
+    deferred_event.has_dst = false;
+    for (const auto &route : batch.getFabricRoutes(event)) {
+        auto &deferred_route = deferred.batch.fabric_routes.emplace_back(route);
+        deferred.route_nocs.emplace_back(route.noc);
+        deferred_route.local_writes_begin = deferred.batch.local_writes.size();
+        for (const auto &local_write : batch.getLocalWrites(route)) {
+            deferred.batch.local_writes.push_back(local_write);
+        }
+        deferred_route.local_writes_end = deferred.batch.local_writes.size();
+        deferred_event.fabric_routes_end++;
+    }
+    return deferred;
+}
+
+// Ingests the next event of a chunk of the trace. per_core_ts_key is scratch
+// space, reused across events to avoid allocating for every event.
+void ingestTraceEvent(
+    const NocTraceEvent &event,
+    const NocTraceEventBatch &batch,
+    DeviceArch arch,
+    const std::string &device_name,
+    TraceIngestChunk &chunk,
+    std::tuple<std::string, int64_t, int64_t, int64_t> &per_core_ts_key) {
+    std::string_view proc = event.proc;
+    int64_t sx = event.sx;
+    int64_t sy = event.sy;
+    int64_t src_device_id = event.src_device_id;
+    Cycle ts = event.timestamp;
+
+    chunk.t0_timestamp = std::min(chunk.t0_timestamp, ts);
+    if (proc != "" && sx != -1 && sy != -1) {
+        std::get<0>(per_core_ts_key).assign(proc);
+        std::get<1>(per_core_ts_key) = sx;
+        std::get<2>(per_core_ts_key) = sy;
+        std::get<3>(per_core_ts_key) = src_device_id;
+        auto it = chunk.per_core_ts.find(per_core_ts_key);
+        if (it == chunk.per_core_ts.end()) {
+            chunk.per_core_ts[per_core_ts_key] = {ts, ts};
+        } else {
+            auto &minmax_ts = it->second;
+            minmax_ts.first = std::min(minmax_ts.first, ts);
+            minmax_ts.second = std::max(minmax_ts.second, ts);
+        }
+    }
+    auto risc_type = magic_enum::enum_cast<RiscType>(proc);
+    if (risc_type && sx != -1 && sy != -1 && event.zone != "" && event.zone_phase != "") {
+        // unrecognised phases (such as the "begin"/"end" of older
+        // traces) read as ZONE_START; zone timestamps are rebased once
+        // t0 is known
+        std::pair core_proc{Coord(src_device_id, sy, sx), *risc_type};
+        auto [it, inserted] = chunk.zones.try_emplace(core_proc);
+        if (inserted) {
+            chunk.zone_cores.push_back(core_proc);
+        }
+        it->second.push_back(npeZone(
+            ts,
+            std::string(event.zone),
+            magic_enum::enum_cast<ZonePhase>(event.zone_phase).value_or(ZonePhase::ZONE_START)));
+    }
+
+    size_t transfers_begin = chunk.transfers.size();
+    npeWorkloadTransferGroupID transfer_group_id = chunk.num_transfer_groups;
+    auto result = ingestEvent(event, batch, arch, device_name, chunk, true);
+    if (result.uses_unknown_saved_state && chunk.transfers.size() > transfers_begin) {
+        chunk.deferred_events.push_back(deferWithStateEvent(event, batch, transfers_begin, transfer_group_id));
+    }
+    chunk.zone_replay_events.push_back(
+        {Coord(src_device_id, sy, sx), risc_type, ts, result.interns_zone_path, uint32_t(transfers_begin)});
+}
+
+// Ingests the events of a batch, which make up a chunk of the trace
+void ingestTraceChunk(
+    const NocTraceEventBatch &batch, DeviceArch arch, const std::string &device_name, TraceIngestChunk &chunk) {
+    std::tuple<std::string, int64_t, int64_t, int64_t> per_core_ts_key;
+    for (const auto &event : batch.events) {
+        ingestTraceEvent(event, batch, arch, device_name, chunk, per_core_ts_key);
+    }
+}
+
+// Appends chunk, the next chunk of the trace, to trace (the chunks stitched so far)
+void stitchTraceChunk(
+    TraceIngestChunk &trace, TraceIngestChunk &chunk, DeviceArch arch, const std::string &device_name, npeWorkload &wl) {
+    // ingest deferred events again with the state saved by earlier chunks
+    for (auto &deferred : chunk.deferred_events) {
+        auto &event = deferred.batch.events.front();
+        event.proc = deferred.proc;
+        event.type = deferred.type;
+        event.noc = deferred.noc;
+        for (size_t i = 0; i < deferred.route_nocs.size(); i++) {
+            deferred.batch.fabric_routes[i].noc = deferred.route_nocs[i];
+        }
+        TraceIngestChunk reingested;
+        reingested.saved_state_read = trace.saved_state_read;
+        reingested.saved_state_write = trace.saved_state_write;
+        reingested.num_transfer_groups = deferred.transfer_group_id;
+        ingestEvent(event, deferred.batch, arch, device_name, reingested, false);
+        std::copy(
+            reingested.transfers.begin(),
+            reingested.transfers.end(),
+            chunk.transfers.begin() + deferred.transfers_begin);
+    }
+    if (chunk.saved_state_read) {
+        trace.saved_state_read = chunk.saved_state_read;
+    }
+    if (chunk.saved_state_write) {
+        trace.saved_state_write = chunk.saved_state_write;
+    }
+
+    npeWorkloadTransferGroupID transfer_group_id_base = wl.getNumTransferGroups();
+    for (npeWorkloadTransferGroupID i = 0; i < chunk.num_transfer_groups; i++) {
+        wl.registerTransferGroupID();
+    }
+    uint32_t transfers_base = trace.transfers.size();
+    for (auto &transfer : chunk.transfers) {
+        if (transfer.transfer_group_id != -1) {
+            transfer.transfer_group_id += transfer_group_id_base;
+        }
+        trace.transfers.push_back(std::move(transfer));
+    }
+    for (auto &replay_event : chunk.zone_replay_events) {
+        replay_event.transfers_begin += transfers_base;
+        trace.zone_replay_events.push_back(replay_event);
+    }
+
+    trace.t0_timestamp = std::min(trace.t0_timestamp, chunk.t0_timestamp);
+    for (const auto &[key, minmax_ts] : chunk.per_core_ts) {
+        auto [it, inserted] = trace.per_core_ts.try_emplace(key, minmax_ts);
+        if (!inserted) {
+            it->second.first = std::min(it->second.first, minmax_ts.first);
+            it->second.second = std::max(it->second.second, minmax_ts.second);
+        }
+    }
+    for (const auto &core_proc : chunk.zone_cores) {
+        auto &chunk_zones = chunk.zones[core_proc];
+        auto [it, inserted] = trace.zones.try_emplace(core_proc);
+        if (inserted) {
+            trace.zone_cores.push_back(core_proc);
+        }
+        it->second.insert(
+            it->second.end(), std::make_move_iterator(chunk_zones.begin()), std::make_move_iterator(chunk_zones.end()));
+    }
+}
+
+// Builds the workload from trace, once all of its chunks have been stitched:
+// rebases cycle offsets and zones to t0, and assigns zone paths to transfers
+void finishTraceIngest(TraceIngestChunk &trace, std::unique_ptr<npeDeviceModel> &device_model, npeWorkload &wl) {
+    Cycle t0_timestamp = trace.t0_timestamp;
+    wl.setGoldenResultCycles(computeGoldenCycles(trace.per_core_ts, t0_timestamp, device_model));
+    for (auto &[core_proc, zone_list] : trace.zones) {
+        for (auto &zone : zone_list) {
+            zone.timestamp -= double(t0_timestamp);
+        }
+    }
+    wl.setZones(std::move(trace.zones));
+
+    std::pair<Coord, RiscType> prev_core_proc;
+    std::unique_ptr<ZoneIterator> zone_iterator;
+    // interned path of zone_iterator's enclosing zones; only re-flattened after it moves
+    npeZonePathID enclosing_zone_path_id = EMPTY_ZONE_PATH;
+    bool enclosing_zone_path_stale = true;
+    npeWorkloadPhase phase;
+    phase.transfers = std::move(trace.transfers);
+    const auto &zone_replay_events = trace.zone_replay_events;
+    for (size_t i = 0; i < zone_replay_events.size(); i++) {
+        const auto &replay_event = zone_replay_events[i];
+        Cycle ts = replay_event.timestamp;
+
+        // initialize (or re-initialize) zone_iterator for current core and
+        // increment until we reach the last zone that is <= (ts - t0_timestamp)
+        if (replay_event.risc_type.has_value()) {
+            std::pair<Coord, RiscType> core_proc = {replay_event.core, *replay_event.risc_type};
+            try {
+                if (wl.getZones().contains(core_proc)) {
+                    if (core_proc != prev_core_proc) {
+                        zone_iterator = make_unique<ZoneIterator>(wl.getZones()[core_proc]);
+                        prev_core_proc = core_proc;
+                        enclosing_zone_path_stale = true;
+                    }
+                    while (!zone_iterator->isEnd() && zone_iterator->getNextZone().timestamp <= ts - t0_timestamp) {
+                        ++(*zone_iterator);
+                        enclosing_zone_path_stale = true;
+                    }
+                }
+            } catch (const tt_npe::npeException &exp) {
+                throw npeException(npeErrorCode::TRACE_INGEST_FAILED, "Zones are not correctly structured");
+            }
+        }
+
+        // flatten enclosing_zones and intern in workload's zone path pool
+        if (replay_event.interns_zone_path && enclosing_zone_path_stale && zone_iterator) {
+            enclosing_zone_path_id =
+                wl.internZonePath(flattenEnclosingZones(zone_iterator->getEnclosingZones()));
+            enclosing_zone_path_stale = false;
+        }
+
+        size_t transfers_end = i + 1 < zone_replay_events.size() ? zone_replay_events[i + 1].transfers_begin
+                                                                  : phase.transfers.size();
+        for (size_t t = replay_event.transfers_begin; t < transfers_end; t++) {
+            phase.transfers[t].phase_cycle_offset -= t0_timestamp;
+            phase.transfers[t].enclosing_zone_path_id = enclosing_zone_path_id;
         }
     }
     wl.addPhase(phase);
+}
+
+std::optional<npeWorkload> convertNocTracesToNpeWorkload(
+    const std::string &input_filepath,
+    const std::string &device_name,
+    bool verbose,
+    size_t num_threads,
+    size_t chunk_size) {
+    ScopedTimer st("", true);
+    npeWorkload wl;
+
+    auto device_model =
+        npeDeviceModelFactory::createDeviceModel(device_name);
+    DeviceArch arch = device_model->getArch();
+
+    if (not std::filesystem::exists(input_filepath)) {
+        log_error("Provided input file '{}' is not a valid file!", input_filepath);
+        return {};
+    }
+
+    // Chunks of the trace are read in rounds of one per thread, and ingested
+    // concurrently. Ingest state that carries across events (the SET_STATE
+    // saved state, zones, transfer group IDs) is stitched in trace order, so
+    // the workload is the same for any number of threads. The saved state
+    // starts zeroed.
+    TraceIngestChunk trace;
+    trace.saved_state_read = NoCEventSavedState{};
+    trace.saved_state_write = NoCEventSavedState{};
+    npeNocTraceReader reader(input_filepath, chunk_size);
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<NocTraceChunk> raw_chunks(num_threads);
+    bool at_end = false;
+    while (!at_end) {
+        size_t num_chunks = 0;
+        while (num_chunks < num_threads && reader.readChunk(raw_chunks[num_chunks])) {
+            num_chunks++;
+        }
+        at_end = num_chunks < num_threads;
+
+        std::vector<TraceIngestChunk> chunks(num_chunks);
+        std::vector<std::exception_ptr> errors(num_chunks);
+        std::atomic<size_t> next_chunk_idx = 0;
+        std::atomic<bool> decode_failed = false;
+        auto run_worker = [&]() {
+            simdjson::ondemand::parser parser;
+            NocTraceEventBatch batch;
+            for (size_t idx = next_chunk_idx++; idx < num_chunks; idx = next_chunk_idx++) {
+                if (!reader.decodeChunk(raw_chunks[idx], parser, batch)) {
+                    decode_failed = true;
+                    continue;
+                }
+                try {
+                    ingestTraceChunk(batch, arch, device_name, chunks[idx]);
+                } catch (...) {
+                    errors[idx] = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < std::min(num_threads, num_chunks); i++) {
+            workers.emplace_back(run_worker);
+        }
+        run_worker();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        for (size_t idx = 0; idx < num_chunks; idx++) {
+            if (errors[idx]) {
+                std::rethrow_exception(errors[idx]);
+            }
+        }
+        if (decode_failed) {
+            return {};
+        }
+        for (auto &chunk : chunks) {
+            stitchTraceChunk(trace, chunk, arch, device_name, wl);
+        }
+    }
+    if (reader.hasFailed()) {
+        return {};
+    }
+
+    finishTraceIngest(trace, device_model, wl);
 
     wl.setSourceFilePath(input_filepath);
 
@@ -659,8 +963,351 @@ std::optional<npeWorkload> convertNocTracesToNpeWorkload(
     return wl;
 }
 
+namespace {
+
+// true if name matches pattern, where '*' matches any run of characters and
+// '?' matches any one character
+bool matchesWildcard(std::string_view pattern, std::string_view name) {
+    size_t p = 0, n = 0;
+    size_t star_p = std::string_view::npos, star_n = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            p++;
+            n++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star_p = p++;
+            star_n = n;
+        } else if (star_p != std::string_view::npos) {
+            p = star_p + 1;
+            n = ++star_n;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+// Expands a trace file pattern whose filename may contain wildcards to the
+// matching files in its directory, in sorted order. A pattern without
+// wildcards is returned as is.
+std::vector<std::string> expandTraceFilePattern(const std::string &pattern) {
+    std::filesystem::path pattern_path(pattern);
+    std::string filename_pattern = pattern_path.filename().string();
+    if (filename_pattern.find_first_of("*?") == std::string::npos) {
+        return {pattern};
+    }
+    std::filesystem::path dir = pattern_path.parent_path();
+    std::vector<std::string> matches;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(dir.empty() ? "." : dir, ec)) {
+        if (entry.is_regular_file() && matchesWildcard(filename_pattern, entry.path().filename().string())) {
+            matches.push_back((dir / entry.path().filename()).string());
+        }
+    }
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+// Loads the workload converted from input_files as described by
+// converter_options from the cache in cache_dir if it is there; otherwise
+// converts it with convert() and caches it. The workload's source file is the
+// first input file.
+template <typename ConvertFn>
+std::optional<npeWorkload> convertWithCache(
+    const std::string &cache_dir,
+    const std::vector<std::string> &input_files,
+    std::string_view converter_options,
+    bool verbose,
+    ConvertFn &&convert) {
+    npeWorkloadCache cache(cache_dir);
+    auto key = cache.computeKey(
+        input_files, fmt::format("v{};{}", WORKLOAD_CONVERTER_VERSION, converter_options));
+    if (key) {
+        ScopedTimer st("", true);
+        if (auto wl = cache.load(*key)) {
+            wl->setSourceFilePath(input_files.front());
+            if (verbose)
+                fmt::println(
+                    "Loaded cached workload '{}' in {:.2f} ms",
+                    cache.getEntryPath(*key).string(),
+                    st.getElapsedTimeMicroSeconds() / 1000.0);
+            return wl;
+        }
+    }
+
+    // an input that can not be read is reported by the conversion
+    auto wl = convert();
+    if (wl && key && cache.store(*key, *wl) && verbose) {
+        fmt::println("Cached workload as '{}'", cache.getEntryPath(*key).string());
+    }
+    return wl;
+}
+
+// Owns the strings of decoded trace events, so they outlive the parser that
+// decoded them. Traces have few distinct strings, so each is stored once.
+class TraceStringPool {
+   public:
+    std::string_view intern(std::string_view str) {
+        if (str.empty()) {
+            return {};
+        }
+        auto it = strings.find(str);
+        if (it == strings.end()) {
+            it = strings.emplace(str).first;
+        }
+        return *it;
+    }
+
+   private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+    };
+    // nodes are stable, so views of the strings remain valid as it grows
+    std::unordered_set<std::string, StringHash, std::equal_to<>> strings;
+};
+
+// The events of one of the per-device traces being merged, with the paths of
+// fabric sends elaborated. Their strings refer to the trace's string pool.
+struct DecodedTrace {
+    std::vector<NocTraceEventBatch> batches;
+    TraceStringPool strings;
+};
+
+// Reads the events of the trace at filepath into trace, elaborating the paths
+// of fabric sends from topology. Returns false if the trace could not be read
+// (the error has been logged).
+bool decodeTraceForMerge(const std::string &filepath, const npeFabricTopology &topology, DecodedTrace &trace) {
+    npeNocTraceReader reader(filepath, DEFAULT_TRACE_INGEST_CHUNK_SIZE);
+    simdjson::ondemand::parser parser;
+    NocTraceChunk chunk;
+    while (reader.readChunk(chunk)) {
+        auto &batch = trace.batches.emplace_back();
+        if (!reader.decodeChunk(chunk, parser, batch)) {
+            return false;
+        }
+        // the parser is reused for the next chunk
+        for (auto &route : batch.fabric_routes) {
+            route.noc = trace.strings.intern(route.noc);
+        }
+        for (auto &event : batch.events) {
+            event.proc = trace.strings.intern(event.proc);
+            event.type = trace.strings.intern(event.type);
+            event.noc = trace.strings.intern(event.noc);
+            event.zone = trace.strings.intern(event.zone);
+            event.zone_phase = trace.strings.intern(event.zone_phase);
+            event.fabric_routing.fabric_mux_noc = trace.strings.intern(event.fabric_routing.fabric_mux_noc);
+            if (event.has_fabric_send) {
+                topology.elaborateFabricPath(event, batch);
+            }
+        }
+    }
+    return !reader.hasFailed();
+}
+
+// Runs fn(idx) for each idx in [0, num_items) on up to num_threads threads
+// (including the calling thread), then rethrows the first exception thrown
+template <typename Fn>
+void forEachConcurrently(size_t num_items, size_t num_threads, Fn &&fn) {
+    std::vector<std::exception_ptr> errors(num_items);
+    std::atomic<size_t> next_idx = 0;
+    auto run_worker = [&]() {
+        for (size_t idx = next_idx++; idx < num_items; idx = next_idx++) {
+            try {
+                fn(idx);
+            } catch (...) {
+                errors[idx] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < std::min(num_threads, num_items); i++) {
+        workers.emplace_back(run_worker);
+    }
+    run_worker();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    for (auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace
+
+std::optional<npeWorkload> convertNocTraceFilesToNpeWorkload(
+    const std::vector<std::string> &trace_files,
+    const std::string &topology_filepath,
+    const std::string &device_name,
+    bool verbose,
+    size_t num_threads,
+    const std::string &cache_dir) {
+    if (!cache_dir.empty()) {
+        // the merged workload depends on the traces matched by each pattern
+        // and the topology; patterns matching nothing are reported when merging
+        std::vector<std::string> input_files;
+        bool all_matched = true;
+        for (const auto &trace_file : trace_files) {
+            auto matches = expandTraceFilePattern(trace_file);
+            all_matched &= !matches.empty();
+            input_files.insert(input_files.end(), matches.begin(), matches.end());
+        }
+        input_files.push_back(topology_filepath);
+        auto convert = [&]() {
+            return convertNocTraceFilesToNpeWorkload(trace_files, topology_filepath, device_name, verbose, num_threads);
+        };
+        if (!all_matched) {
+            return convert();
+        }
+        return convertWithCache(cache_dir, input_files, fmt::format("merge;{}", device_name), verbose, convert);
+    }
+
+    ScopedTimer st("", true);
+    npeWorkload wl;
+
+    try {
+        auto topology = npeFabricTopology::readFromFile(topology_filepath);
+        if (!topology) {
+            return {};
+        }
+        std::string model_name = device_name.empty() ? topology->getClusterType() : device_name;
+        auto device_model = npeDeviceModelFactory::createDeviceModel(model_name);
+        DeviceArch arch = device_model->getArch();
+
+        std::vector<std::string> trace_filepaths;
+        for (const auto &trace_file : trace_files) {
+            auto matches = expandTraceFilePattern(trace_file);
+            if (matches.empty()) {
+                log_error("No noc trace files match '{}'", trace_file);
+                return {};
+            }
+            trace_filepaths.insert(trace_filepaths.end(), matches.begin(), matches.end());
+        }
+        if (trace_filepaths.empty()) {
+            log_error("No noc trace files to merge!");
+            return {};
+        }
+        for (const auto &filepath : trace_filepaths) {
+            if (not std::filesystem::exists(filepath)) {
+                log_error("Provided input file '{}' is not a valid file!", filepath);
+                return {};
+            }
+        }
+        if (num_threads == 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // decode the traces concurrently
+        std::vector<DecodedTrace> traces(trace_filepaths.size());
+        std::atomic<bool> decode_failed = false;
+        forEachConcurrently(traces.size(), num_threads, [&](size_t idx) {
+            if (!decodeTraceForMerge(trace_filepaths[idx], *topology, traces[idx])) {
+                decode_failed = true;
+            }
+        });
+        if (decode_failed) {
+            return {};
+        }
+
+        struct MergedEvent {
+            const NocTraceEvent *event;
+            const NocTraceEventBatch *batch;
+        };
+        std::vector<MergedEvent> events;
+        for (const auto &trace : traces) {
+            for (const auto &batch : trace.batches) {
+                for (const auto &event : batch.events) {
+                    events.push_back({&event, &batch});
+                }
+            }
+        }
+
+        // Device clocks are synchronized when the traces are captured; if
+        // they drift apart, the timestamps of the events that follow jump
+        // ahead. Those events are dropped.
+        std::vector<Cycle> timestamps(events.size());
+        for (size_t i = 0; i < events.size(); i++) {
+            timestamps[i] = events[i].event->timestamp;
+        }
+        std::sort(timestamps.begin(), timestamps.end());
+        for (size_t i = 1; i < timestamps.size(); i++) {
+            Cycle prev_ts = timestamps[i - 1];
+            if (timestamps[i] > 2 * prev_ts && prev_ts > 1000) {
+                Cycle desync_ts = timestamps[i];
+                std::erase_if(events, [&](const auto &merged) { return merged.event->timestamp >= desync_ts; });
+                log_warn(
+                    "Device timestamps desynchronized at cycle {} (next event at cycle {}); dropped {} events",
+                    prev_ts,
+                    desync_ts,
+                    timestamps.size() - i);
+                break;
+            }
+        }
+
+        // events of each core are ordered by timestamp, then by the order of
+        // the traces given
+        std::stable_sort(events.begin(), events.end(), [](const MergedEvent &lhs, const MergedEvent &rhs) {
+            const auto &l = *lhs.event;
+            const auto &r = *rhs.event;
+            return std::tie(l.src_device_id, l.sx, l.sy, l.proc, l.timestamp) <
+                   std::tie(r.src_device_id, r.sx, r.sy, r.proc, r.timestamp);
+        });
+
+        // ingest the merged events in chunks, one per thread, then stitch
+        // them together in order (as for a single trace)
+        size_t num_chunks = std::max<size_t>(1, std::min(num_threads, events.size()));
+        std::vector<TraceIngestChunk> chunks(num_chunks);
+        forEachConcurrently(num_chunks, num_threads, [&](size_t idx) {
+            std::tuple<std::string, int64_t, int64_t, int64_t> per_core_ts_key;
+            size_t begin = events.size() * idx / num_chunks;
+            size_t end = events.size() * (idx + 1) / num_chunks;
+            for (size_t i = begin; i < end; i++) {
+                ingestTraceEvent(*events[i].event, *events[i].batch, arch, model_name, chunks[idx], per_core_ts_key);
+            }
+        });
+        TraceIngestChunk trace;
+        trace.saved_state_read = NoCEventSavedState{};
+        trace.saved_state_write = NoCEventSavedState{};
+        for (auto &chunk : chunks) {
+            stitchTraceChunk(trace, chunk, arch, model_name, wl);
+        }
+
+        finishTraceIngest(trace, device_model, wl);
+        wl.setSourceFilePath(trace_filepaths.front());
+
+        if (verbose)
+            fmt::println(
+                "Merged {} noc traces ({} events) in {:.2f} ms",
+                trace_filepaths.size(),
+                events.size(),
+                st.getElapsedTimeMicroSeconds() / 1000.0);
+    } catch (const tt_npe::npeException &exp) {
+        tt_npe::log_error("{}", exp.what());
+        return std::nullopt;
+    }
+    return wl;
+}
+
 std::optional<npeWorkload> createWorkloadFromJSON(
-    const std::string &wl_filename, const std::string &device_name, bool is_tt_metal_trace_format, bool verbose) {
+    const std::string &wl_filename,
+    const std::string &device_name,
+    bool is_tt_metal_trace_format,
+    bool verbose,
+    const std::string &cache_dir) {
+    if (!cache_dir.empty()) {
+        return convertWithCache(
+            cache_dir,
+            {wl_filename},
+            fmt::format("{};{}", is_tt_metal_trace_format ? "noc_trace" : "workload", device_name),
+            verbose,
+            [&]() { return createWorkloadFromJSON(wl_filename, device_name, is_tt_metal_trace_format, verbose); });
+    }
+
     try {
         if (is_tt_metal_trace_format) {
             return convertNocTracesToNpeWorkload(wl_filename, device_name, verbose);
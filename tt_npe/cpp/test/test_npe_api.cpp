@@ -1,11 +1,17 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
 
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
 #include "gtest/gtest.h"
 #include "ingestWorkload.hpp"
 #include "npeAPI.hpp"
+#include "npeBinaryTimeline.hpp"
 #include "npeCommon.hpp"
 #include "npeConfig.hpp"
+#include "npeSeekableTimeline.hpp"
 
 namespace tt_npe {
 
@@ -25,6 +31,23 @@ TEST(npeAPITest, CanCatchInvalidConfig) {
     npeConfig cfg;
     cfg.cycles_per_timestep = 0;
     EXPECT_THROW(npeAPI api(cfg), npeException);
+
+    cfg = npeConfig();
+    cfg.timeline_compression_level = 1000;
+    EXPECT_THROW(npeAPI api(cfg), npeException);
+
+    cfg = npeConfig();
+    cfg.timeline_compression_num_workers = -1;
+    EXPECT_THROW(npeAPI api(cfg), npeException);
+
+    cfg = npeConfig();
+    cfg.seekable_timeline_output_file = true;
+    EXPECT_THROW(npeAPI api(cfg), npeException);
+
+    cfg = npeConfig();
+    cfg.emit_binary_timeline_file = true;
+    cfg.use_legacy_timeline_format = true;
+    EXPECT_THROW(npeAPI api(cfg), npeException);
 }
 
 TEST(npeAPITest, ValidatesMulticastUtilizationFromTrace) {
@@ -52,4 +75,249 @@ TEST(npeAPITest, ValidatesMulticastUtilizationFromTrace) {
     EXPECT_NEAR(observed_mcast_share, kExpectedMcastShare, 1e-3);
 }
 
+TEST(npeAPITest, CanStreamTimelineFile) {
+    auto workload =
+        createWorkloadFromJSON("cpp/test/data/mcast-util-trace-small.json", "wormhole_b0", true);
+    ASSERT_TRUE(workload.has_value());
+
+    auto timeline_dir = std::filesystem::path(::testing::TempDir()) / "npe_stream_timeline";
+    std::filesystem::create_directories(timeline_dir);
+
+    npeConfig cfg;
+    cfg.device_name = "wormhole_b0";
+    cfg.cycles_per_timestep = 32;
+    cfg.emit_timeline_file = true;
+    cfg.timeline_filepath = (timeline_dir / "timeline.npeviz").string();
+    cfg.timeline_split_threshold_timesteps = 4;
+
+    npeAPI api(cfg);
+    auto result = api.runNPE(*workload);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+    const auto &stats = std::get<npeStats>(result);
+    size_t num_timesteps = stats.per_device_stats.at(MESH_DEVICE).per_timestep_stats.size();
+    ASSERT_GT(num_timesteps, cfg.timeline_split_threshold_timesteps);
+
+    auto read_file = [](const std::filesystem::path &path) {
+        std::ifstream ifs(path);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        return ss.str();
+    };
+
+    // Streamed output must match, byte for byte, the timeline and split files
+    // written by the nlohmann::json DOM serializer it replaced; the golden
+    // files were produced by that serializer with this workload and config.
+    const std::filesystem::path golden_dir = "cpp/test/data/mcast-util-trace-small-timeline";
+    std::string timeline = read_file(cfg.timeline_filepath);
+    EXPECT_EQ(timeline, read_file(golden_dir / "timeline.npeviz"));
+    auto timeline_json = nlohmann::json::parse(timeline);
+    EXPECT_EQ(timeline_json["common_info"]["version"], npeStats::CURRENT_TIMELINE_SCHEMA_VERSION);
+    EXPECT_EQ(timeline_json["timestep_data"].size(), num_timesteps);
+
+    size_t num_splits = (num_timesteps + 3) / 4;
+    size_t num_golden_splits = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(golden_dir)) {
+        num_golden_splits += entry.path().filename().string().starts_with("timeline_split_");
+    }
+    EXPECT_EQ(num_splits, num_golden_splits);
+    for (size_t split_idx = 0; split_idx < num_splits; split_idx++) {
+        auto split_filename = fmt::format("timeline_split_{}.npeviz", split_idx);
+        EXPECT_EQ(read_file(timeline_dir / split_filename), read_file(golden_dir / split_filename))
+            << split_filename;
+    }
+
+    std::filesystem::remove_all(timeline_dir);
+}
+
+TEST(npeAPITest, CanEmitBinaryTimeline) {
+    auto workload =
+        createWorkloadFromJSON("cpp/test/data/mcast-util-trace-small.json", "wormhole_b0", true);
+    ASSERT_TRUE(workload.has_value());
+
+    auto timeline_dir = std::filesystem::path(::testing::TempDir()) / "npe_binary_timeline";
+    std::filesystem::create_directories(timeline_dir);
+
+    npeConfig cfg;
+    cfg.device_name = "wormhole_b0";
+    cfg.cycles_per_timestep = 32;
+    cfg.emit_timeline_file = true;
+    cfg.emit_binary_timeline_file = true;
+    cfg.timeline_filepath = (timeline_dir / "timeline.npeviz").string();
+
+    npeAPI api(cfg);
+    auto result = api.runNPE(*workload);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+
+    std::ifstream ifs(cfg.timeline_filepath);
+    auto timestep_data = nlohmann::json::parse(ifs)["timestep_data"];
+    auto timeline = npeBinaryTimeline::readFromFile((timeline_dir / "timeline.npetl").string());
+    ASSERT_TRUE(timeline.has_value());
+    EXPECT_EQ(timeline->device_name, "wormhole_b0");
+    EXPECT_EQ(timeline->cycles_per_timestep, 32);
+
+    // binary timestep data must match the .npeviz timestep data
+    ASSERT_EQ(timeline->numTimesteps(), timestep_data.size());
+    for (size_t i = 0; i < timeline->numTimesteps(); i++) {
+        const auto &timestep = timestep_data[i];
+        EXPECT_EQ(timeline->start_cycle[i], timestep["start_cycle"]);
+        EXPECT_EQ(timeline->end_cycle[i], timestep["end_cycle"]);
+        EXPECT_FLOAT_EQ(timeline->avg_link_demand[i], timestep["avg_link_demand"].get<float>());
+        EXPECT_FLOAT_EQ(timeline->max_noc1_link_demand[i], timestep["noc"]["NOC1"]["max_link_demand"].get<float>());
+
+        std::vector<int32_t> active_transfers(
+            timeline->active_transfers.begin() + timeline->active_transfer_offsets[i],
+            timeline->active_transfers.begin() + timeline->active_transfer_offsets[i + 1]);
+        EXPECT_EQ(nlohmann::json(active_transfers), timestep["active_transfers"]);
+
+        const auto &link_demand = timestep["link_demand"];
+        ASSERT_EQ(timeline->demand_offsets[i + 1] - timeline->demand_offsets[i], link_demand.size());
+        for (size_t j = 0; j < link_demand.size(); j++) {
+            size_t entry = timeline->demand_offsets[i] + j;
+            const auto &endpoint = timeline->endpoints[timeline->demand_endpoint[entry]];
+            EXPECT_EQ(
+                nlohmann::json({endpoint.device_id, endpoint.row, endpoint.col, endpoint.type, timeline->demand[entry]}),
+                link_demand[j]);
+        }
+    }
+    EXPECT_FALSE(timeline->demand.empty());
+
+    std::filesystem::remove_all(timeline_dir);
+}
+
+TEST(npeAPITest, CanRoundTripBinaryTimeline) {
+    npeBinaryTimeline timeline;
+    timeline.device_name = "T3K";
+    timeline.arch = "wormhole_b0";
+    timeline.cycles_per_timestep = 128;
+    timeline.endpoints = {{0, 1, 2, "NOC0_IN"}, {7, 9, 8, "NOC1_NORTH"}, {3, 0, 0, "NOC0_IN"}};
+    // includes a trailing timestep that goes back in time, as finishSimulation may emit
+    timeline.start_cycle = {0, 128, 256, 0};
+    timeline.end_cycle = {128, 256, 1000, 0};
+    for (auto *column :
+         {&timeline.avg_link_demand,
+          &timeline.avg_link_util,
+          &timeline.mcast_write_link_util,
+          &timeline.avg_noc0_link_demand,
+          &timeline.avg_noc0_link_util,
+          &timeline.max_noc0_link_demand,
+          &timeline.avg_noc1_link_demand,
+          &timeline.avg_noc1_link_util,
+          &timeline.max_noc1_link_demand}) {
+        *column = {0.5f, 12.25f, 0.0f, 100.0f};
+    }
+    timeline.active_transfer_offsets = {0, 2, 5, 5, 5};
+    timeline.active_transfers = {3, 1000, 0, 7, 123456};
+    timeline.demand_offsets = {0, 1, 3, 3, 3};
+    timeline.demand_endpoint = {2, 0, 1};
+    timeline.demand = {1.5f, 400.0f, 0.0078125f};
+
+    auto filepath = (std::filesystem::path(::testing::TempDir()) / "npe_round_trip.npetl").string();
+    ASSERT_TRUE(timeline.writeToFile(filepath));
+    auto read_timeline = npeBinaryTimeline::readFromFile(filepath);
+    ASSERT_TRUE(read_timeline.has_value());
+    EXPECT_EQ(read_timeline->device_name, timeline.device_name);
+    EXPECT_EQ(read_timeline->arch, timeline.arch);
+    EXPECT_EQ(read_timeline->cycles_per_timestep, timeline.cycles_per_timestep);
+    EXPECT_EQ(read_timeline->endpoints, timeline.endpoints);
+    EXPECT_EQ(read_timeline->start_cycle, timeline.start_cycle);
+    EXPECT_EQ(read_timeline->end_cycle, timeline.end_cycle);
+    EXPECT_EQ(read_timeline->avg_noc1_link_util, timeline.avg_noc1_link_util);
+    EXPECT_EQ(read_timeline->active_transfer_offsets, timeline.active_transfer_offsets);
+    EXPECT_EQ(read_timeline->active_transfers, timeline.active_transfers);
+    EXPECT_EQ(read_timeline->demand_offsets, timeline.demand_offsets);
+    EXPECT_EQ(read_timeline->demand_endpoint, timeline.demand_endpoint);
+    EXPECT_EQ(read_timeline->demand, timeline.demand);
+
+    // truncated files are rejected
+    std::filesystem::resize_file(filepath, std::filesystem::file_size(filepath) - 1);
+    EXPECT_FALSE(npeBinaryTimeline::readFromFile(filepath).has_value());
+    std::filesystem::remove(filepath);
+    EXPECT_FALSE(npeBinaryTimeline::readFromFile(filepath).has_value());
+}
+
+TEST(npeAPITest, CanEmitSeekableTimeline) {
+    auto workload =
+        createWorkloadFromJSON("cpp/test/data/mcast-util-trace-small.json", "wormhole_b0", true);
+    ASSERT_TRUE(workload.has_value());
+
+    auto timeline_dir = std::filesystem::path(::testing::TempDir()) / "npe_seekable_timeline";
+    std::filesystem::create_directories(timeline_dir);
+
+    npeConfig cfg;
+    cfg.device_name = "wormhole_b0";
+    cfg.cycles_per_timestep = 32;
+    cfg.emit_timeline_file = true;
+    cfg.timeline_split_threshold_timesteps = 4;
+
+    // the full timeline emitted without compression serves as the reference for region timesteps
+    cfg.timeline_filepath = (timeline_dir / "split.npeviz").string();
+    npeAPI split_api(cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(split_api.runNPE(*workload)));
+
+    cfg.compress_timeline_output_file = true;
+    cfg.seekable_timeline_output_file = true;
+    cfg.timeline_filepath = (timeline_dir / "seekable.npeviz").string();
+    npeAPI api(cfg);
+    auto result = api.runNPE(*workload);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+    const auto &per_timestep_stats = std::get<npeStats>(result).per_device_stats.at(MESH_DEVICE).per_timestep_stats;
+    size_t num_splits = (per_timestep_stats.size() + 3) / 4;
+
+    // regions replace split files
+    EXPECT_FALSE(std::filesystem::exists(timeline_dir / "seekable_split_0.npeviz.zst"));
+
+    auto reader = npeSeekableTimelineReader::open(cfg.timeline_filepath + ".zst");
+    ASSERT_TRUE(reader.has_value());
+    const auto &regions = reader->getRegions();
+    ASSERT_EQ(regions.size(), num_splits);
+    std::ifstream full_timeline_file(timeline_dir / "split.npeviz");
+    const auto full_timesteps = nlohmann::json::parse(full_timeline_file)["timestep_data"];
+    ASSERT_EQ(full_timesteps.size(), per_timestep_stats.size());
+    auto all_timesteps = nlohmann::json::array();
+    for (size_t region_idx = 0; region_idx < regions.size(); region_idx++) {
+        const auto &region = regions[region_idx];
+        EXPECT_EQ(region.start_timestep_idx, region_idx * 4);
+        EXPECT_EQ(region.start_cycle, per_timestep_stats[region.start_timestep_idx].start_cycle);
+        EXPECT_EQ(region.end_cycle, per_timestep_stats[region.end_timestep_idx - 1].end_cycle);
+        // regions are frames of the full timeline, laid out back to back
+        if (region_idx > 0) {
+            EXPECT_EQ(region.offset, regions[region_idx - 1].offset + regions[region_idx - 1].size);
+        }
+
+        auto timesteps = reader->readRegion(region_idx);
+        ASSERT_TRUE(timesteps.has_value());
+        auto region_timesteps = nlohmann::json::parse(*timesteps);
+        ASSERT_EQ(region_timesteps.size(), region.end_timestep_idx - region.start_timestep_idx);
+        for (size_t i = 0; i < region_timesteps.size(); i++) {
+            EXPECT_EQ(region_timesteps[i], full_timesteps[region.start_timestep_idx + i]);
+        }
+        all_timesteps.insert(all_timesteps.end(), region_timesteps.begin(), region_timesteps.end());
+    }
+    EXPECT_EQ(all_timesteps, full_timesteps);
+    EXPECT_EQ(reader->findRegion(regions[1].start_cycle + 1), 1);
+    EXPECT_FALSE(reader->readRegion(regions.size()).has_value());
+
+    // timelines that are not split are still indexed, as a single region
+    cfg.timeline_split_threshold_timesteps = per_timestep_stats.size();
+    cfg.timeline_filepath = (timeline_dir / "unsplit.npeviz").string();
+    npeAPI unsplit_api(cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(unsplit_api.runNPE(*workload)));
+    auto unsplit_reader = npeSeekableTimelineReader::open(cfg.timeline_filepath + ".zst");
+    ASSERT_TRUE(unsplit_reader.has_value());
+    ASSERT_EQ(unsplit_reader->getRegions().size(), 1);
+    EXPECT_EQ(unsplit_reader->getRegions()[0].end_timestep_idx, per_timestep_stats.size());
+    auto unsplit_timesteps = unsplit_reader->readRegion(0);
+    ASSERT_TRUE(unsplit_timesteps.has_value());
+    EXPECT_EQ(nlohmann::json::parse(*unsplit_timesteps), all_timesteps);
+
+    // timelines written without seeking have no region index
+    cfg.seekable_timeline_output_file = false;
+    cfg.timeline_filepath = (timeline_dir / "plain.npeviz").string();
+    npeAPI plain_api(cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(plain_api.runNPE(*workload)));
+    EXPECT_FALSE(npeSeekableTimelineReader::open(cfg.timeline_filepath + ".zst").has_value());
+
+    std::filesystem::remove_all(timeline_dir);
+}
+
 }  // namespace tt_npe
\ No newline at end of file
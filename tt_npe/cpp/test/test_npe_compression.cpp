@@ -9,6 +9,8 @@
 #include <random>
 #include <filesystem>
 #include <cstdio>
+#include <cstring>
+#include "fmt/core.h"
 #include "zstd.h"
 
 namespace tt_npe {
@@ -56,6 +58,27 @@ std::string decompressZstd(const std::string& compressedData) {
     return std::string(decompressedBuffer.data(), result);
 }
 
+// Helper function to decompress zstd data written without a known content size
+std::string decompressZstdStream(const std::string& compressedData) {
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    std::vector<char> outBuffer(ZSTD_DStreamOutSize());
+    std::string decompressedData;
+
+    ZSTD_inBuffer input = {compressedData.data(), compressedData.size(), 0};
+    while (input.pos < input.size) {
+        ZSTD_outBuffer output = {outBuffer.data(), outBuffer.size(), 0};
+        size_t result = ZSTD_decompressStream(dctx, &output, &input);
+        if (ZSTD_isError(result)) {
+            ZSTD_freeDCtx(dctx);
+            return "";
+        }
+        decompressedData.append(outBuffer.data(), output.pos);
+    }
+
+    ZSTD_freeDCtx(dctx);
+    return decompressedData;
+}
+
 class NpeCompressionUtilTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -213,4 +236,117 @@ TEST_F(NpeCompressionUtilTest, CompressOverwriteExistingFile) {
     EXPECT_EQ(decompressedData, content2);
 }
 
+TEST_F(NpeCompressionUtilTest, CompressStreamInChunks) {
+    // mix of small writes (buffered) and large writes (compressed in place)
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 25);
+    std::vector<std::string> chunks;
+    for (int i = 0; i < 2000; i++) {
+        chunks.push_back(std::string(i % 7 + 1, static_cast<char>('a' + dist(rng))));
+    }
+    chunks.push_back(std::string(3 * 1024 * 1024, 'Z'));
+    chunks.push_back("tail");
+
+    std::string content;
+    for (const auto& chunk : chunks) {
+        content += chunk;
+    }
+
+    for (int num_workers : {0, 1, 4}) {
+        std::string filepath = (tempDir / fmt::format("stream_{}.zst", num_workers)).string();
+        {
+            npeCompressedFileStream os(filepath, 3, num_workers);
+            EXPECT_TRUE(os.good());
+            for (const auto& chunk : chunks) {
+                os.write(chunk.data(), chunk.size());
+            }
+            os << 'X';
+            EXPECT_TRUE(os.close());
+        }
+
+        std::string compressedData = readFileContents(filepath);
+        EXPECT_LT(compressedData.size(), content.size());
+        EXPECT_EQ(decompressZstdStream(compressedData), content + 'X') << "num_workers = " << num_workers;
+    }
+}
+
+TEST_F(NpeCompressionUtilTest, CompressStreamToInvalidPath) {
+    npeCompressedFileStream os("/nonexistent/directory/file.zst", 3, 1);
+    EXPECT_FALSE(os.good());
+    os << "Test content";
+    EXPECT_FALSE(os.close());
+}
+
+TEST_F(NpeCompressionUtilTest, CompressSeekableStream) {
+    std::string testFile = (tempDir / "test_seekable.zst").string();
+    std::string content;
+    for (int i = 0; i < 1000; i++) {
+        content += "{\"timestep\": " + std::to_string(i) + "},";
+    }
+    std::string payload = "embedded payload";
+
+    npeCompressedFileStream os(testFile, 3, 1, 4096);
+    os << content.substr(0, 10000);
+    auto payload_offset = os.writeSkippableFrame(0x3, payload);
+    ASSERT_TRUE(payload_offset.has_value());
+    os << content.substr(10000, 5000);
+    auto frame_offset_after_end = os.endFrame();
+    ASSERT_TRUE(frame_offset_after_end.has_value());
+    os << content.substr(15000);
+    ASSERT_TRUE(os.close());
+
+    std::ifstream inFile(testFile, std::ios::binary);
+    std::string compressedData((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+
+    // skippable frames (including the seek table) are ignored by decompression
+    EXPECT_EQ(decompressZstdStream(compressedData), content);
+    EXPECT_EQ(compressedData.substr(*payload_offset, payload.size()), payload);
+
+    auto read_le32 = [&](size_t offset) {
+        uint32_t value;
+        std::memcpy(&value, compressedData.data() + offset, sizeof(value));
+        return value;
+    };
+    size_t footer_offset = compressedData.size() - 9;
+    EXPECT_EQ(read_le32(footer_offset + 5), npeCompressedFileStream::SEEKABLE_MAGIC);
+
+    // frames are split at 4096 bytes of content, and both the skippable frame and endFrame() end a frame
+    size_t num_frames = read_le32(footer_offset);
+    size_t expected_frames =
+        (10000 + 4095) / 4096 + 1 + (5000 + 4095) / 4096 + (content.size() - 15000 + 4095) / 4096;
+    ASSERT_EQ(num_frames, expected_frames);
+
+    // each seek table entry describes a frame; together they cover everything before the seek table
+    size_t seek_table_offset = footer_offset - num_frames * 8 - 8;
+    EXPECT_EQ(
+        read_le32(seek_table_offset),
+        npeCompressedFileStream::SKIPPABLE_FRAME_MAGIC | npeCompressedFileStream::SEEK_TABLE_FRAME_VARIANT);
+    size_t frame_offset = 0;
+    size_t decompressed_offset = 0;
+    bool found_ended_frame = false;
+    for (size_t i = 0; i < num_frames; i++) {
+        if (frame_offset == *frame_offset_after_end) {
+            found_ended_frame = true;
+            EXPECT_EQ(decompressed_offset, 15000);
+        }
+        uint32_t compressed_size = read_le32(seek_table_offset + 8 + i * 8);
+        uint32_t decompressed_size = read_le32(seek_table_offset + 12 + i * 8);
+        EXPECT_EQ(
+            decompressZstdStream(compressedData.substr(frame_offset, compressed_size)),
+            content.substr(decompressed_offset, decompressed_size));
+        frame_offset += compressed_size;
+        decompressed_offset += decompressed_size;
+    }
+    EXPECT_EQ(frame_offset, seek_table_offset);
+    EXPECT_EQ(decompressed_offset, content.size());
+    EXPECT_TRUE(found_ended_frame);
+}
+
+TEST_F(NpeCompressionUtilTest, CanValidateCompressionLevel) {
+    EXPECT_TRUE(npeCompressionUtil::isValidCompressionLevel(1));
+    EXPECT_TRUE(npeCompressionUtil::isValidCompressionLevel(ZSTD_CLEVEL_DEFAULT));
+    EXPECT_TRUE(npeCompressionUtil::isValidCompressionLevel(ZSTD_maxCLevel()));
+    EXPECT_FALSE(npeCompressionUtil::isValidCompressionLevel(ZSTD_maxCLevel() + 1));
+}
+
 } // namespace tt_npe
@@ -176,6 +176,28 @@ TEST(npeDeviceTest, TestLinkIDLookupsWormholeMultichip) {
         EXPECT_EQ(model.getLinkID(attr), nocLinkID(id));
     }
 }
+TEST(npeDeviceTest, TestNIUIDLookupsWormholeMultichip) {
+    constexpr size_t num_chips_to_test = 36;
+    WormholeMultichipDeviceModel model(num_chips_to_test);
+
+    // NIU IDs are dense in (device, row, col, type) order
+    nocNIUID expected_id = 0;
+    for (size_t dev_id = 0; dev_id < model.getNumChips(); ++dev_id) {
+        for (int r = 0; r < model.getRows(); r++) {
+            for (int c = 0; c < model.getCols(); c++) {
+                for (const auto &niu_type : model.getNIUTypes()) {
+                    nocNIUAttr attr = {{static_cast<DeviceID>(dev_id), r, c}, niu_type};
+                    EXPECT_EQ(model.getNIUID(attr), expected_id);
+                    EXPECT_EQ(model.getNIUAttributes(expected_id), attr);
+                    expected_id++;
+                }
+            }
+        }
+    }
+    EXPECT_THROW(model.getNIUID({{0, 0, 0}, nocNIUType::MIMIR_SRC}), npeException);
+    EXPECT_THROW(
+        model.getNIUID({{num_chips_to_test, 0, 0}, nocNIUType::NOC0_SRC}), npeException);
+}
 TEST(npeDeviceTest, CanQueryArchUsingDeviceModel) {
     WormholeB0DeviceModel wh_model;
     EXPECT_EQ(wh_model.getArch(), DeviceArch::WormholeB0);
@@ -184,4 +206,289 @@ TEST(npeDeviceTest, CanQueryArchUsingDeviceModel) {
     BlackholeDeviceModel blackhole_model_p150(BlackholeDeviceModel::DRAMHarvestingConfig::NO_HARVESTING);
     EXPECT_EQ(blackhole_model_p150.getArch(), DeviceArch::Blackhole);
 }
+TEST(npeDeviceTest, CanUpdateDemandGridsIncrementally) {
+    WormholeB0DeviceModel model;
+    auto device_state = model.initDeviceState();
+    auto device_id = model.getDeviceID();
+
+    // two transfers sharing the same source NIU; the second starts mid-way
+    // into the first timestep
+    nocRouteArena route_arena;
+    std::vector<nocRouteArena::RouteRef> routes;
+    std::vector<npeWorkloadTransfer> wl_transfers;
+    for (Cycle start_cycle : {Cycle(0), Cycle(96)}) {
+        wl_transfers.emplace_back(
+            2048, 1, Coord{device_id, 1, 1}, Coord{device_id, 1, 5}, 28.1, start_cycle, nocType::NOC0);
+    }
+    std::vector<PETransferState> transfers;
+    for (const auto &wl_transfer : wl_transfers) {
+        Cycle start_cycle = wl_transfer.phase_cycle_offset;
+        auto route = model.route(nocType::NOC0, wl_transfer.src, wl_transfer.dst);
+        routes.push_back(route_arena.intern(route));
+        transfers.emplace_back(wl_transfer, start_cycle, nocRouteView{});
+        resolveTransferNIUs(model, transfers.back());
+        transfers.back().curr_bandwidth = 20;
+    }
+    for (size_t id = 0; id < transfers.size(); id++) {
+        transfers[id].route = route_arena.getRoute(routes[id]);
+    }
+    PETransferHotState hot_state(transfers);
+    auto src_niu = model.getNIUID(1, 1, nocNIUType::NOC0_SRC);
+    auto first_link = transfers[0].route.front();
+
+    const auto &niu_grid = device_state->getNIUDemandGrid();
+    const auto &link_grid = device_state->getLinkDemandGrid();
+
+    device_state->updateDemandGrids(0, 128, hot_state, {0, 1});
+    EXPECT_FLOAT_EQ(niu_grid[src_niu], 20 + 5);
+    EXPECT_FLOAT_EQ(link_grid[first_link], 20 + 5);
+
+    // second transfer now contributes full demand; first transfer has completed
+    device_state->updateDemandGrids(128, 256, hot_state, {1});
+    EXPECT_FLOAT_EQ(niu_grid[src_niu], 20);
+    EXPECT_FLOAT_EQ(link_grid[first_link], 20);
+
+    // all demand is removed once no transfers remain live
+    device_state->updateDemandGrids(256, 384, hot_state, {});
+    for (float demand : niu_grid) {
+        EXPECT_EQ(demand, 0.0f);
+    }
+    for (float demand : link_grid) {
+        EXPECT_EQ(demand, 0.0f);
+    }
+}
+TEST(npeDeviceTest, CanUpdateDemandGridsIdenticallyToFullRecompute) {
+    WormholeB0DeviceModel model;
+    auto device_state = model.initDeviceState();
+    DeviceID device_id = model.getDeviceID();
+
+    std::vector<Coord> workers;
+    for (size_t row = 0; row < model.getRows(); row++) {
+        for (size_t col = 0; col < model.getCols(); col++) {
+            Coord c(device_id, row, col);
+            if (model.getCoreType(c) == CoreType::WORKER) {
+                workers.push_back(c);
+            }
+        }
+    }
+
+    constexpr Cycle cycles_per_timestep = 128;
+    constexpr int num_timesteps = 64;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> bandwidth_dist(1.0f, 30.0f);
+    nocRouteArena route_arena;
+    std::vector<nocRouteArena::RouteRef> routes;
+    std::vector<npeWorkloadTransfer> wl_transfers;
+    std::vector<PETransferState> transfers;
+    wl_transfers.reserve(400);
+    for (int i = 0; i < 400; i++) {
+        Coord src = workers[rng() % workers.size()];
+        Coord dst = workers[rng() % workers.size()];
+        Cycle start_cycle = rng() % (cycles_per_timestep * num_timesteps);
+        nocType noc_type = rng() % 2 ? nocType::NOC0 : nocType::NOC1;
+        const auto &wl_transfer = wl_transfers.emplace_back(2048, 1, src, dst, 28.1, start_cycle, noc_type);
+        auto route = model.route(noc_type, src, dst);
+        routes.push_back(route_arena.intern(route));
+        transfers.emplace_back(wl_transfer, start_cycle, nocRouteView{});
+        resolveTransferNIUs(model, transfers.back());
+        transfers.back().curr_bandwidth = bandwidth_dist(rng);
+    }
+    for (size_t id = 0; id < transfers.size(); id++) {
+        transfers[id].route = route_arena.getRoute(routes[id]);
+    }
+    PETransferHotState hot_state(transfers);
+    for (size_t id = 0; id < hot_state.size(); id++) {
+        hot_state.is_multicast_write[id] = id % 3 == 0;
+    }
+
+    // transfers go live in the timestep they start, and complete at random
+    std::vector<PETransferID> live_transfer_ids;
+    for (int timestep = 0; timestep < num_timesteps; timestep++) {
+        Cycle start_timestep = timestep * cycles_per_timestep;
+        Cycle end_timestep = start_timestep + cycles_per_timestep;
+        std::erase_if(live_transfer_ids, [&](PETransferID) { return rng() % 8 == 0; });
+        for (PETransferID id = 0; id < PETransferID(transfers.size()); id++) {
+            if (transfers[id].start_cycle >= start_timestep &&
+                transfers[id].start_cycle < end_timestep) {
+                live_transfer_ids.push_back(id);
+            }
+        }
+        device_state->updateDemandGrids(
+            start_timestep, end_timestep, hot_state, live_transfer_ids);
+
+        NIUDemandGrid niu_grid(device_state->getNIUDemandGrid().size(), 0.0f);
+        LinkDemandGrid link_grid(device_state->getLinkDemandGrid().size(), 0.0f);
+        LinkDemandGrid multicast_write_link_grid(link_grid.size(), 0.0f);
+        for (auto ltid : live_transfer_ids) {
+            Cycle predicted_start = std::max(start_timestep, hot_state.start_cycle[ltid]);
+            float effective_demand =
+                float(end_timestep - predicted_start) / float(cycles_per_timestep);
+            effective_demand *= hot_state.curr_bandwidth[ltid];
+            niu_grid[hot_state.src_niu_id[ltid]] += effective_demand;
+            for (auto niu_id : hot_state.getSinkNIUIDs(ltid)) {
+                niu_grid[niu_id] += effective_demand;
+            }
+            for (auto link_id : hot_state.route[ltid]) {
+                link_grid[link_id] += effective_demand;
+                if (hot_state.is_multicast_write[ltid]) {
+                    multicast_write_link_grid[link_id] += effective_demand;
+                }
+            }
+        }
+        ASSERT_EQ(device_state->getNIUDemandGrid(), niu_grid) << "timestep " << timestep;
+        ASSERT_EQ(device_state->getLinkDemandGrid(), link_grid) << "timestep " << timestep;
+        ASSERT_EQ(device_state->getMulticastWriteLinkDemandGrid(), multicast_write_link_grid)
+            << "timestep " << timestep;
+    }
+}
+TEST(npeDeviceTest, CanBuildTransferHotState) {
+    WormholeB0DeviceModel model;
+    auto device_id = model.getDeviceID();
+
+    nocRouteArena route_arena;
+    std::vector<nocRouteArena::RouteRef> routes;
+    std::vector<PETransferState> transfers;
+    npeWorkloadTransfer unicast(
+        2048, 2, {device_id, 1, 1}, Coord{device_id, 1, 5}, 28.1, 10, nocType::NOC0);
+    npeWorkloadTransfer multicast(
+        2048,
+        1,
+        {device_id, 1, 1},
+        MulticastCoordSet({device_id, 2, 1}, {device_id, 3, 2}),
+        28.1,
+        20,
+        nocType::NOC0,
+        nocEventType::WRITE_MULTICAST);
+    std::vector<npeWorkloadTransfer> wl_transfers = {unicast, multicast};
+    for (const auto &wl_transfer : wl_transfers) {
+        auto route = model.route(nocType::NOC0, wl_transfer.src, wl_transfer.dst);
+        routes.push_back(route_arena.intern(route));
+        transfers.emplace_back(wl_transfer, wl_transfer.phase_cycle_offset, nocRouteView{});
+        resolveTransferNIUs(model, transfers.back());
+    }
+    for (size_t id = 0; id < transfers.size(); id++) {
+        transfers[id].route = route_arena.getRoute(routes[id]);
+    }
+
+    // workload params are referenced, not copied
+    EXPECT_EQ(transfers[1].params, &wl_transfers[1]);
+
+    PETransferHotState hot_state(transfers);
+    ASSERT_EQ(hot_state.size(), 2);
+    EXPECT_EQ(hot_state.total_bytes[0], 4096);
+    EXPECT_EQ(hot_state.start_cycle[1], 20);
+    EXPECT_FALSE(hot_state.is_multicast[0]);
+    EXPECT_TRUE(hot_state.is_multicast[1]);
+    EXPECT_TRUE(hot_state.is_multicast_write[1]);
+    EXPECT_EQ(hot_state.src_niu_id[0], transfers[0].src_niu_id);
+    EXPECT_EQ(hot_state.route[1].size(), transfers[1].route.size());
+    EXPECT_EQ(hot_state.getSinkNIUIDs(1).size(), transfers[1].sink_niu_ids.size());
+
+    // sink NIU IDs are copied into the hot state rather than aliasing the transfers
+    auto sink_niu_ids = transfers[1].sink_niu_ids;
+    transfers[1].sink_niu_ids.clear();
+    transfers[1].sink_niu_ids.shrink_to_fit();
+    EXPECT_TRUE(std::ranges::equal(hot_state.getSinkNIUIDs(1), sink_niu_ids));
+    EXPECT_EQ(hot_state.getSinkNIUIDs(0).size(), 1);
+
+    // mutable state is only reflected in cold state after writeBack
+    hot_state.total_bytes_transferred[0] = 4096;
+    hot_state.start_cycle[0] = 15;
+    hot_state.end_cycle[0] = 200;
+    EXPECT_TRUE(hot_state.isComplete(0));
+    EXPECT_FALSE(hot_state.isComplete(1));
+    EXPECT_EQ(transfers[0].end_cycle, 0);
+    hot_state.writeBack(0, transfers[0]);
+    EXPECT_EQ(transfers[0].total_bytes_transferred, 4096);
+    EXPECT_EQ(transfers[0].start_cycle, 15);
+    EXPECT_EQ(transfers[0].end_cycle, 200);
+}
+TEST(npeDeviceTest, CanInternRoutesInArena) {
+    WormholeMultichipDeviceModel model(2);
+    nocRouteArena route_arena;
+
+    auto route_a = model.route(nocType::NOC0, {0, 1, 1}, Coord{0, 1, 5});
+    auto route_b = model.route(nocType::NOC1, {0, 1, 1}, Coord{0, 1, 5});
+    auto route_c = model.route(nocType::NOC0, {1, 1, 1}, Coord{1, 1, 5});
+
+    auto ref_a = route_arena.intern(route_a);
+    auto ref_b = route_arena.intern(route_b);
+    auto ref_c = route_arena.intern(route_c);
+    EXPECT_TRUE(std::ranges::equal(route_arena.getRoute(ref_a), route_a));
+    EXPECT_TRUE(std::ranges::equal(route_arena.getRoute(ref_b), route_b));
+    EXPECT_TRUE(std::ranges::equal(route_arena.getRoute(ref_c), route_c));
+
+    // routes are packed back to back
+    EXPECT_EQ(ref_a.offset, 0);
+    EXPECT_EQ(ref_b.offset, ref_a.offset + ref_a.length);
+    EXPECT_EQ(ref_c.offset, ref_b.offset + ref_b.length);
+
+    // same links on a different device must not be shared
+    EXPECT_NE(ref_a.offset, ref_c.offset);
+
+    // identical routes share storage, whether routed directly into the arena or copied in
+    auto ref_a2 = route_arena.addRoute([&](nocRoute &route) {
+        model.appendRoute(nocType::NOC0, {0, 1, 1}, Coord{0, 1, 5}, route);
+    });
+    auto ref_a3 = route_arena.intern(model.route(nocType::NOC0, {0, 1, 1}, Coord{0, 1, 5}));
+    for (auto ref : {ref_a2, ref_a3}) {
+        EXPECT_EQ(ref.offset, ref_a.offset);
+        EXPECT_EQ(ref.length, ref_a.length);
+    }
+    EXPECT_EQ(route_arena.getNumRoutes(), 3);
+    EXPECT_EQ(route_arena.getNumLinks(), route_a.size() + route_b.size() + route_c.size());
+
+    // refs remain valid as arena grows
+    for (int i = 0; i < 100000; i++) {
+        nocRoute route(1 + i % 7, nocLinkID(i % 1000));
+        route_arena.intern(route);
+    }
+    EXPECT_TRUE(std::ranges::equal(route_arena.getRoute(ref_a), route_a));
+    EXPECT_TRUE(std::ranges::equal(route_arena.getRoute(ref_c), route_c));
+    EXPECT_TRUE(route_arena.getRoute(route_arena.intern(nocRoute{})).empty());
+}
+TEST(npeDeviceTest, CanLookupPrecomputedRoutes) {
+    auto check_unicast_routes = [](const auto &model) {
+        DeviceID device_id = model.getDeviceID();
+        for (auto noc_type : {nocType::NOC0, nocType::NOC1}) {
+            for (int sr = 0; sr < model.getRows(); sr++) {
+                for (int sc = 0; sc < model.getCols(); sc++) {
+                    for (int dr = 0; dr < model.getRows(); dr++) {
+                        for (int dc = 0; dc < model.getCols(); dc++) {
+                            Coord src{device_id, sr, sc}, dst{device_id, dr, dc};
+                            ASSERT_EQ(
+                                model.route(noc_type, src, dst),
+                                model.computeUnicastRoute(noc_type, src, dst));
+                        }
+                    }
+                }
+            }
+        }
+    };
+    check_unicast_routes(WormholeB0DeviceModel());
+    check_unicast_routes(BlackholeDeviceModel(BlackholeDeviceModel::DRAMHarvestingConfig::NO_HARVESTING));
+
+    // route table is shared between model instances
+    WormholeB0DeviceModel model_a, model_b;
+    EXPECT_EQ(&model_a.getRouteTable(), &model_b.getRouteTable());
+
+    // multicast routes are cached on first use, regardless of device id
+    const auto &route_table = model_a.getRouteTable();
+    MulticastCoordSet mcast_dst({0, 2, 1}, {0, 3, 4});
+    size_t num_cached = route_table.getNumCachedMulticastRoutes();
+    auto mcast_route = model_a.route(nocType::NOC0, {0, 1, 1}, mcast_dst);
+    EXPECT_EQ(route_table.getNumCachedMulticastRoutes(), num_cached + 1);
+    EXPECT_EQ(model_b.route(nocType::NOC0, {0, 1, 1}, mcast_dst), mcast_route);
+    WormholeMultichipDeviceModel multichip_model(2);
+    auto dev1_mcast_route =
+        multichip_model.route(nocType::NOC0, {1, 1, 1}, MulticastCoordSet({1, 2, 1}, {1, 3, 4}));
+    EXPECT_EQ(route_table.getNumCachedMulticastRoutes(), num_cached + 1);
+    ASSERT_EQ(dev1_mcast_route.size(), mcast_route.size());
+    for (size_t i = 0; i < mcast_route.size(); i++) {
+        auto dev0_attr = multichip_model.getLinkAttributes(mcast_route[i]);
+        auto dev1_attr = multichip_model.getLinkAttributes(dev1_mcast_route[i]);
+        EXPECT_EQ(dev1_attr.coord, (Coord{1, dev0_attr.coord.row, dev0_attr.coord.col}));
+        EXPECT_EQ(dev1_attr.type, dev0_attr.type);
+    }
+}
 }  // namespace tt_npe
@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
 
+#include <filesystem>
+#include <fstream>
+#include <map>
+
 #include "gtest/gtest.h"
 #include "npeEngine.hpp"
+#include "npeLivenessIndex.hpp"
 
 namespace tt_npe {
 
@@ -10,7 +15,7 @@ TEST(npeEngineTest, CanConstructEngineForWormholeB0) { tt_npe::npeEngine engine(
 
 TEST(npeEngineTest, CanRunSimpleWorkload) {
     tt_npe::npeEngine engine("wormhole_b0");
-    auto device_id = 0;
+    DeviceID device_id = 0;
 
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
@@ -25,7 +30,7 @@ TEST(npeEngineTest, CanRunSimpleWorkload) {
 
 TEST(npeEngineTest, CanRunSimpleWorkloadCongestionFree) {
     tt_npe::npeEngine engine("wormhole_b0");
-    auto device_id = 0;
+    DeviceID device_id = 0;
 
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
@@ -39,9 +44,135 @@ TEST(npeEngineTest, CanRunSimpleWorkloadCongestionFree) {
     EXPECT_TRUE(std::holds_alternative<npeStats>(result));
 }
 
+// Runs wl, emitting its timeline files (including the binary timeline and
+// split files) into a fresh directory named dir_name; returns the contents of
+// each file emitted, by filename.
+std::map<std::string, std::string> emitTimelineFiles(
+    const npeEngine &engine, const npeWorkload &wl, npeConfig cfg, const std::string &dir_name) {
+    auto dir = std::filesystem::path(::testing::TempDir()) / dir_name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    cfg.emit_timeline_file = true;
+    cfg.emit_binary_timeline_file = true;
+    cfg.timeline_filepath = (dir / "timeline.npeviz").string();
+    auto result = engine.runPerfEstimation(wl, cfg);
+    EXPECT_TRUE(std::holds_alternative<npeStats>(result));
+
+    std::map<std::string, std::string> files;
+    for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+        std::ifstream ifs(entry.path(), std::ios::binary);
+        files[entry.path().filename().string()] = {
+            std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    }
+    return files;
+}
+
+TEST(npeEngineTest, CanFastForwardIdleTimesteps) {
+    tt_npe::npeEngine engine("wormhole_b0");
+    DeviceID device_id = 0;
+
+    tt_npe::npeWorkload wl;
+    tt_npe::npeWorkloadPhase phase;
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 4, {device_id, 1, 1}, Coord{device_id, 1, 5}, 28.1, 0, nocType::NOC1));
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 4, {device_id, 1, 1}, Coord{device_id, 1, 5}, 28.1, 1000000, nocType::NOC1));
+    wl.addPhase(phase);
+    wl.setGoldenResultCycles({{0, {0, 1000500}}});
+
+    npeConfig cfg;
+    auto result = engine.runPerfEstimation(wl, cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+    cfg.fast_forward_idle_timesteps = true;
+    auto ff_result = engine.runPerfEstimation(wl, cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(ff_result));
+
+    // fast-forwarding must not change results, only how idle timesteps are stored
+    for (auto device : {DeviceID(MESH_DEVICE), device_id}) {
+        const auto &stats = std::get<npeStats>(result).per_device_stats.at(device);
+        const auto &ff_stats = std::get<npeStats>(ff_result).per_device_stats.at(device);
+        EXPECT_EQ(stats.estimated_cycles, ff_stats.estimated_cycles);
+        EXPECT_EQ(stats.estimated_cong_free_cycles, ff_stats.estimated_cong_free_cycles);
+        EXPECT_DOUBLE_EQ(stats.overall_avg_link_demand, ff_stats.overall_avg_link_demand);
+        EXPECT_DOUBLE_EQ(stats.overall_avg_link_util, ff_stats.overall_avg_link_util);
+        EXPECT_DOUBLE_EQ(stats.overall_max_link_demand, ff_stats.overall_max_link_demand);
+        EXPECT_DOUBLE_EQ(stats.overall_avg_niu_demand, ff_stats.overall_avg_niu_demand);
+
+        Timestep ff_num_timesteps = 0;
+        for (const auto &ts : ff_stats.per_timestep_stats) {
+            ff_num_timesteps += ts.num_timesteps;
+        }
+        EXPECT_EQ(ff_num_timesteps, stats.per_timestep_stats.size());
+        EXPECT_LT(ff_stats.per_timestep_stats.size(), 10);
+    }
+
+    // timelines are emitted with one entry per timestep either way
+    cfg.timeline_split_threshold_timesteps = 1000;
+    cfg.fast_forward_idle_timesteps = false;
+    auto timeline_files = emitTimelineFiles(engine, wl, cfg, "npe_timeline_idle");
+    cfg.fast_forward_idle_timesteps = true;
+    auto ff_timeline_files = emitTimelineFiles(engine, wl, cfg, "npe_timeline_idle_ff");
+    EXPECT_GT(timeline_files.size(), 3);
+    EXPECT_TRUE(timeline_files == ff_timeline_files);
+
+    cfg.use_legacy_timeline_format = true;
+    cfg.fast_forward_idle_timesteps = false;
+    auto legacy_timeline_files = emitTimelineFiles(engine, wl, cfg, "npe_timeline_idle_legacy");
+    cfg.fast_forward_idle_timesteps = true;
+    auto ff_legacy_timeline_files = emitTimelineFiles(engine, wl, cfg, "npe_timeline_idle_legacy_ff");
+    EXPECT_EQ(legacy_timeline_files.size(), 1);
+    EXPECT_TRUE(legacy_timeline_files == ff_legacy_timeline_files);
+}
+
+TEST(npeEngineTest, CanFastForwardSteadyState) {
+    tt_npe::npeEngine engine("wormhole_b0");
+    DeviceID device_id = 0;
+
+    tt_npe::npeWorkload wl;
+    tt_npe::npeWorkloadPhase phase;
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 200, {device_id, 1, 1}, Coord{device_id, 1, 5}, 28.1, 0, nocType::NOC0));
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 200, {device_id, 1, 2}, Coord{device_id, 1, 6}, 28.1, 3000, nocType::NOC0));
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 100, {device_id, 2, 2}, Coord{device_id, 1, 3}, 28.1, 9000, nocType::NOC0));
+    wl.addPhase(phase);
+    wl.setGoldenResultCycles({{0, {0, 20000}}});
+
+    npeConfig cfg;
+    auto result = engine.runPerfEstimation(wl, cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+    cfg.fast_forward_steady_state = true;
+    auto ss_result = engine.runPerfEstimation(wl, cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(ss_result));
+
+    // steady state jumps must reproduce the cycle estimates and summary stats exactly
+    for (auto device : {DeviceID(MESH_DEVICE), device_id}) {
+        const auto &stats = std::get<npeStats>(result).per_device_stats.at(device);
+        const auto &ss_stats = std::get<npeStats>(ss_result).per_device_stats.at(device);
+        EXPECT_EQ(stats.estimated_cycles, ss_stats.estimated_cycles);
+        EXPECT_EQ(stats.estimated_cong_free_cycles, ss_stats.estimated_cong_free_cycles);
+        EXPECT_DOUBLE_EQ(stats.overall_avg_link_demand, ss_stats.overall_avg_link_demand);
+        EXPECT_DOUBLE_EQ(stats.overall_avg_link_util, ss_stats.overall_avg_link_util);
+        EXPECT_DOUBLE_EQ(stats.overall_max_link_demand, ss_stats.overall_max_link_demand);
+        EXPECT_DOUBLE_EQ(stats.overall_avg_niu_demand, ss_stats.overall_avg_niu_demand);
+
+        Timestep ss_num_timesteps = 0;
+        for (const auto &ts : ss_stats.per_timestep_stats) {
+            ss_num_timesteps += ts.num_timesteps;
+        }
+        EXPECT_EQ(ss_num_timesteps, stats.per_timestep_stats.size());
+        EXPECT_LT(ss_stats.per_timestep_stats.size(), stats.per_timestep_stats.size() / 4);
+    }
+
+    // timelines are emitted with one entry per timestep either way
+    cfg.timeline_split_threshold_timesteps = 50;
+    cfg.fast_forward_steady_state = false;
+    auto timeline_files = emitTimelineFiles(engine, wl, cfg, "npe_timeline_steady_state");
+    cfg.fast_forward_steady_state = true;
+    auto ss_timeline_files = emitTimelineFiles(engine, wl, cfg, "npe_timeline_steady_state_ff");
+    EXPECT_GT(timeline_files.size(), 3);
+    EXPECT_TRUE(timeline_files == ss_timeline_files);
+}
+
 TEST(npeEngineTest, CanTimeoutOnMaxCycles) {
     tt_npe::npeEngine engine("wormhole_b0");
-    auto device_id = 0;
+    DeviceID device_id = 0;
 
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
@@ -59,4 +190,200 @@ TEST(npeEngineTest, CanTimeoutOnMaxCycles) {
     EXPECT_TRUE(std::holds_alternative<npeException>(result));
 }
 
-}  // namespace tt_npe
\ No newline at end of file
+TEST(npeEngineTest, CanBucketStatsPerDevice) {
+    tt_npe::npeEngine engine("T3K");
+
+    // all traffic is on device 1
+    tt_npe::npeWorkload wl;
+    tt_npe::npeWorkloadPhase phase;
+    for (int i = 0; i < 4; i++) {
+        phase.transfers.push_back(npeWorkloadTransfer(
+            2048, 8, {1, 1, 1}, Coord{1, 1, 5}, 28.1, 0, i % 2 ? nocType::NOC0 : nocType::NOC1));
+    }
+    wl.addPhase(phase);
+    boost::unordered_flat_map<DeviceID, std::pair<Cycle, Cycle>> golden_cycles;
+    for (auto device_id : engine.getDeviceModel().getDeviceIDs()) {
+        golden_cycles[device_id] = {0, 32};
+    }
+    wl.setGoldenResultCycles(golden_cycles);
+
+    npeConfig cfg;
+    auto result = engine.runPerfEstimation(wl, cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+    const auto &stats = std::get<npeStats>(result);
+
+    const auto &mesh_timestep = stats.per_device_stats.at(MESH_DEVICE).per_timestep_stats.front();
+    const auto &dev1_timestep = stats.per_device_stats.at(1).per_timestep_stats.front();
+    for (const auto &dev0_timestep : stats.per_device_stats.at(0).per_timestep_stats) {
+        EXPECT_EQ(dev0_timestep.max_link_demand, 0);
+        EXPECT_EQ(dev0_timestep.avg_niu_demand, 0);
+    }
+    EXPECT_GT(dev1_timestep.max_noc0_link_demand, 0);
+    EXPECT_GT(dev1_timestep.max_noc1_link_demand, 0);
+    EXPECT_EQ(dev1_timestep.max_link_demand, mesh_timestep.max_link_demand);
+    EXPECT_EQ(dev1_timestep.max_niu_demand, mesh_timestep.max_niu_demand);
+    // device averages are taken over only that device's links
+    EXPECT_DOUBLE_EQ(
+        dev1_timestep.avg_link_demand,
+        mesh_timestep.avg_link_demand * engine.getDeviceModel().getNumChips());
+}
+
+TEST(npeEngineTest, CanMirrorSingleChipStats) {
+    tt_npe::npeEngine engine("wormhole_b0");
+    DeviceID device_id = 0;
+
+    tt_npe::npeWorkload wl;
+    tt_npe::npeWorkloadPhase phase;
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 8, {device_id, 1, 1}, Coord{device_id, 1, 5}, 28.1, 0, nocType::NOC1));
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 8, {device_id, 1, 1}, Coord{device_id, 3, 1}, 28.1, 0, nocType::NOC0));
+    wl.addPhase(phase);
+    wl.setGoldenResultCycles({{device_id, {0, 100}}});
+
+    npeConfig cfg;
+    cfg.estimate_cong_impact = true;
+    auto result = engine.runPerfEstimation(wl, cfg);
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+    const auto &stats = std::get<npeStats>(result);
+
+    // device stats of a single-chip run match the mesh stats, minus the grid snapshots
+    ASSERT_EQ(stats.per_device_stats.size(), 2);
+    const auto &mesh_stats = stats.per_device_stats.at(MESH_DEVICE);
+    const auto &dev_stats = stats.per_device_stats.at(device_id);
+    EXPECT_GT(dev_stats.estimated_cycles, 0);
+    EXPECT_EQ(dev_stats.estimated_cycles, mesh_stats.estimated_cycles);
+    EXPECT_EQ(dev_stats.estimated_cong_free_cycles, mesh_stats.estimated_cong_free_cycles);
+    EXPECT_EQ(dev_stats.golden_cycles, mesh_stats.golden_cycles);
+    EXPECT_GT(dev_stats.overall_avg_link_util, 0);
+    EXPECT_EQ(dev_stats.overall_avg_link_util, mesh_stats.overall_avg_link_util);
+    EXPECT_EQ(dev_stats.overall_max_noc0_link_demand, mesh_stats.overall_max_noc0_link_demand);
+    EXPECT_EQ(dev_stats.dram_bw_util, mesh_stats.dram_bw_util);
+    ASSERT_EQ(dev_stats.per_timestep_stats.size(), mesh_stats.per_timestep_stats.size());
+    for (size_t i = 0; i < dev_stats.per_timestep_stats.size(); i++) {
+        const auto &dev_ts = dev_stats.per_timestep_stats[i];
+        const auto &mesh_ts = mesh_stats.per_timestep_stats[i];
+        EXPECT_EQ(dev_ts.start_cycle, mesh_ts.start_cycle);
+        EXPECT_EQ(dev_ts.avg_link_demand, mesh_ts.avg_link_demand);
+        EXPECT_TRUE(dev_ts.link_demand.empty());
+    }
+}
+
+TEST(npeEngineTest, CanRecordSparseTimelineData) {
+    TimestepStats ts;
+    LinkDemandGrid link_demand_grid(64, 0.0f);
+    link_demand_grid[3] = 28.1f;
+    link_demand_grid[17] = 0.0005f;
+    link_demand_grid[40] = 0.3f;
+    NIUDemandGrid niu_demand_grid(32, 0.0f);
+    niu_demand_grid[31] = 12345.6f;
+    ts.recordTimelineData(link_demand_grid, niu_demand_grid);
+
+    // insignificant demand is dropped; the rest is quantized to ~3 significant digits
+    ASSERT_EQ(ts.link_demand.size(), 2);
+    EXPECT_EQ(ts.link_demand[0].id, 3);
+    EXPECT_NEAR(ts.link_demand[0].demand(), 28.1f, 28.1f / 256);
+    EXPECT_EQ(ts.link_demand[1].id, 40);
+    EXPECT_NEAR(ts.link_demand[1].demand(), 0.3f, 0.3f / 256);
+    ASSERT_EQ(ts.niu_demand.size(), 1);
+    EXPECT_EQ(ts.niu_demand[0].id, 31);
+    EXPECT_NEAR(ts.niu_demand[0].demand(), 12345.6f, 12345.6f / 256);
+
+    // timeline data is not recorded unless a timeline file is requested
+    tt_npe::npeEngine engine("wormhole_b0");
+    tt_npe::npeWorkload wl;
+    tt_npe::npeWorkloadPhase phase;
+    phase.transfers.push_back(npeWorkloadTransfer(2048, 8, {0, 1, 1}, Coord{0, 1, 5}, 28.1, 0, nocType::NOC1));
+    wl.addPhase(phase);
+    wl.setGoldenResultCycles({{0, {0, 100}}});
+    auto result = engine.runPerfEstimation(wl, npeConfig{});
+    ASSERT_TRUE(std::holds_alternative<npeStats>(result));
+    for (const auto &[device_id, device_stats] : std::get<npeStats>(result).per_device_stats) {
+        for (const auto &ts : device_stats.per_timestep_stats) {
+            EXPECT_TRUE(ts.link_demand.empty());
+            EXPECT_TRUE(ts.niu_demand.empty());
+        }
+    }
+}
+
+TEST(npeEngineTest, CanQueryTransferLiveness) {
+    std::vector<PETransferState> transfer_state(4);
+    auto set_live = [&](PETransferID id, Cycle start, Cycle end) {
+        transfer_state[id].live_start_cycle = start;
+        transfer_state[id].live_end_cycle = end;
+    };
+    set_live(0, 0, 128);
+    set_live(1, 64, 192);
+    set_live(2, 256, 320);
+    // transfer 3 never ran
+
+    TransferLivenessIndex liveness_index(transfer_state);
+    auto live_during = [&](Cycle start, Cycle end) {
+        auto live = liveness_index.liveDuring(start, end);
+        std::sort(live.begin(), live.end());
+        return live;
+    };
+    EXPECT_EQ(live_during(0, 64), std::vector<PETransferID>({0}));
+    EXPECT_EQ(live_during(64, 128), std::vector<PETransferID>({0, 1}));
+    EXPECT_EQ(live_during(128, 192), std::vector<PETransferID>({1}));
+    // compressed span covering several timesteps
+    EXPECT_EQ(live_during(192, 320), std::vector<PETransferID>({2}));
+    EXPECT_EQ(live_during(320, 384), std::vector<PETransferID>());
+    EXPECT_EQ(live_during(0, 0), std::vector<PETransferID>());
+    // going back in time restarts the sweep
+    EXPECT_EQ(live_during(64, 128), std::vector<PETransferID>({0, 1}));
+}
+
+TEST(npeEngineTest, CanReleaseDependentsInOrder) {
+    npeTransferDependencyTracker dep_tracker;
+    auto chkpt_a = dep_tracker.createCheckpoint(2, 0);
+    auto chkpt_b = dep_tracker.createCheckpoint(1, 50);
+
+    dep_tracker.addDependent(npeTransferDependencyTracker::UNDEFINED_CHECKPOINT, 3, 100);
+    dep_tracker.addDependent(npeTransferDependencyTracker::UNDEFINED_CHECKPOINT, 0, 10);
+    dep_tracker.addDependent(chkpt_a, 1, 0);
+    dep_tracker.addDependent(chkpt_b, 2, 0);
+    EXPECT_EQ(dep_tracker.nextReleaseCycle(), 10);
+
+    // blocked dependents are not released until their checkpoint completes
+    EXPECT_EQ(dep_tracker.popReady(500), std::make_pair(0, Cycle(10)));
+    EXPECT_EQ(dep_tracker.popReady(99), std::nullopt);
+    dep_tracker.updateCheckpoint(chkpt_a, 20);
+    EXPECT_EQ(dep_tracker.nextReleaseCycle(), 100);
+    dep_tracker.updateCheckpoint(chkpt_a, 30);
+    dep_tracker.updateCheckpoint(chkpt_b, 40);
+    EXPECT_EQ(dep_tracker.nextReleaseCycle(), 30);
+
+    // release cycle includes checkpoint delay
+    EXPECT_EQ(dep_tracker.popReady(100), std::make_pair(1, Cycle(30)));
+    EXPECT_EQ(dep_tracker.popReady(100), std::make_pair(2, Cycle(90)));
+    EXPECT_EQ(dep_tracker.popReady(100), std::make_pair(3, Cycle(100)));
+    EXPECT_EQ(dep_tracker.popReady(100), std::nullopt);
+    EXPECT_EQ(dep_tracker.nextReleaseCycle(), std::nullopt);
+    EXPECT_TRUE(dep_tracker.allComplete());
+}
+
+TEST(npeEngineTest, CanReleaseDependentsByReleaseCycleThenID) {
+    npeTransferDependencyTracker dep_tracker;
+    auto chkpt_a = dep_tracker.createCheckpoint(1, 0);
+    auto chkpt_b = dep_tracker.createCheckpoint(1, 0);
+    auto chkpt_c = dep_tracker.createCheckpoint(1, 0);
+
+    dep_tracker.addDependent(npeTransferDependencyTracker::UNDEFINED_CHECKPOINT, 0, 25);
+    dep_tracker.addDependent(chkpt_a, 3, 0);
+    dep_tracker.addDependent(chkpt_b, 1, 0);
+    dep_tracker.addDependent(chkpt_c, 2, 0);
+    dep_tracker.updateCheckpoint(chkpt_c, 20);
+    dep_tracker.updateCheckpoint(chkpt_b, 20);
+    dep_tracker.updateCheckpoint(chkpt_a, 10);
+
+    // the order checkpoints complete in and the order dependents were added
+    // in do not affect the order dependents are popped in
+    std::vector<std::pair<npeDependentID, Cycle>> released;
+    while (auto ready = dep_tracker.popReady(32)) {
+        released.push_back(ready.value());
+    }
+    EXPECT_EQ(
+        released,
+        (std::vector<std::pair<npeDependentID, Cycle>>{{3, 10}, {1, 20}, {2, 20}, {0, 25}}));
+}
+
+}  // namespace tt_npe
@@ -3,8 +3,11 @@
 
 #include "device_models/wormhole_b0.hpp"
 #include "gtest/gtest.h"
+#include "npeDemandReduction.hpp"
+#include "npeJSONStreamWriter.hpp"
 #include "npeUtil.hpp"
 #include <random>   // For random number generation
+#include <sstream>
 
 namespace tt_npe {
 
@@ -710,4 +713,82 @@ TEST(npeUtilTest, HashFunctionQualityLinkAndNIUAttrs) {
     }
 }
 
+TEST(npeUtilTest, CanReduceDemandWithSimd) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> demand_dist(0, 60);
+    // odd number of coords exercises the scalar tail of each SIMD kernel
+    std::vector<float> demand(4 * 37), mcast_demand(4 * 37);
+    for (size_t i = 0; i < demand.size(); i++) {
+        demand[i] = demand_dist(rng);
+        mcast_demand[i] = demand_dist(rng);
+    }
+
+    // reference values computed per link type (element i has type i % 4)
+    DemandReduction expected;
+    for (size_t i = 0; i < demand.size(); i++) {
+        size_t t = i % 4;
+        expected.demand_sum[t] += demand[i];
+        expected.util_sum[t] += std::fmin(demand[i], 28.1f);
+        expected.mcast_write_util_sum[t] += std::fmin(mcast_demand[i], 28.1f);
+        expected.max_demand[t] = std::fmax(expected.max_demand[t], demand[i]);
+    }
+
+    // SIMD kernels sum in a different order, so sums are only compared to
+    // within a few ULP; max demand must match exactly
+    for (auto simd_level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (simd_level > getSupportedSimdLevel()) {
+            continue;
+        }
+        auto links = reduceLinkDemand(demand, mcast_demand, 28.1f, simd_level);
+        auto nius = reduceNIUDemand(demand, simd_level);
+        for (size_t t = 0; t < 4; t++) {
+            EXPECT_DOUBLE_EQ(links.demand_sum[t], expected.demand_sum[t]);
+            EXPECT_DOUBLE_EQ(links.util_sum[t], expected.util_sum[t]);
+            EXPECT_DOUBLE_EQ(links.mcast_write_util_sum[t], expected.mcast_write_util_sum[t]);
+            EXPECT_EQ(links.max_demand[t], expected.max_demand[t]);
+            EXPECT_DOUBLE_EQ(nius.demand_sum[t], expected.demand_sum[t]);
+            EXPECT_EQ(nius.util_sum[t], 0);
+        }
+        EXPECT_EQ(nius.maxDemand(), expected.maxDemand());
+        EXPECT_DOUBLE_EQ(links.totalDemand(), expected.totalDemand());
+    }
+}
+
+TEST(npeUtilTest, CanStreamJSONLikeDump) {
+    nlohmann::json expected = {
+        {"a", {{"nested", {1, 2.5, "three"}}, {"empty_array", nlohmann::json::array()}}},
+        {"b", nlohmann::json::object()},
+        {"c", nlohmann::json::array({nlohmann::json::object({{"x", -1}}), nlohmann::json::array({true, nullptr})})},
+        {"d", "multi\nline"}};
+
+    for (int indent : {-1, 0, 2, 4}) {
+        std::ostringstream os;
+        {
+            JSONStreamWriter writer(os, indent);
+            writer.beginObject();
+            writer.key("a");
+            writer.beginObject();
+            writer.key("empty_array");
+            writer.beginArray();
+            writer.endArray();
+            writer.key("nested");
+            writer.value(expected["a"]["nested"]);
+            writer.endObject();
+            writer.key("b");
+            writer.beginObject();
+            writer.endObject();
+            writer.key("c");
+            writer.beginArray();
+            for (const auto &elem : expected["c"]) {
+                writer.value(elem);
+            }
+            writer.endArray();
+            writer.key("d");
+            writer.value(expected["d"]);
+            writer.endObject();
+        }
+        EXPECT_EQ(os.str(), expected.dump(indent)) << "indent = " << indent;
+    }
+}
+
 }  // namespace tt_npe
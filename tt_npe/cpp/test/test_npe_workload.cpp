@@ -1,14 +1,19 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: © 2025 Tenstorrent AI ULC
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "device_models/wormhole_b0.hpp"
 #include "device_models/wormhole_multichip.hpp"
 #include "gtest/gtest.h"
 #include "ingestWorkload.hpp"
+#include "npeNocTraceReader.hpp"
 #include "npeWorkload.hpp"
+#include "npeWorkloadCache.hpp"
 
 namespace tt_npe {
 
@@ -16,17 +21,47 @@ TEST(npeWorkloadTest, CanConstructWorkload) {
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
     phase.transfers.push_back(npeWorkloadTransfer(
-        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, "READ", "", -1));
+        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, nocEventType::READ, EMPTY_ZONE_PATH, -1));
     wl.addPhase(phase);
 
     EXPECT_EQ(wl.getPhases().size(), 1);
     EXPECT_EQ(wl.getPhases()[0].transfers.size(), 1);
 }
+TEST(npeWorkloadTest, CanParseNocEventTypes) {
+    EXPECT_EQ(parseNocEventType("WRITE_MULTICAST"), nocEventType::WRITE_MULTICAST);
+    EXPECT_EQ(parseNocEventType("WRITE_"), nocEventType::WRITE_);
+    EXPECT_EQ(parseNocEventType("WRITE"), nocEventType::UNKNOWN);
+    EXPECT_EQ(parseNocEventType(""), nocEventType::UNKNOWN);
+    EXPECT_EQ(nocEventTypeName(nocEventType::READ_WITH_STATE), "READ_WITH_STATE");
+    EXPECT_EQ(nocEventTypeName(nocEventType::UNKNOWN), "");
+    EXPECT_TRUE(isFabricEventType(nocEventType::FABRIC_UNICAST_WRITE));
+    EXPECT_FALSE(isFabricEventType(nocEventType::WRITE_));
+}
+TEST(npeWorkloadTest, CanInternZonePaths) {
+    tt_npe::npeWorkload wl;
+    EXPECT_EQ(wl.internZonePath(""), EMPTY_ZONE_PATH);
+    auto outer = wl.internZonePath("KERNEL[0]");
+    auto inner = wl.internZonePath("KERNEL[0]/LOOP[3]");
+    EXPECT_NE(outer, inner);
+    EXPECT_EQ(wl.internZonePath(std::string("KERNEL[0]")), outer);
+    EXPECT_EQ(wl.getZonePath(inner), "KERNEL[0]/LOOP[3]");
+    EXPECT_EQ(wl.getNumZonePaths(), 3);
+
+    // transfers referring to zone paths outside the pool fail validation
+    tt_npe::npeWorkloadPhase phase;
+    phase.transfers.push_back(npeWorkloadTransfer(
+        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, nocEventType::READ, inner));
+    phase.transfers.push_back(npeWorkloadTransfer(
+        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, nocEventType::READ, 3));
+    wl.addPhase(phase);
+    auto dm = tt_npe::WormholeB0DeviceModel();
+    EXPECT_FALSE(wl.validate(dm, false));
+}
 TEST(npeWorkloadTest, CanValidateWorkload) {
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
     phase.transfers.push_back(npeWorkloadTransfer(
-        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, "READ", "", -1));
+        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, nocEventType::READ, EMPTY_ZONE_PATH, -1));
     wl.addPhase(phase);
 
     auto dm = tt_npe::WormholeB0DeviceModel();
@@ -36,7 +71,7 @@ TEST(npeWorkloadTest, CanRejectInvalidTransferSrc) {
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
     phase.transfers.push_back(npeWorkloadTransfer(
-        2048, 1, {DeviceID(), 1, 100}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, "READ", "", -1));
+        2048, 1, {DeviceID(), 1, 100}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, nocEventType::READ, EMPTY_ZONE_PATH, -1));
     wl.addPhase(phase);
 
     auto dm = tt_npe::WormholeB0DeviceModel();
@@ -46,7 +81,7 @@ TEST(npeWorkloadTest, CanRejectInvalidTransferDst) {
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
     phase.transfers.push_back(npeWorkloadTransfer(
-        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 100}, 28.1, 0, nocType::NOC1, "READ", "", -1));
+        2048, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 100}, 28.1, 0, nocType::NOC1, nocEventType::READ, EMPTY_ZONE_PATH, -1));
     wl.addPhase(phase);
 
     auto dm = tt_npe::WormholeB0DeviceModel();
@@ -56,7 +91,7 @@ TEST(npeWorkloadTest, CanRejectInvalidNumPackets) {
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
     phase.transfers.push_back(npeWorkloadTransfer(
-        2048, 0, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, "READ", "", -1));
+        2048, 0, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, nocEventType::READ, EMPTY_ZONE_PATH, -1));
     wl.addPhase(phase);
 
     auto dm = tt_npe::WormholeB0DeviceModel();
@@ -66,7 +101,7 @@ TEST(npeWorkloadTest, CanRejectInvalidPacketSize) {
     tt_npe::npeWorkload wl;
     tt_npe::npeWorkloadPhase phase;
     phase.transfers.push_back(npeWorkloadTransfer(
-        0, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, "READ", "", -1));
+        0, 1, {DeviceID(), 1, 1}, Coord{DeviceID(), 1, 5}, 28.1, 0, nocType::NOC1, nocEventType::READ, EMPTY_ZONE_PATH, -1));
     wl.addPhase(phase);
 
     auto dm = tt_npe::WormholeB0DeviceModel();
@@ -84,8 +119,8 @@ TEST(npeWorkloadTest, CanRejectMismatchedDeviceIds) {
         28.1,
         0,
         nocType::NOC1,
-        "READ",
-        "",
+        nocEventType::READ,
+        EMPTY_ZONE_PATH,
         -1));
     wl.addPhase(phase);
 
@@ -104,8 +139,8 @@ TEST(npeWorkloadTest, CanRejectInvalidSourceDeviceId) {
         28.1,
         0,
         nocType::NOC1,
-        "READ",
-        "",
+        nocEventType::READ,
+        EMPTY_ZONE_PATH,
         -1));
     wl.addPhase(phase);
 
@@ -124,8 +159,8 @@ TEST(npeWorkloadTest, CanRejectInvalidSourceDeviceIdMultiChip) {
         28.1,
         0,
         nocType::NOC1,
-        "READ",
-        "",
+        nocEventType::READ,
+        EMPTY_ZONE_PATH,
         -1));
     wl.addPhase(phase);
 
@@ -168,4 +203,327 @@ TEST(npeWorkloadTest, CanIngestAndValidateMultichipTraceFile) {
     EXPECT_TRUE(workload->validate(dm));
 }
 
-}  // namespace tt_npe
\ No newline at end of file
+// reads all events of a noc trace, flattening each into a comparable string
+std::optional<std::vector<std::string>> readNocTraceEvents(const std::string &filepath, size_t window_size) {
+    npeNocTraceReader reader(filepath, window_size);
+    NocTraceEventBatch batch;
+    std::vector<std::string> events;
+    while (reader.readBatch(batch)) {
+        for (const auto &event : batch.events) {
+            std::string flattened = fmt::format(
+                "{} {} {} {} {} {} {} {} {} {} {} {} {}",
+                event.proc,
+                event.type,
+                event.noc,
+                event.zone,
+                event.zone_phase,
+                event.num_bytes,
+                event.sx,
+                event.sy,
+                event.dx,
+                event.dy,
+                event.src_device_id,
+                event.dst_device_id.value_or(-1),
+                event.timestamp);
+            for (const auto &route : batch.getFabricRoutes(event)) {
+                flattened += fmt::format(" route {} {} {}", route.device, route.forward_x, route.forward_y);
+                for (const auto &local_write : batch.getLocalWrites(route)) {
+                    flattened += fmt::format(" write {} {}", local_write.dx, local_write.num_bytes);
+                }
+            }
+            events.push_back(flattened);
+        }
+    }
+    if (reader.hasFailed()) {
+        return std::nullopt;
+    }
+    return events;
+}
+
+std::string writeTempFile(const std::string &name, const std::string &contents) {
+    auto filepath = std::filesystem::path(::testing::TempDir()) / name;
+    std::ofstream(filepath, std::ios::binary) << contents;
+    return filepath.string();
+}
+
+TEST(npeWorkloadTest, CanReadNocTraceInWindows) {
+    for (const auto &filepath :
+         {"cpp/test/data/multichip-trace-example.json", "cpp/test/data/mcast-util-trace-small.json"}) {
+        auto events = readNocTraceEvents(filepath, npeNocTraceReader::DEFAULT_WINDOW_SIZE);
+        ASSERT_TRUE(events.has_value());
+        EXPECT_FALSE(events->empty());
+        // events split across windows (and windows too small for a single event) read the same
+        for (size_t window_size : {1, 7, 64, 1000}) {
+            EXPECT_EQ(readNocTraceEvents(filepath, window_size), events) << "window size " << window_size;
+        }
+    }
+
+    // separators within strings and nested containers do not split events
+    auto filepath = writeTempFile(
+        "npe_trace_strings.json",
+        "\xEF\xBB\xBF [{\"proc\": \"BRISC\", \"zone\": \"a,]}\\\"[{\", \"sx\": 1},"
+        "{\"fabric_send\": {\"path\": [{\"device\": 2, \"local_writes\": [{\"dx\": 3, \"num_bytes\": 4}]}]}},"
+        " 5 ]\n");
+    for (size_t window_size : {1, 4, 1000}) {
+        auto events = readNocTraceEvents(filepath, window_size);
+        ASSERT_TRUE(events.has_value());
+        ASSERT_EQ(events->size(), 3);
+        EXPECT_EQ((*events)[0], "BRISC   a,]}\"[{  0 1 -1 -1 -1 0 -1 0");
+        EXPECT_TRUE((*events)[1].ends_with("route 2 -1 -1 write 3 4"));
+    }
+
+    EXPECT_EQ(readNocTraceEvents(writeTempFile("npe_trace_empty.json", " [ ] "), 1), std::vector<std::string>{});
+}
+
+TEST(npeWorkloadTest, CanRejectMalformedNocTrace) {
+    for (const auto &contents :
+         {"", "{\"proc\": \"BRISC\"}", "[{\"sx\": 1},", "[{\"sx\": 1},]", "[{\"sx\": 1}, , {\"sx\": 2}]",
+          "[{\"sx\": 1} {\"sx\": 2}]"}) {
+        auto filepath = writeTempFile("npe_trace_malformed.json", contents);
+        for (size_t window_size : {1, 1000}) {
+            EXPECT_FALSE(readNocTraceEvents(filepath, window_size).has_value()) << contents;
+        }
+    }
+    EXPECT_FALSE(readNocTraceEvents("cpp/test/data/does-not-exist.json", 1000).has_value());
+    EXPECT_FALSE(createWorkloadFromJSON(writeTempFile("npe_trace_malformed.json", "[{\"sx\": 1},"), "wormhole_b0", true)
+                     .has_value());
+    EXPECT_FALSE(convertNocTracesToNpeWorkload(
+                     writeTempFile("npe_trace_malformed.json", "[{\"sx\": 1}, {\"sx\": 1 2}, {\"sx\": 3}]"),
+                     "wormhole_b0",
+                     false,
+                     4,
+                     8)
+                     .has_value());
+}
+
+void expectSameWorkload(const npeWorkload &a, const npeWorkload &b) {
+    EXPECT_EQ(a.getGoldenResultCycles(), b.getGoldenResultCycles());
+    EXPECT_EQ(a.getZones(), b.getZones());
+    EXPECT_EQ(a.getNumTransferGroups(), b.getNumTransferGroups());
+    ASSERT_EQ(a.getPhases().size(), b.getPhases().size());
+    for (size_t p = 0; p < a.getPhases().size(); p++) {
+        const auto &a_transfers = a.getPhases()[p].transfers;
+        const auto &b_transfers = b.getPhases()[p].transfers;
+        ASSERT_EQ(a_transfers.size(), b_transfers.size());
+        for (size_t i = 0; i < a_transfers.size(); i++) {
+            const auto &at = a_transfers[i];
+            const auto &bt = b_transfers[i];
+            EXPECT_EQ(
+                std::tie(at.packet_size, at.num_packets, at.src, at.dst, at.phase_cycle_offset, at.noc_type),
+                std::tie(bt.packet_size, bt.num_packets, bt.src, bt.dst, bt.phase_cycle_offset, bt.noc_type))
+                << "transfer " << i;
+            EXPECT_EQ(
+                std::tie(at.noc_event_type, at.transfer_group_id, at.transfer_group_index, at.transfer_group_parent),
+                std::tie(bt.noc_event_type, bt.transfer_group_id, bt.transfer_group_index, bt.transfer_group_parent))
+                << "transfer " << i;
+            EXPECT_EQ(a.getZonePath(at.enclosing_zone_path_id), b.getZonePath(bt.enclosing_zone_path_id))
+                << "transfer " << i;
+        }
+    }
+}
+
+TEST(npeWorkloadTest, CanIngestNocTraceInParallelChunks) {
+    // SET_STATE/WITH_STATE pairs that straddle chunks, within nested zones
+    std::string state_trace = "[";
+    for (int i = 0; i < 200; i++) {
+        std::string_view kind = i % 3 ? "READ" : "WRITE";
+        std::string event_fields = fmt::format(
+            "\"proc\": \"BRISC\", \"noc\": \"NOC_{}\", \"sx\": 1, \"sy\": 1, \"timestamp\": {}",
+            i % 2,
+            1000 + 10 * i);
+        if (i % 50 == 0) {
+            state_trace += fmt::format("{{{}, \"zone\": \"Z{}\", \"zone_phase\": \"ZONE_START\"}},", event_fields, i / 50);
+        }
+        if (i % 7 == 0) {
+            state_trace += fmt::format(
+                "{{{}, \"type\": \"{}_SET_STATE\", \"dx\": {}, \"dy\": {}, \"num_bytes\": {}}},",
+                event_fields,
+                kind,
+                2 + i % 5,
+                1 + i % 9,
+                64 * (i + 1));
+        }
+        state_trace += fmt::format(
+            "{{{}, \"type\": \"{}_WITH_STATE\", \"num_bytes\": {}}},", event_fields, kind, i % 4 ? 0 : 32 * i);
+        if (i % 50 == 49) {
+            state_trace += fmt::format("{{{}, \"zone\": \"Z{}\", \"zone_phase\": \"ZONE_END\"}},", event_fields, i / 50);
+        }
+    }
+    state_trace.back() = ']';
+    auto state_trace_filepath = writeTempFile("npe_trace_state.json", state_trace);
+
+    for (auto [filepath, device_name] :
+         {std::pair{"cpp/test/data/multichip-trace-example.json", "T3K"},
+          std::pair{"cpp/test/data/mcast-util-trace-small.json", "wormhole_b0"},
+          std::pair{state_trace_filepath.c_str(), "wormhole_b0"}}) {
+        auto serial = convertNocTracesToNpeWorkload(filepath, device_name, false, 1);
+        ASSERT_TRUE(serial.has_value()) << filepath;
+        EXPECT_FALSE(serial->getPhases().front().transfers.empty()) << filepath;
+        for (size_t num_threads : {1, 4}) {
+            for (size_t chunk_size : {1, 300, 4096}) {
+                auto chunked = convertNocTracesToNpeWorkload(filepath, device_name, false, num_threads, chunk_size);
+                ASSERT_TRUE(chunked.has_value()) << filepath;
+                SCOPED_TRACE(fmt::format("{} with {} threads, chunk size {}", filepath, num_threads, chunk_size));
+                expectSameWorkload(*serial, *chunked);
+            }
+        }
+    }
+}
+
+TEST(npeWorkloadTest, CanMergeMultichipNocTraces) {
+    // merged_noc_trace.json holds the same per-device traces, merged by py/util/fabric_post_process.py
+    for (std::string dir : {"cpp/test/data/fabric-merge-1d", "cpp/test/data/fabric-merge-2d"}) {
+        auto reference = convertNocTracesToNpeWorkload(dir + "/merged_noc_trace.json", "T3K");
+        ASSERT_TRUE(reference.has_value()) << dir;
+        EXPECT_FALSE(reference->getPhases().front().transfers.empty()) << dir;
+        for (size_t num_threads : {1, 4}) {
+            auto merged = convertNocTraceFilesToNpeWorkload(
+                {dir + "/noc_trace_dev*.json"}, dir + "/topology.json", "", false, num_threads);
+            ASSERT_TRUE(merged.has_value()) << dir;
+            SCOPED_TRACE(fmt::format("{} with {} threads", dir, num_threads));
+            expectSameWorkload(*reference, *merged);
+        }
+
+        // traces may also be listed individually, in any order
+        std::vector<std::string> trace_files;
+        for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+            if (entry.path().filename().string().starts_with("noc_trace_dev")) {
+                trace_files.push_back(entry.path().string());
+            }
+        }
+        std::sort(trace_files.rbegin(), trace_files.rend());
+        auto merged = convertNocTraceFilesToNpeWorkload(trace_files, dir + "/topology.json", "T3K");
+        ASSERT_TRUE(merged.has_value()) << dir;
+        SCOPED_TRACE(fmt::format("{} listed individually", dir));
+        expectSameWorkload(*reference, *merged);
+    }
+
+    std::string traces = "cpp/test/data/fabric-merge-1d/noc_trace_dev*.json";
+    EXPECT_FALSE(convertNocTraceFilesToNpeWorkload({traces}, "cpp/test/data/does-not-exist.json").has_value());
+    EXPECT_FALSE(
+        convertNocTraceFilesToNpeWorkload({"cpp/test/data/does-not-exist*.json"}, "cpp/test/data/fabric-merge-1d/topology.json")
+            .has_value());
+    // fabric sends can not be routed without a fabric
+    auto disabled_topology = writeTempFile("npe_topology.json", R"({"fabric_config": "DISABLED", "cluster_type": "T3K"})");
+    EXPECT_FALSE(convertNocTraceFilesToNpeWorkload({traces}, disabled_topology).has_value());
+}
+
+TEST(npeWorkloadTest, CanHashBytes) {
+    // reference XXH64 hashes
+    EXPECT_EQ(hashBytes(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hashBytes("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hashBytes("The quick brown fox jumps over the lazy dog"), 0x0B242D361FDA71BCULL);
+}
+
+TEST(npeWorkloadTest, CanSerializeWorkload) {
+    npeWorkload wl;
+    auto zone_path = wl.internZonePath("OP/KERNEL");
+    auto group_id = wl.registerTransferGroupID();
+    wl.setGoldenResultCycles({{0, {100, 2000}}, {1, {50, 1800}}});
+    wl.setZones({{{Coord{0, 1, 1}, RiscType::NCRISC},
+                  {{110.5, "KERNEL", ZonePhase::ZONE_START}, {1900.0, "KERNEL", ZonePhase::ZONE_END}}},
+                 {{Coord{1, 2, 3}, RiscType::BRISC}, {{60.0, "OP", ZonePhase::ZONE_START}}}});
+    npeWorkloadPhase phase;
+    phase.transfers.emplace_back(
+        2048, 4, Coord{0, 1, 1}, Coord{0, 5, 6}, 28.1, 300, nocType::NOC0, nocEventType::READ, zone_path);
+    phase.transfers.emplace_back(
+        4096,
+        1,
+        Coord{1, 2, 3},
+        MulticastCoordSet(MulticastCoordSet::CoordGridContainer{
+            {Coord{1, 1, 1}, Coord{1, 4, 7}}, {Coord{2, 1, 1}, Coord{2, 4, 7}}}),
+        9.5,
+        120,
+        nocType::NOC1,
+        nocEventType::FABRIC_UNICAST_WRITE,
+        EMPTY_ZONE_PATH,
+        group_id,
+        0,
+        -1);
+    wl.addPhase(phase);
+    wl.addPhase(npeWorkloadPhase{});
+
+    auto bytes = npeWorkloadCache::serialize(wl);
+    auto deserialized = npeWorkloadCache::deserialize(bytes);
+    expectSameWorkload(wl, deserialized);
+    EXPECT_EQ(deserialized.getNumZonePaths(), wl.getNumZonePaths());
+    EXPECT_FLOAT_EQ(deserialized.getPhases()[0].transfers[1].injection_rate, 9.5);
+    EXPECT_EQ(deserialized.getPhases()[0].transfers[1].getID(), 1);
+
+    EXPECT_THROW(npeWorkloadCache::deserialize(bytes.substr(0, bytes.size() - 1)), std::runtime_error);
+    EXPECT_THROW(npeWorkloadCache::deserialize(bytes + '\0'), std::runtime_error);
+    EXPECT_THROW(npeWorkloadCache::deserialize("NPETLBIN"), std::runtime_error);
+}
+
+TEST(npeWorkloadTest, CanCacheConvertedWorkloads) {
+    auto cache_dir = std::filesystem::path(::testing::TempDir()) / "npe_workload_cache";
+    std::filesystem::remove_all(cache_dir);
+    auto cache_entries = [&]() {
+        std::vector<std::filesystem::path> entries;
+        for (const auto &entry : std::filesystem::directory_iterator(cache_dir)) {
+            entries.push_back(entry.path());
+        }
+        return entries;
+    };
+
+    std::ifstream ifs("cpp/test/data/mcast-util-trace-small.json");
+    std::string trace{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    auto trace_filepath = writeTempFile("npe_trace_cached.json", trace);
+
+    auto uncached = createWorkloadFromJSON(trace_filepath, "wormhole_b0", true);
+    ASSERT_TRUE(uncached.has_value());
+    auto cold = createWorkloadFromJSON(trace_filepath, "wormhole_b0", true, false, cache_dir.string());
+    ASSERT_TRUE(cold.has_value());
+    expectSameWorkload(*uncached, *cold);
+    auto entries = cache_entries();
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries.front().extension(), ".npewl");
+
+    auto warm = createWorkloadFromJSON(trace_filepath, "wormhole_b0", true, false, cache_dir.string());
+    ASSERT_TRUE(warm.has_value());
+    expectSameWorkload(*uncached, *warm);
+    EXPECT_EQ(warm->getSourceFilePath(), std::filesystem::path(trace_filepath));
+
+    // warm runs load the cached workload rather than converting the trace
+    writeTempFile("npe_workload_cache/" + entries.front().filename().string(), npeWorkloadCache::serialize({}));
+    auto stale = createWorkloadFromJSON(trace_filepath, "wormhole_b0", true, false, cache_dir.string());
+    ASSERT_TRUE(stale.has_value());
+    EXPECT_TRUE(stale->getPhases().empty());
+
+    // unreadable entries are converted again, and replaced
+    writeTempFile("npe_workload_cache/" + entries.front().filename().string(), "NPEWLBIN");
+    auto reconverted = createWorkloadFromJSON(trace_filepath, "wormhole_b0", true, false, cache_dir.string());
+    ASSERT_TRUE(reconverted.has_value());
+    expectSameWorkload(*uncached, *reconverted);
+    EXPECT_EQ(cache_entries().size(), 1);
+    auto rewarmed = createWorkloadFromJSON(trace_filepath, "wormhole_b0", true, false, cache_dir.string());
+    ASSERT_TRUE(rewarmed.has_value());
+    expectSameWorkload(*uncached, *rewarmed);
+
+    // changing the trace or how it is converted uses a new entry
+    writeTempFile("npe_trace_cached.json", trace + "\n");
+    EXPECT_TRUE(createWorkloadFromJSON(trace_filepath, "wormhole_b0", true, false, cache_dir.string()).has_value());
+    EXPECT_EQ(cache_entries().size(), 2);
+    EXPECT_TRUE(createWorkloadFromJSON(trace_filepath, "wormhole_b0", false, false, cache_dir.string()).has_value());
+    EXPECT_EQ(cache_entries().size(), 3);
+    EXPECT_FALSE(
+        createWorkloadFromJSON("cpp/test/data/does-not-exist.json", "wormhole_b0", true, false, cache_dir.string())
+            .has_value());
+    EXPECT_EQ(cache_entries().size(), 3);
+
+    // merged multichip traces are cached likewise
+    std::string dir = "cpp/test/data/fabric-merge-1d";
+    auto reference = convertNocTraceFilesToNpeWorkload({dir + "/noc_trace_dev*.json"}, dir + "/topology.json");
+    ASSERT_TRUE(reference.has_value());
+    for (int run = 0; run < 2; run++) {
+        auto merged = convertNocTraceFilesToNpeWorkload(
+            {dir + "/noc_trace_dev*.json"}, dir + "/topology.json", "", false, 0, cache_dir.string());
+        ASSERT_TRUE(merged.has_value());
+        SCOPED_TRACE(fmt::format("merge run {}", run));
+        expectSameWorkload(*reference, *merged);
+        EXPECT_EQ(merged->getSourceFilePath(), reference->getSourceFilePath());
+        EXPECT_EQ(cache_entries().size(), 4);
+    }
+}
+
+}  // namespace tt_npe
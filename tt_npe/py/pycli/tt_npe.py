@@ -40,6 +40,18 @@ def parse_cli_args():
         help="Congestion model to use (default: 'fast', optionally: 'none')",
     )
 
+    parser.add_argument(
+        "--fast-forward-idle-timesteps",
+        action="store_true",
+        help="Skip over idle timesteps with no live transfers, recording them as a single span",
+    )
+
+    parser.add_argument(
+        "--fast-forward-steady-state",
+        action="store_true",
+        help="Advance analytically over timesteps where live transfers and their bandwidths are unchanged",
+    )
+
     parser.add_argument(
         "-w", "--workload", type=str, default="", help="Run workload from JSON file"
     )
@@ -71,6 +83,12 @@ def parse_cli_args():
         help="Compress visualizer timeline output file using zstd",
     )
 
+    parser.add_argument(
+        "--seekable-timeline-output-file",
+        action="store_true",
+        help="Write a seekable compressed timeline file indexed by split region instead of emitting split files (requires --compress-timeline-output-file)",
+    )
+
     parser.add_argument(
         "--scale-workload-schedule",
         type=float,
@@ -91,6 +109,19 @@ def parse_cli_args():
         help="Use the legacy timeline format (default: v1.0.0 format)",
     )
 
+    parser.add_argument(
+        "--workload-cache-dir",
+        type=str,
+        default="",
+        help="Cache converted workloads in this directory; reruns on unchanged workload files skip parsing them",
+    )
+
+    parser.add_argument(
+        "--emit-binary-timeline-file",
+        action="store_true",
+        help="Also emit timeline timestep data in binary columnar form (.npetl); not supported with --use-legacy-timeline-format",
+    )
+
     # Verbose output
     parser.add_argument(
         "-v",
@@ -124,13 +155,17 @@ def main():
     cfg.workload_json_filepath = args.workload
     cfg.workload_is_noc_trace = args.workload_is_noc_trace
     cfg.cycles_per_timestep = args.cycles_per_timestep
+    cfg.fast_forward_idle_timesteps = args.fast_forward_idle_timesteps
+    cfg.fast_forward_steady_state = args.fast_forward_steady_state
     cfg.emit_timeline_file = args.emit_timeline_file
     cfg.timeline_filepath = args.timeline_json_filepath
     cfg.infer_injection_rate_from_src = not args.no_injection_rate_inference
     cfg.scale_workload_schedule = args.scale_workload_schedule
     cfg.compress_timeline_output_file = args.compress_timeline_output_file
+    cfg.seekable_timeline_output_file = args.seekable_timeline_output_file
     cfg.topology_json = args.topology_json
     cfg.use_legacy_timeline_format = args.use_legacy_timeline_format
+    cfg.emit_binary_timeline_file = args.emit_binary_timeline_file
     cfg.set_verbosity_level(1 if args.verbose else 0)
 
     if args.verbose:
@@ -143,7 +178,7 @@ def main():
         log_error(f"E: Must provide a tt-npe workload JSON file with option -w,--workload")
         sys.exit(1)
 
-    wl = npe.createWorkloadFromJSON(cfg.workload_json_filepath, cfg.device_name, cfg.workload_is_noc_trace)
+    wl = npe.createWorkloadFromJSON(cfg.workload_json_filepath, cfg.device_name, cfg.workload_is_noc_trace, cache_dir=args.workload_cache_dir)
     if wl is None:
         log_error(f"E: Could not create tt-npe workload from file '{args.workload}'; aborting ... ")
         sys.exit(1)
@@ -382,10 +382,10 @@ class TopologyGraph:
             )
 
         curr_dev, initial_direction = self.get_next_device_in_dir(src_device, initial_direction)
-        receiver_channel = self.routing_planes.get((curr_dev, routing_plane_id, initial_direction.get_inverse_direction()))
+        receiver_channel = self.routing_planes.get((curr_dev, path_routing_plane_id, initial_direction.get_inverse_direction()))
         if receiver_channel is None: 
             raise ProcessingError(f"No ethernet channel on device {curr_dev} in dir {initial_direction.get_inverse_direction()}" \
-                f"on routing plane {routing_plane_id}")
+                f"on routing plane {path_routing_plane_id}")
         
         receiver_coord = self.eth_chan_to_coord[receiver_channel]
 
@@ -427,10 +427,10 @@ class TopologyGraph:
             )
 
         curr_dev, initial_direction = self.get_next_device_in_dir(src_device, initial_direction)
-        receiver_channel = self.routing_planes.get((curr_dev, routing_plane_id, initial_direction.get_inverse_direction()))
+        receiver_channel = self.routing_planes.get((curr_dev, path_routing_plane_id, initial_direction.get_inverse_direction()))
         if receiver_channel is None: 
             raise ProcessingError(f"No ethernet channel on device {curr_dev} in dir {initial_direction.get_inverse_direction()}" \
-                f"on routing plane {routing_plane_id}")
+                f"on routing plane {path_routing_plane_id}")
         
         receiver_coord = self.eth_chan_to_coord[receiver_channel]
         
@@ -18,7 +18,7 @@ from pathlib import Path
 import tt_npe_pybind as npe
 from multiprocessing import Pool
 from functools import partial
-from fabric_post_process import TopologyGraph, process_traces, log_info, log_warning, log_error
+from fabric_post_process import TopologyGraph, log_info, log_warning, log_error
     
 BOLD = '\033[1m'
 RESET = '\033[0m'
@@ -138,16 +138,16 @@ class OpUID:
             return False
         return self.ttnn_op_id == other.ttnn_op_id and self.metal_trace_id == other.metal_trace_id
 
-def process_trace(noc_trace_info, device_name, topology_json_file, compress_timeline_files, output_dir, emit_viz_timeline_files, timeline_split_threshold):
-    noc_trace_file, opname, op_uid = noc_trace_info
+def process_trace(noc_trace_info, device_name, topology_json_file, compress_timeline_files, output_dir, emit_viz_timeline_files, timeline_split_threshold, workload_cache_dir=""):
+    noc_trace_files, opname, op_uid = noc_trace_info
     try:
-        result = run_npe(opname, op_uid, device_name, noc_trace_file, topology_json_file, compress_timeline_files, output_dir, emit_viz_timeline_files, timeline_split_threshold)
+        result = run_npe(opname, op_uid, device_name, noc_trace_files, topology_json_file, compress_timeline_files, output_dir, emit_viz_timeline_files, timeline_split_threshold, workload_cache_dir)
         if isinstance(result, npe.Stats):
             return (opname, op_uid, result)
         else:
-            log_error(f"tt-npe exited unsuccessfully with error {result} on trace {os.path.basename(noc_trace_file)}\n")
+            log_error(f"tt-npe exited unsuccessfully with error {result} on traces of op {opname} {str(op_uid)}\n")
     except Exception as e:
-        log_error(f"Error processing {noc_trace_file}: {e}\n")
+        log_error(f"Error processing traces of op {opname} {str(op_uid)}: {e}\n")
     return None
 
 def get_cli_args():
@@ -206,14 +206,19 @@ def get_cli_args():
         default=16,
         help="Number of parallel workers for trace analysis",
     )
+    parser.add_argument(
+        "--workload_cache_dir",
+        type=str,
+        default="",
+        help="Cache merged workloads in this directory; reruns on unchanged traces skip parsing them",
+    )
     return parser.parse_args()
 
 
-def run_npe(opname, op_uid, device_name, workload_file, topology_json_file, compress_timeline_files, output_dir, emit_viz_timeline_files, timeline_split_threshold):
+def run_npe(opname, op_uid, device_name, noc_trace_files, topology_json_file, compress_timeline_files, output_dir, emit_viz_timeline_files, timeline_split_threshold, workload_cache_dir=""):
     # populate Config struct from cli args
     cfg = npe.Config()
     cfg.device_name = device_name
-    cfg.workload_json_filepath = workload_file
     #cfg.congestion_model_name = "fast"
     cfg.cycles_per_timestep = 32
     cfg.workload_is_noc_trace = True
@@ -225,9 +230,10 @@ def run_npe(opname, op_uid, device_name, workload_file, topology_json_file, comp
     cfg.topology_json = topology_json_file
     cfg.timeline_split_threshold_timesteps = timeline_split_threshold
 
-    wl = npe.createWorkloadFromJSON(cfg.workload_json_filepath, cfg.device_name, is_noc_trace_format=True)
+    # merge the per-device traces of the op; ops are already analyzed in parallel, so one thread is used
+    wl = npe.createWorkloadFromNocTraces(noc_trace_files, topology_json_file, cfg.device_name, num_threads=1, cache_dir=workload_cache_dir)
     if wl is None:
-        raise Exception(f"Could not create tt-npe workload from file '{workload_file}'; aborting ... ")
+        raise Exception(f"Could not create tt-npe workload from traces {[os.path.basename(f) for f in noc_trace_files]}; aborting ... ")
 
     npe_api = npe.InitAPI(cfg)
     if npe_api is None:
@@ -373,7 +379,8 @@ def group_traces_ttnn(noc_trace_files):
     return noc_trace_files_per_op
 
 def analyze_noc_traces_in_dir(noc_trace_dir, emit_viz_timeline_files, compress_timeline_files=False, group_as_metal_traces = False,
-        quiet=False, show_accuracy_stats=False, max_rows_in_summary_table=40, timeline_split_threshold=10000, num_workers=16): 
+        quiet=False, show_accuracy_stats=False, max_rows_in_summary_table=40, timeline_split_threshold=10000, num_workers=16,
+        workload_cache_dir=""): 
     # cleanup old tmp files with prefix TT_NPE_TMPFILE_PREFIX
     for f in glob.glob(os.path.join(TMP_DIR,f"{TT_NPE_TMPFILE_PREFIX}*")):
         try:
@@ -410,21 +417,15 @@ def analyze_noc_traces_in_dir(noc_trace_dir, emit_viz_timeline_files, compress_t
     else:
         noc_trace_files_per_op = group_traces_ttnn(noc_trace_files)
 
-    # run fabric post process to merge grouped traces 
+    # grouped traces are merged (and their fabric paths elaborated) by tt-npe as they are analyzed
     topology_file_path = os.path.join(noc_trace_dir, "topology.json")
     topology = TopologyGraph(topology_file_path)
     device_name = topology.cluster_type
     noc_trace_info = []
-    remove_desynchronized_events = True
     for op_uid, op_name_and_trace_files in noc_trace_files_per_op.items():
         op_name, op_trace_files = op_name_and_trace_files
-        output_file_path = os.path.join(noc_trace_dir, f"noc_trace_{str(op_uid)}_merged.json")
-        process_traces(
-            topology, op_trace_files, output_file_path, remove_desynchronized_events, quiet
-        )
-        noc_trace_info.append((output_file_path, op_name, op_uid))
+        noc_trace_info.append((op_trace_files, op_name, op_uid))
 
-    log_info("Trace merging complete, running NPE next.", quiet)
     log_info("Analyzing traces...", quiet)
     stats = Stats()
     timeline_files = []
@@ -432,7 +433,7 @@ def analyze_noc_traces_in_dir(noc_trace_dir, emit_viz_timeline_files, compress_t
     with Pool(processes=num_workers) as pool:
         process_func = partial(process_trace, device_name=device_name, topology_json_file=topology_file_path, 
         compress_timeline_files=compress_timeline_files, output_dir=output_dir, emit_viz_timeline_files=emit_viz_timeline_files,
-        timeline_split_threshold=timeline_split_threshold)
+        timeline_split_threshold=timeline_split_threshold, workload_cache_dir=workload_cache_dir)
         for i, result in enumerate(pool.imap_unordered(process_func, noc_trace_info)):
             update_message(f"Analyzing ({i + 1}/{len(noc_trace_info)}) ...", quiet)
             if result is not None:
@@ -461,7 +462,7 @@ def analyze_noc_traces_in_dir(noc_trace_dir, emit_viz_timeline_files, compress_t
 
 def main():
     args = get_cli_args()
-    analyze_noc_traces_in_dir(args.noc_trace_dir, args.emit_viz_timeline_files, args.compress_timeline_files, args.group_as_metal_traces, args.quiet, args.show_accuracy_stats, args.max_rows_in_summary_table, args.timeline_split_threshold, args.num_workers)
+    analyze_noc_traces_in_dir(args.noc_trace_dir, args.emit_viz_timeline_files, args.compress_timeline_files, args.group_as_metal_traces, args.quiet, args.show_accuracy_stats, args.max_rows_in_summary_table, args.timeline_split_threshold, args.num_workers, args.workload_cache_dir)
 
 
 if __name__ == "__main__":